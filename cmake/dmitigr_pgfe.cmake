@@ -27,8 +27,11 @@ dmitigr_libs_set_library_info(pgfe 2 1 2 "PostgreSQL client API")
 set(dmitigr_pgfe_headers
   array_aliases.hpp
   array_conversions.hpp
+  async.hpp
+  async_scheduler.hpp
   basic_conversions.hpp
   basics.hpp
+  bulk_completion.hpp
   copier.hpp
   completion.hpp
   compositional.hpp
@@ -36,35 +39,49 @@ set(dmitigr_pgfe_headers
   connection.hpp
   connection_options.hpp
   connection_pool.hpp
+  connection_reactor.hpp
   contract.hpp
   conversions_api.hpp
   conversions.hpp
   data.hpp
+  decimal.hpp
   errc.hpp
   errctg.hpp
   error.hpp
   exceptions.hpp
+  flat_array.hpp
   large_object.hpp
   message.hpp
   misc.hpp
+  network_address.hpp
   notice.hpp
   notification.hpp
   parameterizable.hpp
+  poller.hpp
   pq.hpp
   prepared_statement.hpp
   problem.hpp
   ready_for_query.hpp
+  request_handle.hpp
   response.hpp
+  result_set.hpp
   row.hpp
+  row_batch.hpp
   row_info.hpp
+  row_view.hpp
+  sharded_connection_pool.hpp
   signal.hpp
   statement.hpp
   statement_vector.hpp
+  temporal.hpp
   transaction_guard.hpp
   types_fwd.hpp
+  uuid.hpp
   )
 
 set(dmitigr_pgfe_implementations
+  async_scheduler.cpp
+  bulk_completion.cpp
   copier.cpp
   completion.cpp
   composite.cpp
@@ -72,6 +89,7 @@ set(dmitigr_pgfe_implementations
   connection.cpp
   connection_options.cpp
   connection_pool.cpp
+  connection_reactor.cpp
   data.cpp
   errc.cpp
   errctg.cpp
@@ -82,11 +100,17 @@ set(dmitigr_pgfe_implementations
   notice.cpp
   notification.cpp
   parameterizable.cpp
+  poller.cpp
   prepared_statement.cpp
   problem.cpp
   ready_for_query.cpp
+  request_handle.cpp
+  result_set.cpp
   row.cpp
+  row_batch.cpp
   row_info.cpp
+  row_view.cpp
+  sharded_connection_pool.cpp
   statement.cpp
   statement_vector.cpp
   tuple.cpp
@@ -114,6 +138,10 @@ else()
     ${PostgreSQL_LIBRARIES})
 endif()
 
+find_package(Threads REQUIRED)
+list(APPEND dmitigr_pgfe_target_link_libraries_public ${CMAKE_THREAD_LIBS_INIT})
+list(APPEND dmitigr_pgfe_target_link_libraries_interface ${CMAKE_THREAD_LIBS_INIT})
+
 # ------------------------------------------------------------------------------
 # Tests
 # ------------------------------------------------------------------------------
@@ -121,36 +149,61 @@ endif()
 if(DMITIGR_LIBS_TESTS)
   set(dmitigr_pgfe_tests
     array_dimension
+    async
     benchmark_array_client
     benchmark_array_server
+    benchmark_connection_pool_threads
+    benchmark_connection_pool_warmup
+    benchmark_conversions
     benchmark_statement_replace
     composite
     connection
+    connection-auto_prepare
     connection_deferrable
     connection-err_in_mid
     connection_options
+    connection-ps_registry
     connection_pool
+    connection_reactor
     connection-rows
     connection_ssl
     conversions
     conversions_online
     copier
     data
+    decimal
     exceptions
+    execute_many
+    flat_array
     hello_world
     pipeline
     pq_vs_pgfe
     ps
+    ps_allocations
+    request_handle
+    result_set
     lob
+    network_address
     row
+    row_batch
+    sharded_connection_pool
     statement
     statement_vector
+    temporal
     transaction_guard
+    uuid
     )
 
   set(dmitigr_pgfe_tests_target_link_libraries dmitigr_base dmitigr_os dmitigr_str
     dmitigr_util)
 
+  # The async API requires C++20 coroutines.
+  if(MSVC)
+    set(dmitigr_pgfe_test_async_target_compile_options /std:c++20)
+  else()
+    set(dmitigr_pgfe_test_async_target_compile_options -std=c++20)
+  endif()
+
   set(prefix ${dmitigr_libs_SOURCE_DIR}/test/pgfe)
   add_custom_target(dmitigr_pgfe_copy_test_resources ALL
     COMMAND cmake -E copy_if_different
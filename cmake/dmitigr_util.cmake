@@ -29,6 +29,7 @@ set(dmitigr_util_headers
   contract.hpp
   diagnostic.hpp
   memory.hpp
+  ring_queue.hpp
   )
 
 # ------------------------------------------------------------------------------
@@ -36,5 +37,5 @@ set(dmitigr_util_headers
 # ------------------------------------------------------------------------------
 
 if(DMITIGR_LIBS_TESTS)
-  set(dmitigr_util_tests diag)
+  set(dmitigr_util_tests diag ring_queue)
 endif()
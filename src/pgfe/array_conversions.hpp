@@ -18,6 +18,7 @@
 #define DMITIGR_PGFE_ARRAY_CONVERSIONS_HPP
 
 #include "../base/assert.hpp"
+#include "../net/conversions.hpp"
 #include "../str/c_str.hpp"
 #include "../str/predicate.hpp"
 #include "basic_conversions.hpp"
@@ -27,11 +28,29 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+  (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DMITIGR_PGFE_ARRAY_SCANNER_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DMITIGR_PGFE_ARRAY_SCANNER_AVX2
+#include <immintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
 namespace dmitigr::pgfe {
 namespace detail {
 
@@ -48,6 +67,19 @@ std::string to_array_literal(const Container<Optional<T>,
 template<class Container, typename ... Types>
 Container to_container(const char* literal, char delimiter = ',', Types&& ... args);
 
+/// @returns The PostgreSQL array in binary format converted from `container`.
+template<typename T,
+  template<class> class Optional,
+  template<class, class> class Container,
+  template<class> class Allocator,
+  typename ... Types>
+std::unique_ptr<Data> to_binary_array_data(const Container<Optional<T>,
+  Allocator<Optional<T>>>& container, Types&& ... args);
+
+/// @returns The container representation of the PostgreSQL array in binary format.
+template<class Container, typename ... Types>
+Container to_container_from_binary(const Data& data, Types&& ... args);
+
 // =============================================================================
 
 /**
@@ -132,6 +164,28 @@ using Cont_of_vals_t = typename Cont_of_vals<T>::Type;
 
 // -------------------------------------
 
+/// The compile-time traits of a "container of optionals".
+template<typename T>
+struct Array_traits final {
+  /// The number of dimensions.
+  static constexpr int dimension_count{};
+
+  /// The type of elements of the deepest (sub-)container.
+  using Element = T;
+};
+
+/// The partial specialization of Array_traits.
+template<typename T,
+  template<class> class Optional,
+  template<class, class> class Container,
+  template<class> class Allocator>
+struct Array_traits<Container<Optional<T>, Allocator<Optional<T>>>> final {
+  static constexpr int dimension_count{1 + Array_traits<T>::dimension_count};
+  using Element = typename Array_traits<T>::Element;
+};
+
+// -------------------------------------
+
 /**
  * @returns The container of values converted from the container of optionals.
  *
@@ -192,12 +246,15 @@ struct Array_data_conversions_opts<Container<Optional<T>,
                                      Allocator<Optional<T>>>> final {
   using Type = Container<Optional<T>, Allocator<Optional<T>>>;
 
+  /// `true` if the output data can be in Data_format::binary.
+  static constexpr bool is_binary_data_convertible{
+    Binary_type_oid<typename Array_traits<Type>::Element>::value != invalid_oid};
+
   template<typename ... Types>
   static Type to_type(const Data& data, Types&& ... args)
   {
-    if (!(data.format() == Data_format::text))
-      throw Client_exception{"cannot convert array to native type: "
-        "unsupported input data format"};
+    if (data.format() == Data_format::binary)
+      return to_container_from_binary<Type>(data, std::forward<Types>(args)...);
     return to_container<Type>(static_cast<const char*>(data.bytes()), ',',
       std::forward<Types>(args)...);
   }
@@ -218,6 +275,20 @@ struct Array_data_conversions_opts<Container<Optional<T>,
     return Data::make(StringConversions::to_string(value,
       std::forward<Types>(args)...), Data_format::text);
   }
+
+  template<typename ... Types>
+  static std::unique_ptr<Data> to_data(const Type& value,
+    const Data_format format, Types&& ... args)
+  {
+    if (format == Data_format::text)
+      return to_data(value, std::forward<Types>(args)...);
+
+    if constexpr (is_binary_data_convertible)
+      return to_binary_array_data(value, std::forward<Types>(args)...);
+    else
+      throw Client_exception{"cannot convert array to binary data: "
+        "unsupported type of elements"};
+  }
 };
 
 // =============================================================================
@@ -262,6 +333,10 @@ template<typename T,
 struct Array_data_conversions_vals<Container<T, Allocator<T>>> final {
   using Type = Container<T, Allocator<T>>;
 
+  /// `true` if the output data can be in Data_format::binary.
+  static constexpr bool is_binary_data_convertible{
+    Array_data_conversions_opts<Cont_of_opts_t<Type>>::is_binary_data_convertible};
+
   template<typename ... Types>
   static Type to_type(const Data& data, Types&& ... args)
   {
@@ -289,6 +364,15 @@ struct Array_data_conversions_vals<Container<T, Allocator<T>>> final {
       std::forward<Types>(args)...);
   }
 
+  template<typename ... Types>
+  static std::unique_ptr<Data> to_data(Type&& value,
+    const Data_format format, Types&& ... args)
+  {
+    return Array_data_conversions_opts<Cont>::to_data(
+      to_container_of_optionals<std::optional>(std::forward<Type>(value)),
+      format, std::forward<Types>(args)...);
+  }
+
 private:
   using Cont = Cont_of_opts_t<Type>;
 };
@@ -297,6 +381,22 @@ private:
 // Parser and filler
 // -----------------------------------------------------------------------------
 
+/**
+ * @returns The array element converted from its text representation.
+ *
+ * @remarks The arithmetic values are converted without temporary strings.
+ */
+template<typename T, typename ... Types>
+T to_array_element(const std::string_view text, Types&& ... args)
+{
+  if constexpr (std::is_arithmetic_v<T>)
+    return Conversions<T>::to_type(Data_view{text.data(), text.size()},
+      std::forward<Types>(args)...);
+  else
+    return Conversions<T>::to_type(std::string{text},
+      std::forward<Types>(args)...);
+}
+
 /**
  * @brief Fills the container with values extracted from the PostgreSQL array
  * literal.
@@ -340,14 +440,14 @@ public:
   {}
 
   template<typename ... Types>
-  void operator()(std::string&& value, const bool is_null,
+  void operator()(const std::string_view value, const bool is_null,
     const int /*dimension*/, Types&& ... args)
   {
     if constexpr (!is_value_type_container) {
       if (is_null)
         cont_.push_back(Optional_type());
       else
-        cont_.push_back(Conversions<Value_type>::to_type(std::move(value),
+        cont_.push_back(to_array_element<Value_type>(value,
             std::forward<Types>(args)...));
     } else {
       (void)value;   // dummy usage
@@ -368,7 +468,7 @@ namespace arrays {
 /// Used by fill_container().
 template<typename T, typename ... Types>
 const char* fill_container(T& /*result*/, const char* /*literal*/,
-  const char /*delimiter*/, Types&& ... /*args*/)
+  const char* /*end*/, const char /*delimiter*/, Types&& ... /*args*/)
 {
   throw Client_exception{Client_errc::insufficient_dimensionality};
 }
@@ -391,33 +491,25 @@ const char* quote_for_array_element(const Container<Optional<T>,
   return "";
 }
 
-/// Used by to_array_literal().
-template<typename T, typename ... Types>
-std::string to_array_literal(const T& element,
-  const char /*delimiter*/, Types&& ... args)
+/// @returns The `element` with the quotes and backslashes escaped.
+inline std::string escape_array_element(std::string element)
 {
-  return Conversions<T>::to_string(element, std::forward<Types>(args)...);
+  auto i = element.find_first_of("\"\\");
+  while (i != std::string::npos) {
+    element.insert(i, 1, '\\');
+    i = element.find_first_of("\"\\", i + 2);
+  }
+  return element;
 }
 
 /// Used by to_array_literal().
-template<class CharT, class Traits, class Allocator, typename ... Types>
-std::string to_array_literal(
-  const std::basic_string<CharT, Traits, Allocator>& element,
+template<typename T, typename ... Types>
+std::string to_array_literal(const T& element,
   const char /*delimiter*/, Types&& ... args)
 {
-  using String = std::basic_string<CharT, Traits, Allocator>;
-
-  std::string result{Conversions<String>::to_string(element,
-    std::forward<Types>(args)...)};
-
-  // Escaping quotes.
-  typename String::size_type i = result.find("\"");
-  while (i != String::npos) {
-    result.replace(i, 1, "\\\"");
-    i = result.find("\"", i + 2);
-  }
-
-  return result;
+  // The text representations of records and strings may contain quotes.
+  return escape_array_element(Conversions<T>::to_string(element,
+    std::forward<Types>(args)...));
 }
 
 /// Used by to_container_of_values().
@@ -468,6 +560,119 @@ Optional<T> to_container_of_optionals(T&& element)
 
 // -------------------------------------
 
+/**
+ * @brief The scanner of the structural characters of array literals.
+ *
+ * @details The literal is scanned by blocks of 32 (AVX2) or 16 (SSE2) bytes
+ * on x86 if the instruction set is supported by the CPU (the implementation is
+ * selected at runtime upon the first call), or byte by byte otherwise.
+ */
+class Array_literal_scanner final {
+public:
+  /**
+   * @returns The pointer to the first character of range `[first, last)`
+   * which is equal to any of `c1`, `c2`, `c3` or `c4`, or `last` if there is
+   * no such a character.
+   */
+  static const char* find(const char* const first, const char* const last,
+    const char c1, const char c2, const char c3, const char c4) noexcept
+  {
+    static const Find impl{select__()};
+    return impl(first, last, c1, c2, c3, c4);
+  }
+
+  /// @overload
+  static const char* find(const char* const first, const char* const last,
+    const char c1, const char c2) noexcept
+  {
+    return find(first, last, c1, c2, c1, c2);
+  }
+
+private:
+  using Find = const char*(*)(const char*, const char*,
+    char, char, char, char) noexcept;
+
+  static Find select__() noexcept
+  {
+#ifdef DMITIGR_PGFE_ARRAY_SCANNER_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+      return &find_avx2__;
+#endif
+#ifdef DMITIGR_PGFE_ARRAY_SCANNER_SSE2
+    return &find_sse2__;
+#else
+    return &find_scalar__;
+#endif
+  }
+
+  static const char* find_scalar__(const char* first, const char* const last,
+    const char c1, const char c2, const char c3, const char c4) noexcept
+  {
+    for (; first != last; ++first) {
+      const char c = *first;
+      if (c == c1 || c == c2 || c == c3 || c == c4)
+        break;
+    }
+    return first;
+  }
+
+#ifdef DMITIGR_PGFE_ARRAY_SCANNER_SSE2
+  static unsigned count_trailing_zeros__(const unsigned mask) noexcept
+  {
+    DMITIGR_ASSERT(mask);
+#ifdef _MSC_VER
+    unsigned long result;
+    _BitScanForward(&result, mask);
+    return static_cast<unsigned>(result);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+  }
+
+  static const char* find_sse2__(const char* first, const char* const last,
+    const char c1, const char c2, const char c3, const char c4) noexcept
+  {
+    const __m128i v1{_mm_set1_epi8(c1)}, v2{_mm_set1_epi8(c2)};
+    const __m128i v3{_mm_set1_epi8(c3)}, v4{_mm_set1_epi8(c4)};
+    for (; last - first >= 16; first += 16) {
+      const __m128i block{_mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(first))};
+      const __m128i matches{_mm_or_si128(
+          _mm_or_si128(_mm_cmpeq_epi8(block, v1), _mm_cmpeq_epi8(block, v2)),
+          _mm_or_si128(_mm_cmpeq_epi8(block, v3), _mm_cmpeq_epi8(block, v4)))};
+      if (const auto mask = static_cast<unsigned>(_mm_movemask_epi8(matches)))
+        return first + count_trailing_zeros__(mask);
+    }
+    return find_scalar__(first, last, c1, c2, c3, c4);
+  }
+#endif
+
+#ifdef DMITIGR_PGFE_ARRAY_SCANNER_AVX2
+  __attribute__((target("avx2")))
+  static const char* find_avx2__(const char* first, const char* const last,
+    const char c1, const char c2, const char c3, const char c4) noexcept
+  {
+    const __m256i v1{_mm256_set1_epi8(c1)}, v2{_mm256_set1_epi8(c2)};
+    const __m256i v3{_mm256_set1_epi8(c3)}, v4{_mm256_set1_epi8(c4)};
+    for (; last - first >= 32; first += 32) {
+      const __m256i block{_mm256_loadu_si256(
+          reinterpret_cast<const __m256i*>(first))};
+      const __m256i matches{_mm256_or_si256(
+          _mm256_or_si256(_mm256_cmpeq_epi8(block, v1),
+            _mm256_cmpeq_epi8(block, v2)),
+          _mm256_or_si256(_mm256_cmpeq_epi8(block, v3),
+            _mm256_cmpeq_epi8(block, v4)))};
+      if (const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(matches)))
+        return first + count_trailing_zeros__(mask);
+    }
+    return find_sse2__(first, last, c1, c2, c3, c4);
+  }
+#endif
+};
+
+// -------------------------------------
+
 /**
  * @brief PostgreSQL array parsing routine.
  *
@@ -477,23 +682,30 @@ Optional<T> to_container_of_optionals(T&& element)
  *   reached dimension of the literal;
  *   -# calls `handler(element, is_element_null, dimension, args)` each time
  *   when the element is extracted. Here:
- *     - element (std::string&&) -- is a text representation of the array
- *       element;
+ *     - element (std::string_view) -- is a text representation of the array
+ *       element. It points either to the `literal` (if the element doesn't
+ *       contains escape characters) or to the internal buffer of the parser
+ *       and thus is valid only until the handler returns;
  *     - is_element_null (bool) is a flag that equals to true if the extracted
  *       element is SQL NULL;
  *     - dimension -- is a zero-based index of type `int` of the element dimension;
  *     - args -- extra arguments for passing to the conversion routine.
  *
+ * @param end The pointer to the terminating zero of `literal`.
+ *
  * @returns The pointer that points to a next character after the last closing
  * curly bracket found in the `literal`.
  *
  * @throws Client_exception.
+ *
+ * @par Requires
+ * `literal && end && !*end`.
  */
 template<class F, typename ... Types>
-const char* parse_array_literal(const char* literal, const char delimiter,
-  F& handler, Types&& ... args)
+const char* parse_array_literal(const char* literal, const char* const end,
+  const char delimiter, F& handler, Types&& ... args)
 {
-  DMITIGR_ASSERT(literal);
+  DMITIGR_ASSERT(literal && end && !*end);
 
   /*
    * Syntax of the array literals:
@@ -509,121 +721,87 @@ const char* parse_array_literal(const char* literal, const char delimiter,
    *   {{{1,2}},{{3,4}}}
    */
 
-  enum { in_beginning, in_dimension,
-         in_quoted_element, in_unquoted_element } state = in_beginning;
-
-  int  dimension{};
-  char previous_char{};
-  char previous_nonspace_char{};
-  std::string element;
-  while (const char c = *literal) {
-    switch (state) {
-    case in_beginning: {
-      if (c == '{') {
-        handler(dimension);
-        dimension = 1;
-        state = in_dimension;
-      } else if (str::is_space(c)) {
-        // Skip space.
-      } else
-        throw Client_exception{Client_errc::malformed_literal};
-
-      goto preparing_to_the_next_iteration;
-    }
-
-    case in_dimension: {
-      DMITIGR_ASSERT(dimension > 0);
+  using str::next_non_space_pointer;
+  using Scanner = Array_literal_scanner;
 
-      if (str::is_space(c)) {
-        // Skip space.
-      } else if (c == delimiter) {
-        if (previous_nonspace_char == delimiter || previous_nonspace_char == '{')
-          throw Client_exception{Client_errc::malformed_literal};
-      } else if (c == '{') {
-        handler(dimension);
-        ++dimension;
-      } else if (c == '}') {
-        if (previous_nonspace_char == delimiter)
-          throw Client_exception{Client_errc::malformed_literal};
+  literal = next_non_space_pointer(literal);
+  if (*literal != '{')
+    throw Client_exception{Client_errc::malformed_literal};
+  handler(0);
+  ++literal;
+
+  enum { after_opening, after_element, after_delimiter } token = after_opening;
+  int dimension{1};
+  std::string buffer; // for the elements with escape characters
+  while (const char c = *(literal = next_non_space_pointer(literal))) {
+    if (c == delimiter) {
+      if (token != after_element)
+        throw Client_exception{Client_errc::malformed_literal};
+      token = after_delimiter;
+      ++literal;
+    } else if (c == '{') {
+      if (token == after_element)
+        throw Client_exception{Client_errc::malformed_literal};
+      handler(dimension);
+      ++dimension;
+      token = after_opening;
+      ++literal;
+    } else if (c == '}') {
+      if (token == after_delimiter)
+        throw Client_exception{Client_errc::malformed_literal};
+      // Any character may follow after the last closing curly bracket.
+      ++literal;
+      if (!--dimension)
+        return literal;
+      token = after_element;
+    } else {
+      if (token == after_element)
+        throw Client_exception{Client_errc::malformed_literal};
 
-        --dimension;
-        if (dimension == 0) {
-          // Any character may follow after the closing curly bracket. It's ok.
-          ++literal; // consuming the closing curly bracket
-          return literal;
+      std::string_view element;
+      bool is_element_null{};
+      if (c == '"') {
+        const char* const first = literal + 1;
+        const char* last = Scanner::find(first, end, '"', '\\');
+        if (last != end && *last == '"') {
+          // Fast path: no escape characters, no copying.
+          element = std::string_view(first, last - first);
+        } else {
+          buffer.assign(first, last);
+          while (last != end && *last == '\\') {
+            if (++last == end)
+              break;
+            buffer += *last; // escaped character
+            const char* const next = last + 1;
+            last = Scanner::find(next, end, '"', '\\');
+            buffer.append(next, last);
+          }
+          if (last == end)
+            throw Client_exception{Client_errc::malformed_literal};
+          element = buffer;
         }
-      } else if (c == '"') {
-        state = in_quoted_element;
+        literal = last + 1; // consuming the closing quote
       } else {
-        state = in_unquoted_element;
-        continue;
+        const char* const last = Scanner::find(literal, end,
+          delimiter, '{', '}', delimiter);
+        const char* trimmed = last;
+        while (str::is_space(*(trimmed - 1)))
+          --trimmed;
+        element = std::string_view(literal, trimmed - literal);
+        is_element_null = element.size() == 4 &&
+          (element[0] == 'n' || element[0] == 'N') &&
+          (element[1] == 'u' || element[1] == 'U') &&
+          (element[2] == 'l' || element[2] == 'L') &&
+          (element[3] == 'l' || element[3] == 'L');
+        literal = last;
       }
-
-      goto preparing_to_the_next_iteration;
-    }
-
-    case in_quoted_element: {
-      if (c == '\\' && previous_char != '\\') {
-        // Skip escape character '\\'.
-      } else if (c == '"' && previous_char != '\\')
-        goto element_extracted;
-      else
-        element += c;
-
-      goto preparing_to_the_next_iteration;
-    }
-
-    case in_unquoted_element: {
-      if (c == delimiter || c == '{' || c == '}')
-        goto element_extracted;
-      else
-        element += c;
-
-      goto preparing_to_the_next_iteration;
-    }
-    } // switch (state)
-
-  element_extracted:
-    {
-      if (element.empty())
-        throw Client_exception{Client_errc::malformed_literal};
-
-      const bool is_element_null =
-        ((state == in_unquoted_element && element.size() == 4)
-          &&
-          ((element[0] == 'n' || element[0] == 'N') &&
-            (element[1] == 'u' || element[1] == 'U') &&
-            (element[2] == 'l' || element[2] == 'L') &&
-            (element[3] == 'l' || element[3] == 'L')));
-
-      handler(std::move(element), is_element_null, dimension,
+      handler(element, is_element_null, dimension,
         std::forward<Types>(args)...);
+      token = after_element;
+    }
+  }
 
-      element = std::string{}; // The element was moved and must be recreated!
-
-      if (state == in_unquoted_element) {
-        /*
-         * Just after extracting unquoted element, the (*literal) is a
-         * character that must be processed next. Thus, continue immediately.
-         */
-        state = in_dimension;
-        continue;
-      } else {
-        state = in_dimension;
-      }
-    } // extracted element processing
-
-  preparing_to_the_next_iteration:
-    if (str::is_non_space(c))
-      previous_nonspace_char = c;
-    previous_char = c;
-    ++literal;
-  } // while
-
-  if (dimension != 0)
-    throw Client_exception{Client_errc::malformed_literal};
-
-  return literal;
+  throw Client_exception{Client_errc::malformed_literal};
 }
 
 /**
@@ -641,7 +819,8 @@ template<typename T,
   template<class> class Allocator,
   typename ... Types>
 const char* fill_container(Container<Optional<T>, Allocator<Optional<T>>>& result,
-  const char* literal, const char delimiter, Types&& ... args)
+  const char* literal, const char* const end, const char delimiter,
+  Types&& ... args)
 {
   DMITIGR_ASSERT(result.empty());
   DMITIGR_ASSERT(literal);
@@ -675,7 +854,7 @@ const char* fill_container(Container<Optional<T>, Allocator<Optional<T>>>& resul
        * insufficient.
        */
       using namespace arrays;
-      subliteral = fill_container(subcontainer, subliteral, delimiter,
+      subliteral = fill_container(subcontainer, subliteral, end, delimiter,
         std::forward<Types>(args)...);
 
       // For better understanding, imagine the source literal as "{{{1,2}},{{3,4}}}".
@@ -697,7 +876,7 @@ const char* fill_container(Container<Optional<T>, Allocator<Optional<T>>>& resul
     }
   } else {
     Filler_of_deepest_container<T, Optional, Container, Allocator> handler(result);
-    return parse_array_literal(literal, delimiter, handler,
+    return parse_array_literal(literal, end, delimiter, handler,
       std::forward<Types>(args)...);
   }
 }
@@ -748,7 +927,8 @@ Container to_container(const char* const literal, const char delimiter,
 {
   DMITIGR_ASSERT(literal);
   Container result;
-  fill_container(result, literal, delimiter, std::forward<Types>(args)...);
+  fill_container(result, literal, literal + std::strlen(literal), delimiter,
+    std::forward<Types>(args)...);
   return result;
 }
 
@@ -799,6 +979,289 @@ auto to_container_of_optionals(Container<T, Allocator<T>>&& container)
   return result;
 }
 
+// -----------------------------------------------------------------------------
+// Binary format
+// -----------------------------------------------------------------------------
+
+/// The maximum number of dimensions of PostgreSQL arrays.
+inline constexpr int max_array_dimension_count{6};
+
+/// The header of PostgreSQL array in binary format.
+struct Binary_array_header final {
+  int dimension_count{};
+  bool has_nulls{};
+  Oid element_type_oid{invalid_oid};
+  int dimensions[max_array_dimension_count]{};
+  int lower_bounds[max_array_dimension_count]{};
+};
+
+/**
+ * @returns The 32-bit integer read from `bytes` in network byte order.
+ *
+ * @par Effects
+ * `bytes` points to the next byte after the integer read.
+ */
+inline std::int32_t read_binary_int32(const char*& bytes, const char* const end)
+{
+  if (end - bytes < 4)
+    throw Client_exception{Client_errc::malformed_literal};
+  const auto result = net::conv<std::int32_t>(bytes, 4);
+  bytes += 4;
+  return result;
+}
+
+/// Appends the 32-bit integer `value` to the `result` in network byte order.
+inline void write_binary_int32(std::string& result, const std::int32_t value)
+{
+  char buffer[sizeof(value)];
+  net::copy(buffer, sizeof(buffer), value);
+  result.append(buffer, sizeof(buffer));
+}
+
+/**
+ * @returns The header of PostgreSQL array in binary format read from `bytes`.
+ *
+ * @par Effects
+ * `bytes` points to the first element of the array.
+ */
+inline Binary_array_header read_binary_array_header(const char*& bytes,
+  const char* const end)
+{
+  Binary_array_header result;
+  result.dimension_count = read_binary_int32(bytes, end);
+  if (!(0 <= result.dimension_count &&
+      result.dimension_count <= max_array_dimension_count))
+    throw Client_exception{Client_errc::malformed_literal};
+  result.has_nulls = read_binary_int32(bytes, end);
+  result.element_type_oid = static_cast<Oid>(read_binary_int32(bytes, end));
+  for (int i{}; i < result.dimension_count; ++i) {
+    result.dimensions[i] = read_binary_int32(bytes, end);
+    result.lower_bounds[i] = read_binary_int32(bytes, end);
+    if (result.dimensions[i] < 0)
+      throw Client_exception{Client_errc::malformed_literal};
+  }
+  return result;
+}
+
+/**
+ * @returns `true` if the elements of PostgreSQL array in binary format of the
+ * element type `oid` are convertible to `T`, i.e. if `T` has no known binary
+ * type, or if `oid` is either of that type or of a type with the same binary
+ * representation.
+ */
+template<typename T>
+constexpr bool is_binary_array_element_type(const Oid oid) noexcept
+{
+  constexpr Oid expected{Binary_type_oid<T>::value};
+  if (expected == invalid_oid || oid == expected)
+    return true;
+  else if (expected == 25) // text
+    return oid == 1043 || oid == 1042 || oid == 19; // varchar, bpchar, name
+  else if (expected == 869) // inet
+    return oid == 650; // cidr
+  return false;
+}
+
+/**
+ * @throws Client_exception if `!is_binary_array_element_type<T>(oid)`.
+ */
+template<typename T>
+inline void check_binary_array_element_type(const Oid oid)
+{
+  if (!is_binary_array_element_type<T>(oid))
+    throw Client_exception{Client_errc::improper_value_type,
+      "cannot convert PostgreSQL array in binary format: element type OID " +
+      std::to_string(oid) + " doesn't match the type of destination"};
+}
+
+/**
+ * @brief Fills the container with the elements of PostgreSQL array in binary
+ * format of the specified `dimension`.
+ *
+ * @par Effects
+ * `bytes` points to the next byte after the last element read.
+ *
+ * @throws Client_exception.
+ */
+template<typename T,
+  template<class> class Optional,
+  template<class, class> class Container,
+  template<class> class Allocator,
+  typename ... Types>
+void fill_container_from_binary(Container<Optional<T>,
+  Allocator<Optional<T>>>& result, const Binary_array_header& header,
+  const int dimension, const char*& bytes, const char* const end,
+  Types&& ... args)
+{
+  DMITIGR_ASSERT(result.empty());
+  DMITIGR_ASSERT(dimension < header.dimension_count);
+
+  constexpr bool is_value_type_container{Array_traits<T>::dimension_count > 0};
+  const int size = header.dimensions[dimension];
+  if (dimension + 1 < header.dimension_count) {
+    if constexpr (is_value_type_container) {
+      for (int i{}; i < size; ++i) {
+        result.push_back(T());
+        fill_container_from_binary(*result.back(), header, dimension + 1,
+          bytes, end, args...);
+      }
+    } else
+      throw Client_exception{Client_errc::insufficient_dimensionality};
+  } else if constexpr (is_value_type_container) {
+    throw Client_exception{Client_errc::excessive_dimensionality};
+  } else {
+    check_binary_array_element_type<T>(header.element_type_oid);
+    for (int i{}; i < size; ++i) {
+      const auto length = read_binary_int32(bytes, end);
+      if (length < 0)
+        result.push_back(Optional<T>());
+      else if (end - bytes < length)
+        throw Client_exception{Client_errc::malformed_literal};
+      else {
+        result.push_back(Conversions<T>::to_type(Data_view{bytes,
+          static_cast<std::size_t>(length), Data_format::binary}, args...));
+        bytes += length;
+      }
+    }
+  }
+}
+
+template<class Container, typename ... Types>
+Container to_container_from_binary(const Data& data, Types&& ... args)
+{
+  DMITIGR_ASSERT(data.format() == Data_format::binary);
+  const char* bytes = static_cast<const char*>(data.bytes());
+  const char* const end = bytes + data.size();
+  const auto header = read_binary_array_header(bytes, end);
+  Container result;
+  if (header.dimension_count > 0)
+    fill_container_from_binary(result, header, 0, bytes, end, args...);
+  if (bytes != end)
+    throw Client_exception{Client_errc::malformed_literal};
+  return result;
+}
+
+/**
+ * @brief Sets the dimensions of the `header` to the sizes of the first
+ * subcontainers of the `container`.
+ */
+template<typename T,
+  template<class> class Optional,
+  template<class, class> class Container,
+  template<class> class Allocator>
+void set_binary_array_dimensions(Binary_array_header& header,
+  const int dimension,
+  const Container<Optional<T>, Allocator<Optional<T>>>& container)
+{
+  DMITIGR_ASSERT(dimension < header.dimension_count);
+  if (container.size() > static_cast<std::size_t>(
+      std::numeric_limits<std::int32_t>::max()))
+    throw Client_exception{"cannot convert array to binary data: "
+      "too many elements"};
+  header.dimensions[dimension] = static_cast<int>(container.size());
+  header.lower_bounds[dimension] = 1;
+  if constexpr (Array_traits<T>::dimension_count > 0) {
+    if (!container.empty()) {
+      if (const auto& first = *cbegin(container))
+        set_binary_array_dimensions(header, dimension + 1, *first);
+      else
+        throw Client_exception{"cannot convert array to binary data: "
+          "NULL subarray"};
+    }
+  }
+}
+
+/**
+ * @brief Appends the elements of the `container` of the specified `dimension`
+ * to the `result`.
+ */
+template<typename T,
+  template<class> class Optional,
+  template<class, class> class Container,
+  template<class> class Allocator,
+  typename ... Types>
+void write_binary_array_elements(std::string& result,
+  Binary_array_header& header, const int dimension,
+  const Container<Optional<T>, Allocator<Optional<T>>>& container,
+  Types&& ... args)
+{
+  if (static_cast<int>(container.size()) != header.dimensions[dimension])
+    throw Client_exception{"cannot convert array to binary data: "
+      "subarrays have different sizes"};
+
+  for (const auto& element : container) {
+    if constexpr (Array_traits<T>::dimension_count > 0) {
+      if (!element)
+        throw Client_exception{"cannot convert array to binary data: "
+          "NULL subarray"};
+      write_binary_array_elements(result, header, dimension + 1, *element,
+        args...);
+    } else if (!element) {
+      header.has_nulls = true;
+      write_binary_int32(result, -1);
+    } else {
+      const auto append = [&result](const void* const bytes,
+        const std::size_t size)
+      {
+        if (size > static_cast<std::size_t>(
+            std::numeric_limits<std::int32_t>::max()))
+          throw Client_exception{"cannot convert array to binary data: "
+            "too large element"};
+        write_binary_int32(result, static_cast<std::int32_t>(size));
+        result.append(static_cast<const char*>(bytes), size);
+      };
+      if constexpr (std::is_same_v<T, std::string>)
+        append(element->data(), element->size());
+      else {
+        const auto data = Conversions<T>::to_data(*element, Data_format::binary,
+          args...);
+        append(data->bytes(), data->size());
+      }
+    }
+  }
+}
+
+template<typename T,
+  template<class> class Optional,
+  template<class, class> class Container,
+  template<class> class Allocator,
+  typename ... Types>
+std::unique_ptr<Data> to_binary_array_data(const Container<Optional<T>,
+  Allocator<Optional<T>>>& container, Types&& ... args)
+{
+  using Traits = Array_traits<Container<Optional<T>, Allocator<Optional<T>>>>;
+  constexpr Oid element_type_oid{
+    Binary_type_oid<typename Traits::Element>::value};
+  static_assert(element_type_oid != invalid_oid,
+    "attempt to convert array of unsupported elements to binary data");
+  static_assert(Traits::dimension_count <= max_array_dimension_count,
+    "attempt to convert array of too many dimensions to binary data");
+
+  Binary_array_header header;
+  header.dimension_count = Traits::dimension_count;
+  header.element_type_oid = element_type_oid;
+  set_binary_array_dimensions(header, 0, container);
+  const bool is_empty = std::any_of(header.dimensions,
+    header.dimensions + header.dimension_count,
+    [](const int size){return !size;});
+
+  // The header is written with the flags which are updated afterwards.
+  std::string result;
+  write_binary_int32(result, is_empty ? 0 : header.dimension_count);
+  write_binary_int32(result, 0);
+  write_binary_int32(result, static_cast<std::int32_t>(element_type_oid));
+  if (!is_empty) {
+    for (int i{}; i < header.dimension_count; ++i) {
+      write_binary_int32(result, header.dimensions[i]);
+      write_binary_int32(result, header.lower_bounds[i]);
+    }
+    write_binary_array_elements(result, header, 0, container, args...);
+    if (header.has_nulls)
+      result[7] = 1; // the last byte of the flags in network byte order
+  }
+  return Data::make(std::move(result), Data_format::binary);
+}
+
 } // namespace detail
 
 /**
@@ -808,8 +1271,10 @@ auto to_container_of_optionals(Container<T, Allocator<T>>&& container)
  * containers with optional values).
  *
  * @details The support of the following data formats is implemented for:
- *   - input data - Data_format::text;
- *   - output data - Data_format::text.
+ *   - input data - Data_format::text, Data_format::binary;
+ *   - output data - Data_format::text, Data_format::binary (if there is
+ *   the PostgreSQL type of the binary representation of `T`, see
+ *   Conversions).
  *
  * @par Requirements
  * @parblock
@@ -840,7 +1305,12 @@ struct Conversions<Container<Optional<T>, Allocator<Optional<T>>>> final
       detail::Array_string_conversions_opts<Container<Optional<T>,
                                               Allocator<Optional<T>>>>,
       detail::Array_data_conversions_opts<Container<Optional<T>,
-                                            Allocator<Optional<T>>>>> {};
+                                            Allocator<Optional<T>>>>> {
+  /// `true` if the output data can be in Data_format::binary.
+  static constexpr bool is_binary_data_convertible{
+    detail::Array_data_conversions_opts<Container<Optional<T>,
+      Allocator<Optional<T>>>>::is_binary_data_convertible};
+};
 
 /**
  * @ingroup conversions
@@ -848,8 +1318,10 @@ struct Conversions<Container<Optional<T>, Allocator<Optional<T>>>> final
  * @brief The partial specialization of Conversions for non-nullable arrays.
  *
  * @details The support of the following data formats is implemented for:
- *   - input data  - Data_format::text;
- *   - output data - Data_format::text.
+ *   - input data  - Data_format::text, Data_format::binary;
+ *   - output data - Data_format::text, Data_format::binary (if there is
+ *   the PostgreSQL type of the binary representation of `T`, see
+ *   Conversions).
  *
  * @par Requirements
  * @parblock
@@ -871,7 +1343,12 @@ template<typename T,
 struct Conversions<Container<T, Allocator<T>>>
   : Basic_conversions<Container<T, Allocator<T>>,
       detail::Array_string_conversions_vals<Container<T, Allocator<T>>>,
-      detail::Array_data_conversions_vals<Container<T, Allocator<T>>>> {};
+      detail::Array_data_conversions_vals<Container<T, Allocator<T>>>> {
+  /// `true` if the output data can be in Data_format::binary.
+  static constexpr bool is_binary_data_convertible{
+    detail::Array_data_conversions_vals<Container<T,
+      Allocator<T>>>::is_binary_data_convertible};
+};
 
 /**
  * @brief The partial specialization of Conversions for non-nullable arrays.
@@ -898,7 +1375,14 @@ struct Conversions<Container<Subcontainer<T, SubcontainerAllocator<T>>,
           ContainerAllocator<Subcontainer<T, SubcontainerAllocator<T>>>>>,
       detail::Array_data_conversions_vals<
         Container<Subcontainer<T, SubcontainerAllocator<T>>,
-          ContainerAllocator<Subcontainer<T, SubcontainerAllocator<T>>>>>> {};
+          ContainerAllocator<Subcontainer<T, SubcontainerAllocator<T>>>>>> {
+  /// `true` if the output data can be in Data_format::binary.
+  static constexpr bool is_binary_data_convertible{
+    detail::Array_data_conversions_vals<
+      Container<Subcontainer<T, SubcontainerAllocator<T>>,
+        ContainerAllocator<Subcontainer<T, SubcontainerAllocator<T>>>>>
+          ::is_binary_data_convertible};
+};
 
 } // namespace dmitigr::pgfe
 
@@ -0,0 +1,916 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DMITIGR_PGFE_ASYNC_HPP
+#define DMITIGR_PGFE_ASYNC_HPP
+
+// The API of this header is available only if C++20 coroutines are.
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include "../base/assert.hpp"
+#include "async_scheduler.hpp"
+#include "completion.hpp"
+#include "connection.hpp"
+#include "copier.hpp"
+#include "data.hpp"
+#include "exceptions.hpp"
+#include "prepared_statement.hpp"
+#include "row.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace dmitigr::pgfe {
+
+template<typename T = void> class Task;
+
+namespace detail {
+
+/// The base of the promise of Task.
+class Task_promise_base {
+public:
+  std::suspend_always initial_suspend() const noexcept
+  {
+    return {};
+  }
+
+  struct Final_awaiter final {
+    bool await_ready() const noexcept
+    {
+      return false;
+    }
+
+    template<class P>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<P> handle) noexcept
+    {
+      const auto continuation = handle.promise().continuation_;
+      return continuation ? continuation : std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept
+    {}
+  };
+
+  Final_awaiter final_suspend() const noexcept
+  {
+    return {};
+  }
+
+  void unhandled_exception() noexcept
+  {
+    exception_ = std::current_exception();
+  }
+
+  void rethrow_if_exception() const
+  {
+    if (exception_)
+      std::rethrow_exception(exception_);
+  }
+
+  std::coroutine_handle<> continuation_;
+  std::exception_ptr exception_;
+  bool is_started_{};
+};
+
+/// The promise of Task.
+template<typename T>
+class Task_promise final : public Task_promise_base {
+public:
+  Task<T> get_return_object() noexcept;
+
+  template<typename U>
+  void return_value(U&& value)
+  {
+    value_.emplace(std::forward<U>(value));
+  }
+
+  T result()
+  {
+    rethrow_if_exception();
+    return std::move(*value_);
+  }
+
+private:
+  std::optional<T> value_;
+};
+
+/// The promise of Task.
+template<>
+class Task_promise<void> final : public Task_promise_base {
+public:
+  Task<void> get_return_object() noexcept;
+
+  void return_void() const noexcept
+  {}
+
+  void result() const
+  {
+    rethrow_if_exception();
+  }
+};
+
+} // namespace detail
+
+/**
+ * @ingroup utilities
+ *
+ * @brief A lazily started asynchronous operation.
+ *
+ * @details The operation is started either upon `co_await` or by start().
+ * Upon completion the awaiting coroutine (if any) is resumed.
+ *
+ * @remarks The instance must outlive the operation.
+ */
+template<typename T>
+class Task final {
+public:
+  /// The promise type.
+  using promise_type = detail::Task_promise<T>;
+
+  /// The destructor.
+  ~Task()
+  {
+    if (handle_)
+      handle_.destroy();
+  }
+
+  /// Default-constructible. (Constructs invalid instance.)
+  Task() = default;
+
+  /// Not copy-constructible.
+  Task(const Task&) = delete;
+
+  /// Not copy-assignable.
+  Task& operator=(const Task&) = delete;
+
+  /// Move-constructible.
+  Task(Task&& rhs) noexcept
+    : handle_{std::exchange(rhs.handle_, {})}
+  {}
+
+  /// Move-assignable.
+  Task& operator=(Task&& rhs) noexcept
+  {
+    if (this != &rhs) {
+      Task tmp{std::move(rhs)};
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  /// Swaps this instance with `rhs`.
+  void swap(Task& rhs) noexcept
+  {
+    using std::swap;
+    swap(handle_, rhs.handle_);
+  }
+
+  /// @returns `true` if this instance is valid.
+  bool is_valid() const noexcept
+  {
+    return static_cast<bool>(handle_);
+  }
+
+  /// @returns `is_valid()`.
+  explicit operator bool() const noexcept
+  {
+    return is_valid();
+  }
+
+  /**
+   * @returns `true` if the operation is completed.
+   *
+   * @par Requires
+   * `is_valid()`.
+   */
+  bool is_done() const
+  {
+    if (!is_valid())
+      throw Client_exception{"cannot check if invalid task is done"};
+    return handle_.done();
+  }
+
+  /**
+   * @brief Starts the operation without awaiting it.
+   *
+   * @details The operation runs until the first suspension. It's intended for
+   * the top-level tasks driven by a scheduler.
+   *
+   * @par Requires
+   * `is_valid()` and the operation is not started yet.
+   */
+  void start()
+  {
+    if (!is_valid())
+      throw Client_exception{"cannot start invalid task"};
+    else if (handle_.promise().is_started_)
+      throw Client_exception{"cannot start task: already started"};
+    handle_.promise().is_started_ = true;
+    handle_.resume();
+  }
+
+  /**
+   * @returns The result of the operation.
+   *
+   * @par Requires
+   * `is_done()`.
+   *
+   * @throws The exception thrown by the operation.
+   */
+  T result()
+  {
+    if (!is_done())
+      throw Client_exception{"cannot get result of undone task"};
+    return handle_.promise().result();
+  }
+
+  /// @returns The awaiter of the operation.
+  auto operator co_await() noexcept
+  {
+    struct Awaiter final {
+      bool await_ready() const noexcept
+      {
+        return handle_.done();
+      }
+
+      std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept
+      {
+        auto& promise = handle_.promise();
+        promise.continuation_ = continuation;
+        if (promise.is_started_)
+          return std::noop_coroutine();
+        promise.is_started_ = true;
+        return handle_;
+      }
+
+      T await_resume()
+      {
+        return handle_.promise().result();
+      }
+
+      std::coroutine_handle<promise_type> handle_;
+    };
+    DMITIGR_ASSERT(is_valid());
+    return Awaiter{handle_};
+  }
+
+private:
+  friend promise_type;
+
+  std::coroutine_handle<promise_type> handle_;
+
+  explicit Task(const std::coroutine_handle<promise_type> handle) noexcept
+    : handle_{handle}
+  {}
+};
+
+template<typename T>
+Task<T> detail::Task_promise<T>::get_return_object() noexcept
+{
+  return Task<T>{std::coroutine_handle<Task_promise>::from_promise(*this)};
+}
+
+inline Task<void> detail::Task_promise<void>::get_return_object() noexcept
+{
+  return Task<void>{std::coroutine_handle<Task_promise>::from_promise(*this)};
+}
+
+/**
+ * @ingroup utilities
+ *
+ * @brief An asynchronous generator of values.
+ *
+ * @details The body of the generator can both `co_yield` values and
+ * `co_await` other asynchronous operations.
+ *
+ * @remarks The instance must outlive the iteration.
+ */
+template<typename T>
+class Async_generator final {
+public:
+  /// The promise type.
+  class promise_type final {
+  public:
+    Async_generator get_return_object() noexcept
+    {
+      return Async_generator{std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+
+    std::suspend_always initial_suspend() const noexcept
+    {
+      return {};
+    }
+
+    auto final_suspend() const noexcept
+    {
+      return Transfer{};
+    }
+
+    template<typename U>
+    auto yield_value(U&& value)
+    {
+      value_.emplace(std::forward<U>(value));
+      return Transfer{};
+    }
+
+    void return_void() const noexcept
+    {}
+
+    void unhandled_exception() noexcept
+    {
+      exception_ = std::current_exception();
+    }
+
+  private:
+    friend Async_generator;
+
+    struct Transfer final {
+      bool await_ready() const noexcept
+      {
+        return false;
+      }
+
+      std::coroutine_handle<>
+      await_suspend(const std::coroutine_handle<promise_type> handle) noexcept
+      {
+        return handle.promise().consumer_;
+      }
+
+      void await_resume() const noexcept
+      {}
+    };
+
+    std::coroutine_handle<> consumer_;
+    std::exception_ptr exception_;
+    std::optional<T> value_;
+  };
+
+  /// The destructor.
+  ~Async_generator()
+  {
+    if (handle_)
+      handle_.destroy();
+  }
+
+  /// Default-constructible. (Constructs invalid instance.)
+  Async_generator() = default;
+
+  /// Not copy-constructible.
+  Async_generator(const Async_generator&) = delete;
+
+  /// Not copy-assignable.
+  Async_generator& operator=(const Async_generator&) = delete;
+
+  /// Move-constructible.
+  Async_generator(Async_generator&& rhs) noexcept
+    : handle_{std::exchange(rhs.handle_, {})}
+  {}
+
+  /// Move-assignable.
+  Async_generator& operator=(Async_generator&& rhs) noexcept
+  {
+    if (this != &rhs) {
+      Async_generator tmp{std::move(rhs)};
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  /// Swaps this instance with `rhs`.
+  void swap(Async_generator& rhs) noexcept
+  {
+    using std::swap;
+    swap(handle_, rhs.handle_);
+  }
+
+  /// @returns `true` if this instance is valid.
+  bool is_valid() const noexcept
+  {
+    return static_cast<bool>(handle_);
+  }
+
+  /// @returns `is_valid()`.
+  explicit operator bool() const noexcept
+  {
+    return is_valid();
+  }
+
+  /**
+   * @returns The awaiter of the next value, which is resumed with either
+   * the next value or `std::nullopt` if the generator is exhausted.
+   *
+   * @par Requires
+   * `is_valid()`.
+   *
+   * @throws The exception thrown by the body of the generator.
+   */
+  auto next()
+  {
+    struct Awaiter final {
+      bool await_ready() const noexcept
+      {
+        return handle_.done();
+      }
+
+      std::coroutine_handle<> await_suspend(std::coroutine_handle<> consumer) noexcept
+      {
+        handle_.promise().consumer_ = consumer;
+        handle_.promise().value_.reset();
+        return handle_;
+      }
+
+      std::optional<T> await_resume()
+      {
+        auto& promise = handle_.promise();
+        if (promise.exception_)
+          std::rethrow_exception(std::exchange(promise.exception_, {}));
+        std::optional<T> result{std::move(promise.value_)};
+        promise.value_.reset();
+        return result;
+      }
+
+      std::coroutine_handle<promise_type> handle_;
+    };
+    if (!is_valid())
+      throw Client_exception{"cannot get next value of invalid generator"};
+    return Awaiter{handle_};
+  }
+
+private:
+  std::coroutine_handle<promise_type> handle_;
+
+  explicit Async_generator(const std::coroutine_handle<promise_type> handle) noexcept
+    : handle_{handle}
+  {}
+};
+
+/**
+ * @ingroup utilities
+ *
+ * @brief An asynchronous interface to the connection.
+ *
+ * @details Every asynchronous operation suspends the awaiting coroutine upon
+ * the unreadiness of the connection socket, so many connections can be driven
+ * by the single thread of the scheduler. For example:
+ *   @code{cpp}
+ *   Task<> run(Async_connection& conn)
+ *   {
+ *     co_await conn.async_connect();
+ *     co_await conn.async_execute("insert into t values($1)", 1);
+ *     auto rows = conn.async_rows("select * from t");
+ *     while (auto row = co_await rows.next())
+ *       std::cout << to<int>((*row)[0]) << std::endl;
+ *   }
+ *   @endcode
+ *
+ * @remarks The nonblocking output mode is enabled on the connected connection.
+ *
+ * @remarks The statements, parameters and callbacks are consumed upon the call
+ * of the asynchronous operation, not upon its awaiting.
+ *
+ * @see Async_scheduler.
+ */
+class Async_connection final {
+public:
+  /**
+   * @brief The constructor.
+   *
+   * @par Effects
+   * `connection.is_nio_output_enabled()` if `connection.is_connected()`.
+   */
+  Async_connection(Connection& connection, Async_scheduler& scheduler)
+    : connection_{&connection}
+    , scheduler_{&scheduler}
+  {
+    if (connection.is_connected())
+      connection.set_nio_output_enabled(true);
+  }
+
+  /// @returns The underlying connection.
+  Connection& connection() noexcept
+  {
+    return *connection_;
+  }
+
+  /// @returns The underlying scheduler.
+  Async_scheduler& scheduler() noexcept
+  {
+    return *scheduler_;
+  }
+
+  /**
+   * @returns The awaiter of the readiness of the connection socket, which is
+   * resumed with either the readiness of the socket or Socket_readiness::unready
+   * if the `timeout` expired.
+   *
+   * @see Connection::wait_socket_readiness().
+   */
+  auto async_wait_socket_readiness(const Socket_readiness mask,
+    const std::optional<std::chrono::milliseconds> timeout = std::nullopt)
+  {
+    class Awaiter final : public Async_scheduler::Waiter {
+    public:
+      Awaiter(Async_connection& conn, const Socket_readiness mask,
+        const std::optional<std::chrono::milliseconds> timeout) noexcept
+        : conn_{conn}
+        , mask_{mask}
+        , timeout_{timeout}
+      {}
+
+      bool await_ready() const noexcept
+      {
+        return false;
+      }
+
+      void await_suspend(const std::coroutine_handle<> handle)
+      {
+        handle_ = handle;
+        conn_.scheduler().wait(conn_.connection(), mask_, timeout_, *this);
+      }
+
+      Socket_readiness await_resume() const noexcept
+      {
+        return readiness_;
+      }
+
+      void resume(const Socket_readiness readiness) override
+      {
+        readiness_ = readiness;
+        handle_.resume();
+      }
+
+    private:
+      Async_connection& conn_;
+      Socket_readiness mask_{};
+      std::optional<std::chrono::milliseconds> timeout_;
+      std::coroutine_handle<> handle_;
+      Socket_readiness readiness_{};
+    };
+    return Awaiter{*this, mask, timeout};
+  }
+
+  /**
+   * @brief Asynchronously connects to a PostgreSQL server.
+   *
+   * @see Connection::connect().
+   */
+  Task<> async_connect(std::optional<std::chrono::milliseconds> timeout =
+    std::chrono::milliseconds{-1})
+  {
+    using std::chrono::milliseconds;
+    using Status = Connection_status;
+
+    auto& conn = connection();
+    if (!(!timeout || timeout >= milliseconds{-1}))
+      throw Client_exception{"cannot initiate connection: invalid timeout "
+        "specified"};
+    else if (conn.is_connected())
+      co_return;
+
+    if (timeout == milliseconds{-1})
+      timeout = conn.options().connect_timeout();
+    const auto deadline = to_deadline(timeout);
+
+    conn.connect_nio();
+    while (true) {
+      Socket_readiness mask{};
+      switch (conn.status()) {
+      case Status::connected:
+        conn.set_nio_output_enabled(true);
+        co_return;
+      case Status::establishment_reading:
+        mask = Socket_readiness::read_ready;
+        break;
+      case Status::establishment_writing:
+        mask = Socket_readiness::write_ready;
+        break;
+      case Status::disconnected:
+        DMITIGR_ASSERT(false);
+      case Status::failure:
+        throw Client_exception{conn.error_message()};
+      }
+
+      if (co_await async_wait_socket_readiness(mask, to_timeout(deadline)) ==
+        Socket_readiness::unready)
+        throw Client_exception{Client_errc::timed_out, "connection timeout"};
+      conn.connect_nio();
+    }
+  }
+
+  /**
+   * @brief Asynchronously flushes the output queued to the server.
+   *
+   * @see Connection::flush_output().
+   */
+  Task<> async_flush_output()
+  {
+    auto& conn = connection();
+    while (!conn.flush_output(false)) {
+      const auto readiness = co_await async_wait_socket_readiness(
+        Socket_readiness::read_ready | Socket_readiness::write_ready);
+      if (bool(readiness & Socket_readiness::read_ready))
+        conn.read_input();
+    }
+  }
+
+  /**
+   * @brief Asynchronously waits the next Response overwriting the current one.
+   *
+   * @see Connection::wait_response().
+   */
+  Task<bool> async_wait_response(std::optional<std::chrono::milliseconds> timeout =
+    std::chrono::milliseconds{-1})
+  {
+    using std::chrono::milliseconds;
+    using Sr = Socket_readiness;
+
+    auto& conn = connection();
+    if (!(conn.is_connected() && conn.has_uncompleted_request()))
+      co_return false;
+    else if (!(!timeout || timeout >= milliseconds{-1}))
+      throw Client_exception{"cannot wait response: invalid timeout specified"};
+
+    if (timeout < milliseconds::zero()) // even if timeout < -1
+      timeout = conn.options().wait_response_timeout();
+    const auto deadline = to_deadline(timeout);
+
+    static const auto throw_timeout = []
+    {
+      throw Client_exception{Client_errc::timed_out,
+        "wait response timeout expired"};
+    };
+
+    while (true) {
+      if (!conn.flush_output(false)) {
+        const auto readiness = co_await async_wait_socket_readiness(
+          Sr::read_ready | Sr::write_ready, to_timeout(deadline));
+        if (readiness == Sr::unready)
+          throw_timeout();
+        else if (bool(readiness & Sr::read_ready))
+          conn.read_input();
+        continue;
+      }
+
+      if (const auto s = conn.handle_input(false); s != Response_status::unready)
+        co_return s == Response_status::ready;
+
+      if (co_await async_wait_socket_readiness(Sr::read_ready,
+          to_timeout(deadline)) == Sr::unready)
+        throw_timeout();
+      conn.read_input();
+    }
+  }
+
+  /**
+   * @brief Similar to async_wait_response(), but throws Server_exception if
+   * `error()` after awaiting.
+   *
+   * @see Connection::wait_response_throw().
+   */
+  Task<bool> async_wait_response_throw(std::optional<std::chrono::milliseconds>
+    timeout = std::chrono::milliseconds{-1})
+  {
+    const bool result = co_await async_wait_response(timeout);
+    connection().throw_if_error();
+    co_return result;
+  }
+
+  /**
+   * @brief Asynchronously executes the `statement`.
+   *
+   * @param callback Same as for Connection::process_responses(), except the
+   * callbacks with the parameter of type `Error&&` are not supported.
+   *
+   * @details If the callback throws an exception, the rest responses are
+   * dismissed and the exception is rethrown.
+   *
+   * @see Connection::execute().
+   */
+  template<typename F, typename ... Types>
+  std::enable_if_t<detail::Response_callback_traits<F>::is_valid &&
+    !detail::Response_callback_traits<F>::has_error_parameter, Task<Completion>>
+  async_execute(F&& callback, const Statement& statement, Types&& ... parameters)
+  {
+    auto& conn = connection();
+    if (!conn.is_ready_for_request())
+      throw Client_exception{"cannot execute statement: not ready for request"};
+    conn.execute_nio(statement, std::forward<Types>(parameters)...);
+    return async_process_responses__(std::forward<F>(callback));
+  }
+
+  /// @overload
+  template<typename ... Types>
+  Task<Completion> async_execute(const Statement& statement,
+    Types&& ... parameters)
+  {
+    return async_execute(Connection::ignore_row, statement,
+      std::forward<Types>(parameters)...);
+  }
+
+  /**
+   * @brief Asynchronously executes the `statement` and generates its rows.
+   *
+   * @details Upon exhaustion of the generator the Completion is available by
+   * `connection().completion()`.
+   *
+   * @throws Server_exception from Async_generator::next() on error.
+   *
+   * @see Connection::execute_nio().
+   */
+  template<typename ... Types>
+  Async_generator<Row> async_rows(const Statement& statement,
+    Types&& ... parameters)
+  {
+    auto& conn = connection();
+    if (!conn.is_ready_for_request())
+      throw Client_exception{"cannot execute statement: not ready for request"};
+    conn.execute_nio(statement, std::forward<Types>(parameters)...);
+    return async_rows__();
+  }
+
+  /**
+   * @brief Asynchronously prepares the `statement`.
+   *
+   * @remarks Unlike Connection::prepare(), the limits of prepared statements
+   * are not enforced. (See Connection::reclaim_prepared_statements().)
+   *
+   * @see Connection::prepare().
+   */
+  Task<Prepared_statement> async_prepare(const Statement& statement,
+    const std::string& name = {})
+  {
+    auto& conn = connection();
+    if (!conn.is_ready_for_request())
+      throw Client_exception{"cannot prepare statement: not ready for request"};
+    conn.prepare_nio(statement, name);
+    return async_prepared_statement__();
+  }
+
+  /**
+   * @brief Asynchronously sends the `data` to the server.
+   *
+   * @remarks The `data` must outlive the operation.
+   *
+   * @see Copier::send().
+   */
+  Task<> async_send(const Copier& copier, const std::string_view data)
+  {
+    while (!copier.send(data))
+      co_await async_flush_output();
+  }
+
+  /**
+   * @brief Asynchronously sends end-of-data indication to the server.
+   *
+   * @see Copier::end().
+   */
+  Task<> async_end(const Copier& copier, const std::string error_message = {})
+  {
+    while (!copier.end(error_message))
+      co_await async_flush_output();
+    co_await async_flush_output();
+  }
+
+  /**
+   * @brief Asynchronously receives data from the server.
+   *
+   * @returns Either invalid instance if the `COPY` command is done, or the
+   * data received from the server.
+   *
+   * @param timeout The value of `-1` means `options().wait_response_timeout()`;
+   * the value of `std::nullopt` means *eternity*.
+   *
+   * @see Copier::receive().
+   */
+  Task<Data_view> async_receive(const Copier& copier,
+    std::optional<std::chrono::milliseconds> timeout =
+    std::chrono::milliseconds{-1})
+  {
+    using std::chrono::milliseconds;
+
+    if (!(!timeout || timeout >= milliseconds{-1}))
+      throw Client_exception{"cannot receive data: invalid timeout specified"};
+    else if (timeout < milliseconds::zero())
+      timeout = connection().options().wait_response_timeout();
+    const auto deadline = to_deadline(timeout);
+
+    while (true) {
+      auto result = copier.receive(false);
+      if (!result || result.size())
+        co_return result;
+
+      if (co_await async_wait_socket_readiness(Socket_readiness::read_ready,
+          to_timeout(deadline)) == Socket_readiness::unready)
+        throw Client_exception{Client_errc::timed_out,
+          "receive data timeout expired"};
+      connection().read_input();
+    }
+  }
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  Connection* connection_{};
+  Async_scheduler* scheduler_{};
+
+  static std::optional<Clock::time_point>
+  to_deadline(const std::optional<std::chrono::milliseconds> timeout)
+  {
+    return timeout ? std::make_optional(Clock::now() + *timeout) : std::nullopt;
+  }
+
+  static std::optional<std::chrono::milliseconds>
+  to_timeout(const std::optional<Clock::time_point> deadline)
+  {
+    using std::chrono::ceil;
+    using std::chrono::milliseconds;
+    return deadline ? std::make_optional(std::max(milliseconds::zero(),
+      ceil<milliseconds>(*deadline - Clock::now()))) : std::nullopt;
+  }
+
+  template<typename F>
+  Task<Completion> async_process_responses__(F callback)
+  {
+    using Traits = detail::Response_callback_traits<F>;
+    using Argument = typename Traits::Argument;
+
+    auto& conn = connection();
+    std::exception_ptr exception;
+    Row_processing rowpro{Row_processing::continu};
+    while (true) {
+      /*
+       * The result of waiting is ignored since the rows of the whole result
+       * are available even after the request is dismissed by its response.
+       */
+      co_await async_wait_response_throw();
+      if (auto r = conn.template rows__<Argument>()) {
+        if (exception || rowpro != Row_processing::continu)
+          continue;
+
+        try {
+          if constexpr (!Traits::is_result_void)
+            rowpro = callback(std::move(r));
+          else
+            callback(std::move(r));
+        } catch (...) {
+          exception = std::current_exception();
+          continue;
+        }
+        if (rowpro == Row_processing::suspend)
+          co_return Completion{};
+      } else
+        break;
+    }
+    if (exception)
+      std::rethrow_exception(exception);
+    co_return Connection::completion_or_throw(conn.completion());
+  }
+
+  Async_generator<Row> async_rows__()
+  {
+    auto& conn = connection();
+    while (true) {
+      co_await async_wait_response_throw(); // see async_process_responses__()
+      if (auto row = conn.row())
+        co_yield std::move(row);
+      else
+        break;
+    }
+  }
+
+  Task<Prepared_statement> async_prepared_statement__()
+  {
+    auto& conn = connection();
+    co_await async_wait_response_throw();
+    if (auto comp = conn.completion()) {
+      DMITIGR_ASSERT(comp.tag() == "invalid");
+      throw Client_exception{Client_errc::invalid_response};
+    }
+    co_return conn.prepared_statement();
+  }
+};
+
+} // namespace dmitigr::pgfe
+
+#endif  // defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#endif  // DMITIGR_PGFE_ASYNC_HPP
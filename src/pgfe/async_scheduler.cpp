@@ -0,0 +1,160 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../base/assert.hpp"
+#include "async_scheduler.hpp"
+#include "connection.hpp"
+#include "exceptions.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace dmitigr::pgfe {
+
+// -----------------------------------------------------------------------------
+// Async_scheduler
+// -----------------------------------------------------------------------------
+
+DMITIGR_PGFE_INLINE int
+Async_scheduler::socket(const Connection& connection) noexcept
+{
+  return connection.socket();
+}
+
+// -----------------------------------------------------------------------------
+// Default_async_scheduler
+// -----------------------------------------------------------------------------
+
+DMITIGR_PGFE_INLINE
+Default_async_scheduler::~Default_async_scheduler() noexcept = default;
+
+DMITIGR_PGFE_INLINE Default_async_scheduler::Default_async_scheduler()
+  : poller_{true}
+{
+  assert(is_invariant_ok());
+}
+
+DMITIGR_PGFE_INLINE void
+Default_async_scheduler::wait(const Connection& connection,
+  const Socket_readiness mask,
+  const std::optional<std::chrono::milliseconds> timeout, Waiter& waiter)
+{
+  const int sock{socket(connection)};
+  if (sock < 0)
+    throw Client_exception{"cannot schedule wait: invalid connection status"};
+  else if (!(!timeout || timeout->count() >= 0))
+    throw Client_exception{"cannot schedule wait: invalid timeout specified"};
+  else if (entries_.find(sock) != entries_.end())
+    throw Client_exception{"cannot schedule wait: socket is already waited"};
+
+  auto& entry = entries_[sock]; // can throw
+  entry.waiter_ = &waiter;
+  entry.timer_ = timers_.end();
+  try {
+    if (timeout)
+      entry.timer_ = timers_.emplace(Clock::now() + *timeout, sock); // can throw
+    poller_.watch(sock, mask); // can throw
+  } catch (...) {
+    if (entry.timer_ != timers_.end())
+      timers_.erase(entry.timer_);
+    entries_.erase(sock);
+    throw;
+  }
+
+  assert(is_invariant_ok());
+}
+
+DMITIGR_PGFE_INLINE std::size_t
+Default_async_scheduler::waiter_count() const noexcept
+{
+  return entries_.size();
+}
+
+DMITIGR_PGFE_INLINE std::size_t
+Default_async_scheduler::run_once(const std::optional<std::chrono::milliseconds> timeout)
+{
+  using std::chrono::ceil;
+  using std::chrono::milliseconds;
+
+  if (!(!timeout || timeout >= milliseconds::zero()))
+    throw Client_exception{"cannot run async scheduler: "
+      "invalid timeout specified"};
+
+  static const auto to_int = [](const milliseconds value) noexcept
+  {
+    using Lim = std::numeric_limits<int>;
+    return static_cast<int>(std::clamp<milliseconds::rep>(value.count(),
+      0, Lim::max()));
+  };
+
+  int wait_timeout{timeout ? to_int(*timeout) : -1};
+  if (!timers_.empty()) {
+    const int left{to_int(ceil<milliseconds>(timers_.begin()->first -
+      Clock::now()))};
+    wait_timeout = wait_timeout < 0 ? left : std::min(wait_timeout, left);
+  }
+  if (entries_.empty() && wait_timeout < 0)
+    return 0;
+
+  std::size_t result{};
+  for (const auto& event : poller_.wait(wait_timeout)) {
+    if (entries_.find(event.socket_) != entries_.end()) {
+      resume__(event.socket_, event.readiness_);
+      ++result;
+    }
+  }
+
+  const auto now = Clock::now();
+  while (!timers_.empty() && timers_.begin()->first <= now) {
+    const int sock{timers_.begin()->second};
+    resume__(sock, Socket_readiness::unready);
+    ++result;
+  }
+
+  assert(is_invariant_ok());
+  return result;
+}
+
+DMITIGR_PGFE_INLINE std::size_t Default_async_scheduler::run()
+{
+  std::size_t result{};
+  while (!entries_.empty())
+    result += run_once();
+  return result;
+}
+
+DMITIGR_PGFE_INLINE bool Default_async_scheduler::is_invariant_ok() const noexcept
+{
+  const bool timers_ok = timers_.size() <= entries_.size();
+  return timers_ok;
+}
+
+DMITIGR_PGFE_INLINE void
+Default_async_scheduler::resume__(const int socket,
+  const Socket_readiness readiness)
+{
+  const auto i = entries_.find(socket);
+  DMITIGR_ASSERT(i != entries_.end());
+  auto* const waiter = i->second.waiter_;
+  if (i->second.timer_ != timers_.end())
+    timers_.erase(i->second.timer_);
+  entries_.erase(i);
+  if (readiness == Socket_readiness::unready)
+    poller_.unwatch(socket); // timed out while armed
+  waiter->resume(readiness); // can schedule the next wait of the socket
+}
+
+} // namespace dmitigr::pgfe
@@ -0,0 +1,189 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DMITIGR_PGFE_ASYNC_SCHEDULER_HPP
+#define DMITIGR_PGFE_ASYNC_SCHEDULER_HPP
+
+#include "basics.hpp"
+#include "dll.hpp"
+#include "poller.hpp"
+#include "types_fwd.hpp"
+
+#include <chrono>
+#include <map>
+#include <optional>
+#include <unordered_map>
+
+namespace dmitigr::pgfe {
+
+/**
+ * @ingroup utilities
+ *
+ * @brief A scheduler of the asynchronous operations.
+ *
+ * @details The scheduler suspends the asynchronous operations (see async.hpp)
+ * until the readiness of the connection sockets and resumes them afterwards.
+ * It's an extension point to integrate the asynchronous operations into an
+ * arbitrary event loop.
+ *
+ * @see Default_async_scheduler.
+ */
+class Async_scheduler {
+public:
+  /// A waiter of the socket readiness.
+  class Waiter {
+  public:
+    /// The destructor.
+    virtual ~Waiter() = default;
+
+    /**
+     * @brief Resumes the waiter.
+     *
+     * @param readiness The readiness of the socket, or Socket_readiness::unready
+     * if the timeout expired.
+     *
+     * @remarks Spurious resumptions are allowed, so the waiter must check the
+     * state of the connection upon resumption.
+     */
+    virtual void resume(Socket_readiness readiness) = 0;
+  };
+
+  /// The destructor.
+  virtual ~Async_scheduler() = default;
+
+  /**
+   * @brief Schedules the resumption of the `waiter` upon the readiness of the
+   * socket of the `connection`.
+   *
+   * @details The `waiter` must be resumed exactly once, either upon the
+   * socket readiness matching the `mask`, or upon the `timeout` expiration.
+   *
+   * @param timeout The value of `std::nullopt` means *eternity*.
+   *
+   * @par Requires
+   * `connection.status()` is neither `Connection_status::failure` nor
+   * `Connection_status::disconnected`, `(!timeout || timeout->count() >= 0)`.
+   */
+  virtual void wait(const Connection& connection, Socket_readiness mask,
+    std::optional<std::chrono::milliseconds> timeout, Waiter& waiter) = 0;
+
+protected:
+  /// @returns The socket of the `connection`.
+  DMITIGR_PGFE_API static int socket(const Connection& connection) noexcept;
+};
+
+/**
+ * @ingroup utilities
+ *
+ * @brief The default single-threaded scheduler of the asynchronous operations.
+ *
+ * @details The waited sockets are watched in the single set (which is
+ * implemented by epoll(7) on Linux and by poll() elsewhere). Each socket is
+ * registered in the set once, and only rearmed upon the subsequent waits. All
+ * the deadlines are kept in the single timer structure.
+ *
+ * @remarks Only one waiter per socket is allowed at a time.
+ *
+ * @remarks Functions of this class are not thread-safe.
+ */
+class Default_async_scheduler final : public Async_scheduler {
+public:
+  /// The destructor.
+  DMITIGR_PGFE_API ~Default_async_scheduler() noexcept override;
+
+  /**
+   * @brief The constructor.
+   *
+   * @throws Client_exception if the underlying event notification facility
+   * cannot be initialized.
+   */
+  DMITIGR_PGFE_API Default_async_scheduler();
+
+  /// Non copy-constructible.
+  Default_async_scheduler(const Default_async_scheduler&) = delete;
+
+  /// Non copy-assignable.
+  Default_async_scheduler& operator=(const Default_async_scheduler&) = delete;
+
+  /// Non move-constructible.
+  Default_async_scheduler(Default_async_scheduler&&) = delete;
+
+  /// Non move-assignable.
+  Default_async_scheduler& operator=(Default_async_scheduler&&) = delete;
+
+  /**
+   * @see Async_scheduler::wait().
+   *
+   * @par Requires
+   * There is no waiter of the socket of the `connection`.
+   */
+  DMITIGR_PGFE_API void wait(const Connection& connection,
+    Socket_readiness mask, std::optional<std::chrono::milliseconds> timeout,
+    Waiter& waiter) override;
+
+  /// @returns The number of waiters.
+  DMITIGR_PGFE_API std::size_t waiter_count() const noexcept;
+
+  /**
+   * @brief Waits for the socket readiness and resumes the waiters.
+   *
+   * @param timeout The maximum time to wait for the events. The value of
+   * `std::nullopt` means *until the nearest deadline*, or *eternity* if
+   * there are no deadlines.
+   *
+   * @returns The number of resumed waiters.
+   *
+   * @par Requires
+   * `!timeout || timeout->count() >= 0`.
+   *
+   * @par Exception safety guarantee
+   * Basic. The exceptions thrown by the waiters are propagated.
+   */
+  DMITIGR_PGFE_API std::size_t
+  run_once(std::optional<std::chrono::milliseconds> timeout = std::nullopt);
+
+  /**
+   * @brief Calls run_once() until `!waiter_count()`.
+   *
+   * @returns The total number of resumed waiters.
+   */
+  DMITIGR_PGFE_API std::size_t run();
+
+private:
+  using Clock = std::chrono::steady_clock;
+  using Timers = std::multimap<Clock::time_point, int>;
+
+  struct Entry final {
+    Waiter* waiter_{};
+    Timers::iterator timer_;
+  };
+
+  detail::Poller poller_;
+  std::unordered_map<int, Entry> entries_;
+  Timers timers_;
+
+  bool is_invariant_ok() const noexcept;
+
+  void resume__(int socket, Socket_readiness readiness);
+};
+
+} // namespace dmitigr::pgfe
+
+#ifndef DMITIGR_PGFE_NOT_HEADER_ONLY
+#include "async_scheduler.cpp"
+#endif
+
+#endif  // DMITIGR_PGFE_ASYNC_SCHEDULER_HPP
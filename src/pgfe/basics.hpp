@@ -600,6 +600,59 @@ enum class Row_processing {
   complete = 200
 };
 
+// =============================================================================
+
+/**
+ * @ingroup main
+ *
+ * @brief A result retrieval mode.
+ */
+enum class Result_retrieval {
+  /// The rows are retrieved one by one (or by batches) as they arrive.
+  streaming = 0,
+
+  /// The result is retrieved as a whole.
+  whole = 100,
+
+  /**
+   * Either `whole` if the previous execution of a named prepared statement
+   * produced not more rows than a threshold, or `streaming` otherwise.
+   */
+  adaptive = 200
+};
+
+// =============================================================================
+
+/**
+ * @ingroup main
+ *
+ * @brief A session state which can be mutated (dirtied) by the commands.
+ *
+ * @see Connection::session_state().
+ */
+enum class Session_state {
+  /// The session state is not mutated.
+  clean = 0,
+
+  /// The transaction is in progress.
+  transaction = 2,
+
+  /// The run-time parameters are set (by `SET` or `RESET`).
+  settings = 4,
+
+  /// The (possibly temporary) tables, views or sequences are created.
+  temporary_objects = 8,
+
+  /// The notification channels are listened.
+  listening = 16,
+
+  /// The named prepared statements are prepared.
+  prepared_statements = 32,
+
+  /// The cursors are declared.
+  cursors = 64
+};
+
 } // namespace dmitigr::pgfe
 
 namespace dmitigr {
@@ -608,6 +661,8 @@ template<>
 struct Is_bitmask_enum<pgfe::Socket_readiness> final : std::true_type {};
 template<>
 struct Is_bitmask_enum<pgfe::External_library> final : std::true_type {};
+template<>
+struct Is_bitmask_enum<pgfe::Session_state> final : std::true_type {};
 
 namespace pgfe {
 
@@ -618,6 +673,7 @@ namespace pgfe {
 
 DMITIGR_DEFINE_ENUM_BITMASK_OPERATORS(Socket_readiness)
 DMITIGR_DEFINE_ENUM_BITMASK_OPERATORS(External_library)
+DMITIGR_DEFINE_ENUM_BITMASK_OPERATORS(Session_state)
 
 /// @}
 } // namespace pgfe
@@ -0,0 +1,101 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DMITIGR_PGFE_BULK_COMPLETION_HPP
+#define DMITIGR_PGFE_BULK_COMPLETION_HPP
+
+#include "dll.hpp"
+#include "error.hpp"
+#include "types_fwd.hpp"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace dmitigr::pgfe {
+
+/**
+ * @ingroup main
+ *
+ * @brief An aggregated completion of the execution of a prepared statement
+ * over a range of parameter tuples.
+ *
+ * @see Prepared_statement::execute_many().
+ */
+class Bulk_completion final {
+public:
+  /// An error with the index of the element of range which caused it.
+  using Indexed_error = std::pair<std::size_t, Error>;
+
+  /// Default-constructible.
+  Bulk_completion() = default;
+
+  /// Swaps this instance with `rhs`.
+  DMITIGR_PGFE_API void swap(Bulk_completion& rhs) noexcept;
+
+  /// @returns The number of elements of range the responses were received on.
+  DMITIGR_PGFE_API std::size_t element_count() const noexcept;
+
+  /// @returns The number of elements executed successfully.
+  DMITIGR_PGFE_API std::size_t completion_count() const noexcept;
+
+  /**
+   * @returns The total number of rows affected by the successful executions.
+   *
+   * @see Completion::row_count().
+   */
+  DMITIGR_PGFE_API long row_count() const noexcept;
+
+  /// @returns The errors caused by the elements of range.
+  DMITIGR_PGFE_API const std::vector<Indexed_error>& errors() const noexcept;
+
+  /**
+   * @returns The indexes of elements of range which were not executed because
+   * of the error caused by a preceding element of the same synchronization
+   * window.
+   */
+  DMITIGR_PGFE_API const std::vector<std::size_t>& aborted() const noexcept;
+
+  /// @returns `errors().empty() && aborted().empty()`.
+  DMITIGR_PGFE_API bool is_ok() const noexcept;
+
+private:
+  friend Prepared_statement;
+
+  std::size_t element_count_{};
+  std::size_t completion_count_{};
+  long row_count_{};
+  std::vector<Indexed_error> errors_;
+  std::vector<std::size_t> aborted_;
+};
+
+/**
+ * @ingroup main
+ *
+ * @brief Bulk_completion is swappable.
+ */
+inline void swap(Bulk_completion& lhs, Bulk_completion& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace dmitigr::pgfe
+
+#ifndef DMITIGR_PGFE_NOT_HEADER_ONLY
+#include "bulk_completion.cpp"
+#endif
+
+#endif  // DMITIGR_PGFE_BULK_COMPLETION_HPP
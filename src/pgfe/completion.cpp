@@ -15,11 +15,12 @@
 // limitations under the License.
 
 #include "../base/assert.hpp"
-#include "../os/error.hpp"
 #include "completion.hpp"
+#include "exceptions.hpp"
 
+#include <algorithm>
 #include <cassert>
-#include <cstdlib>
+#include <charconv>
 #include <system_error>
 
 namespace dmitigr::pgfe {
@@ -31,12 +32,14 @@ DMITIGR_PGFE_INLINE Completion::Completion() noexcept
 
 DMITIGR_PGFE_INLINE Completion::Completion(Completion&& rhs) noexcept
   : row_count_{rhs.row_count_}
-  , tag_{std::move(rhs.tag_)}
+  , tag_{rhs.tag_}
+  , tag_size_{rhs.tag_size_}
 {
   rhs.row_count_ = -2;
+  rhs.tag_size_ = 0;
 }
 
-DMITIGR_PGFE_INLINE Completion::Completion(const std::string_view tag)
+DMITIGR_PGFE_INLINE Completion::Completion(std::string_view tag)
   : row_count_{-1} // mark instance as valid
 {
   DMITIGR_ASSERT(tag.data());
@@ -52,15 +55,15 @@ DMITIGR_PGFE_INLINE Completion::Completion(const std::string_view tag)
        * one (i.e. affected row count) must be ignored.
        */
       const auto word_size = end_word_pos - space_before_word_pos;
-      const std::string word{tag.substr(space_before_word_pos + 1, word_size)};
+      const auto word = tag.substr(space_before_word_pos + 1, word_size);
 
-      errno = 0;
-      char* p{};
-      const long number = std::strtol(word.c_str(), &p, 10);
-      if (const int err = errno)
+      long number{};
+      const auto [p, ec] = std::from_chars(word.data(),
+        word.data() + word.size(), number);
+      if (ec == std::errc::result_out_of_range)
         throw Client_exception{"cannot parse command completion tag:"
-          " " + os::error_message(err)};
-      if (p == word.c_str())
+          " " + std::make_error_code(ec).message()};
+      else if (p == word.data())
         // The word is not a number.
         break;
       else if (row_count_ < 0)
@@ -69,9 +72,12 @@ DMITIGR_PGFE_INLINE Completion::Completion(const std::string_view tag)
       end_word_pos = space_before_word_pos - 1;
       space_before_word_pos = tag.find_last_of(space, end_word_pos);
     }
-    tag_ = tag.substr(0, end_word_pos + 1);
-  } else
-    tag_ = tag;
+    tag = tag.substr(0, end_word_pos + 1);
+  }
+
+  DMITIGR_ASSERT(tag.size() <= tag_.size());
+  tag_size_ = std::min(tag.size(), tag_.size());
+  std::copy_n(tag.data(), tag_size_, tag_.data());
 
   DMITIGR_ASSERT(is_valid());
   assert(is_invariant_ok());
@@ -91,6 +97,7 @@ DMITIGR_PGFE_INLINE void Completion::swap(Completion& rhs) noexcept
   using std::swap;
   swap(row_count_, rhs.row_count_);
   swap(tag_, rhs.tag_);
+  swap(tag_size_, rhs.tag_size_);
 }
 
 DMITIGR_PGFE_INLINE bool Completion::is_valid() const noexcept
@@ -98,9 +105,9 @@ DMITIGR_PGFE_INLINE bool Completion::is_valid() const noexcept
   return row_count_ > -2;
 }
 
-DMITIGR_PGFE_INLINE const std::string& Completion::tag() const noexcept
+DMITIGR_PGFE_INLINE std::string_view Completion::tag() const noexcept
 {
-  return tag_;
+  return {tag_.data(), tag_size_};
 }
 
 DMITIGR_PGFE_INLINE std::optional<long> Completion::row_count() const noexcept
@@ -110,7 +117,7 @@ DMITIGR_PGFE_INLINE std::optional<long> Completion::row_count() const noexcept
 
 DMITIGR_PGFE_INLINE bool Completion::is_invariant_ok() const noexcept
 {
-  return (row_count_ < 0) || !tag_.empty();
+  return (row_count_ < 0) || tag_size_;
 }
 
 } // namespace dmitigr::pgfe
@@ -20,8 +20,9 @@
 #include "dll.hpp"
 #include "response.hpp"
 
+#include <array>
 #include <optional>
-#include <string>
+#include <string_view>
 
 namespace dmitigr::pgfe {
 
@@ -64,7 +65,7 @@ public:
    * example, the operation tag for `END` command is "COMMIT", the operation
    * tag for `CREATE TABLE AS` command is "SELECT" etc.
    */
-  DMITIGR_PGFE_API const std::string& tag() const noexcept;
+  DMITIGR_PGFE_API std::string_view tag() const noexcept;
 
   /**
    * @returns The number of rows affected by a completed SQL command.
@@ -78,8 +79,15 @@ public:
 private:
   friend Connection;
 
+  /*
+   * The maximum length of the command tag. (The tags are never longer than
+   * COMPLETION_TAG_BUFSIZE - 1 which is 63 in PostgreSQL.)
+   */
+  static constexpr std::size_t max_tag_size_{63};
+
   long row_count_{-2}; // -1 - no value, -2 - invalid instance
-  std::string tag_;
+  std::array<char, max_tag_size_> tag_{}; // stored inline to avoid allocation
+  std::size_t tag_size_{};
 
   explicit Completion(const std::string_view tag);
   bool is_invariant_ok() const noexcept;
@@ -65,6 +65,7 @@ public:
 
 private:
   friend Row;
+  friend Row_view;
   friend Tuple;
 
   Composite() = default;
@@ -23,7 +23,10 @@
 #include "ready_for_query.hpp"
 #include "statement.hpp"
 
+#include <cstdlib>
 #include <iostream>
+#include <iterator>
+#include <limits>
 
 namespace dmitigr::pgfe {
 
@@ -118,6 +121,16 @@ DMITIGR_PGFE_INLINE void Connection::swap(Connection& rhs) noexcept
   swap(notice_handler_, rhs.notice_handler_);
   swap(notification_handler_, rhs.notification_handler_);
   swap(default_result_format_, rhs.default_result_format_);
+  swap(default_parameter_format_, rhs.default_parameter_format_);
+  swap(default_row_batch_size_, rhs.default_row_batch_size_);
+  swap(default_result_retrieval_, rhs.default_result_retrieval_);
+  swap(adaptive_result_threshold_, rhs.adaptive_result_threshold_);
+  swap(auto_prepare_threshold_, rhs.auto_prepare_threshold_);
+  swap(auto_prepare_capacity_, rhs.auto_prepare_capacity_);
+  swap(auto_prepare_hit_count_, rhs.auto_prepare_hit_count_);
+  swap(auto_prepare_miss_count_, rhs.auto_prepare_miss_count_);
+  swap(ps_count_limit_, rhs.ps_count_limit_);
+  swap(ps_memory_limit_, rhs.ps_memory_limit_);
   //
   swap(execute_ps_state_, rhs.execute_ps_state_);
   swap(execute_ps_state_->connection_, rhs.execute_ps_state_->connection_);
@@ -126,6 +139,7 @@ DMITIGR_PGFE_INLINE void Connection::swap(Connection& rhs) noexcept
   swap(polling_status_, rhs.polling_status_);
   swap(lo_id_, rhs.lo_id_);
   swap(session_start_time_, rhs.session_start_time_);
+  swap(session_state_, rhs.session_state_);
   swap(response_, rhs.response_);
   swap(response_status_, rhs.response_status_);
   swap(last_prepared_statement_, rhs.last_prepared_statement_);
@@ -135,12 +149,17 @@ DMITIGR_PGFE_INLINE void Connection::swap(Connection& rhs) noexcept
   swap(*copier_state_, *rhs.copier_state_);
   //
   swap(is_single_row_mode_enabled_, rhs.is_single_row_mode_enabled_);
+  swap(row_batch_info_, rhs.row_batch_info_);
+  swap(row_batch_offset_, rhs.row_batch_offset_);
+  swap(whole_result_completion_, rhs.whole_result_completion_);
   //
   swap(ps_states_, rhs.ps_states_);
-  for (auto& state : ps_states_)
+  for (auto& [id, state] : ps_states_)
     state->connection_ = this;
-  for (auto& state : rhs.ps_states_)
+  for (auto& [id, state] : rhs.ps_states_)
     state->connection_ = &rhs;
+  swap(ps_memory_size_, rhs.ps_memory_size_);
+  swap(auto_prepared_count_, rhs.auto_prepared_count_);
   //
   swap(lo_states_, rhs.lo_states_);
   for (auto& state : lo_states_)
@@ -150,6 +169,16 @@ DMITIGR_PGFE_INLINE void Connection::swap(Connection& rhs) noexcept
   //
   swap(requests_, rhs.requests_);
   swap(last_processed_request_, rhs.last_processed_request_);
+  swap(handle_connection_, rhs.handle_connection_);
+  if (handle_connection_)
+    *handle_connection_ = this;
+  if (rhs.handle_connection_)
+    *rhs.handle_connection_ = &rhs;
+  //
+  swap(auto_prepared_, rhs.auto_prepared_);
+  swap(auto_prepared_index_, rhs.auto_prepared_index_);
+  swap(auto_prepared_id_, rhs.auto_prepared_id_);
+  swap(auto_prepared_evicted_, rhs.auto_prepared_evicted_);
 }
 
 DMITIGR_PGFE_INLINE const Connection_options& Connection::options() const noexcept
@@ -210,6 +239,99 @@ DMITIGR_PGFE_INLINE bool Connection::is_transaction_uncommitted() const noexcept
   return (transaction_status() == Transaction_status::uncommitted);
 }
 
+DMITIGR_PGFE_INLINE Session_state Connection::session_state() const noexcept
+{
+  auto result = session_state_;
+  if (const auto ts = transaction_status(); ts && ts != Transaction_status::unstarted)
+    result |= Session_state::transaction;
+  if (ps_states_.size() - ps_states_.count(std::string_view{}) >
+    auto_prepared_count_)
+    result |= Session_state::prepared_statements; // named by the user
+  return result;
+}
+
+DMITIGR_PGFE_INLINE bool Connection::is_session_state_dirty() const noexcept
+{
+  return session_state() != Session_state::clean;
+}
+
+DMITIGR_PGFE_INLINE void Connection::reset_session_state(Session_state state)
+{
+  using Ss = Session_state;
+
+  if (!is_ready_for_request())
+    throw Client_exception{"cannot reset session state: not ready for request"};
+
+  state &= session_state();
+  if (state == Ss::clean)
+    return;
+
+  std::vector<const char*> commands;
+  commands.reserve(7);
+  if (bool(state & Ss::transaction))
+    commands.push_back("ROLLBACK");
+  if (bool(state & Ss::cursors))
+    commands.push_back("CLOSE ALL");
+  if (bool(state & Ss::settings)) {
+    commands.push_back("SET SESSION AUTHORIZATION DEFAULT");
+    commands.push_back("RESET ALL");
+  }
+  if (bool(state & Ss::listening))
+    commands.push_back("UNLISTEN *");
+  if (bool(state & Ss::temporary_objects))
+    commands.push_back("DISCARD TEMP");
+  if (bool(state & Ss::prepared_statements))
+    commands.push_back("DEALLOCATE ALL");
+
+#ifdef LIBPQ_HAS_PIPELINING
+  /*
+   * Send the commands in the single round trip. Each of the commands is
+   * followed by the synchronization point in order to isolate possible errors.
+   */
+  set_pipeline_enabled(true);
+  std::string error;
+  try {
+    for (const auto* const command : commands) {
+      if (!PQsendQueryParams(conn(), command, 0, nullptr, nullptr, nullptr,
+          nullptr, 0) || !PQpipelineSync(conn()))
+        throw Client_exception{error_message()};
+    }
+
+    // Collect the results up to the last synchronization point.
+    for (std::size_t i{}; i < commands.size();) {
+      detail::pq::Result result{PQgetResult(conn())};
+      if (!result) {
+        if (!is_connected())
+          throw Client_exception{error_message()};
+      } else if (const auto status = result.status(); status == PGRES_PIPELINE_SYNC)
+        ++i;
+      else if (status == PGRES_FATAL_ERROR && error.empty())
+        error = result.er_brief();
+    }
+    set_pipeline_enabled(false);
+  } catch (...) {
+    disconnect(); // the state of connection is unknown
+    throw;
+  }
+  if (!error.empty())
+    throw Client_exception{"cannot reset session state: " + error};
+#else
+  for (const auto* const command : commands)
+    execute(command);
+#endif
+
+  if (bool(state & Ss::prepared_statements)) {
+    for (auto p = cbegin(ps_states_); p != cend(ps_states_);) {
+      const auto next = std::next(p);
+      if (!p->first.empty())
+        unregister_ps(p); // deallocated by DEALLOCATE ALL
+      p = next;
+    }
+  }
+  session_state_ &= ~state;
+  DMITIGR_ASSERT((session_state() & state) == Ss::clean);
+}
+
 DMITIGR_PGFE_INLINE std::int_fast32_t Connection::server_pid() const noexcept
 {
   return is_connected() ? PQbackendPID(conn()) : 0;
@@ -438,10 +560,19 @@ Connection::handle_input(const bool wait_response)
   if (!is_connected())
     throw Client_exception{"cannot handle input from server: not connected"};
 
+  static const auto is_rows_status = [](const auto status) noexcept
+  {
+    return status == PGRES_SINGLE_TUPLE
+#ifdef LIBPQ_HAS_CHUNK_MODE
+      || status == PGRES_TUPLES_CHUNK
+#endif
+      ;
+  };
+
   const auto check_state = [this]() noexcept
   {
     DMITIGR_ASSERT(response_status_ == Response_status::ready_not_preprocessed);
-    DMITIGR_ASSERT(response_.status() == PGRES_SINGLE_TUPLE);
+    DMITIGR_ASSERT(is_rows_status(response_.status()));
     DMITIGR_ASSERT(!requests_.empty());
     DMITIGR_ASSERT(requests_.front().id_ == Request::Id::execute);
   };
@@ -467,6 +598,19 @@ Connection::handle_input(const bool wait_response)
       status == PGRES_BAD_RESPONSE;
   };
 
+  /*
+   * The rows of the current response not yet returned by row() are responded
+   * first, since getting the next result releases them. In pipeline mode, the
+   * next result belongs to the next request. Thus, the completion of the whole
+   * result released by row_batch() or result_set() is responded first as well
+   * (once).
+   */
+  if (has_row_batch() || (pipeline_status() != Pipeline_status::disabled &&
+      whole_result_completion_ && response_status_ == Response_status::empty)) {
+    response_status_ = Response_status::ready;
+    goto handle_notifications;
+  }
+
   /*
    * According to https://www.postgresql.org/docs/current/libpq-pipeline-mode.html,
    * "To enter single-row mode, call PQsetSingleRowMode() before retrieving
@@ -476,8 +620,9 @@ Connection::handle_input(const bool wait_response)
    */
   if ((pipeline_status() == Pipeline_status::enabled) &&
     !is_single_row_mode_enabled_ && !requests_.empty() &&
-    requests_.front().id_ == Request::Id::execute)
-    set_single_row_mode_enabled();
+    requests_.front().id_ == Request::Id::execute &&
+    !requests_.front().is_whole_result_)
+    set_single_row_mode_enabled(requests_.front().row_batch_size_);
 
   if (wait_response) {
     if (response_status_ == Response_status::unready) {
@@ -489,9 +634,12 @@ Connection::handle_input(const bool wait_response)
     } else if (!response_ || (response_status_ == Response_status::ready &&
         is_completion_status(response_.status()))) {
       response_.reset(PQgetResult(conn()));
-      if (response_.status() == PGRES_SINGLE_TUPLE) {
+      release_row_batch();
+      whole_result_completion_ = {};
+      if (is_rows_status(response_.status())) {
         response_status_ = Response_status::ready_not_preprocessed;
         check_state();
+        reserve_row_batch_info(); // can throw
         goto handle_notifications;
       } else if (is_completion_status(response_.status()))
         goto complete_response;
@@ -528,9 +676,12 @@ Connection::handle_input(const bool wait_response)
         is_completion_status(response_.status()))) {
       if (!is_get_result_would_block(conn())) {
         response_.reset(PQgetResult(conn()));
-        if (response_.status() == PGRES_SINGLE_TUPLE) {
+        release_row_batch();
+        whole_result_completion_ = {};
+        if (is_rows_status(response_.status())) {
           response_status_ = Response_status::ready_not_preprocessed;
           check_state();
+          reserve_row_batch_info(); // can throw
           goto handle_notifications;
         } else if (is_completion_status(response_.status())) {
           response_status_ = Response_status::unready;
@@ -548,9 +699,18 @@ Connection::handle_input(const bool wait_response)
   if (response_status_ == Response_status::ready_not_preprocessed) {
     const auto rstatus = response_.status();
     DMITIGR_ASSERT(rstatus != PGRES_NONFATAL_ERROR);
-    DMITIGR_ASSERT(rstatus != PGRES_SINGLE_TUPLE);
+    DMITIGR_ASSERT(!is_rows_status(rstatus));
     if (rstatus == PGRES_TUPLES_OK) {
-      DMITIGR_ASSERT(last_processed_request_.id_ == Request::Id::execute);
+      auto& lpr = last_processed_request_;
+      DMITIGR_ASSERT(lpr.id_ == Request::Id::execute);
+      if (lpr.is_whole_result_)
+        reserve_row_batch_info(); // can throw
+      if (const auto state = lpr.adaptive_ps_state_.lock()) {
+        state->last_row_count_ = lpr.is_whole_result_ ?
+          response_.row_count() :
+          std::strtol(response_.affected_row_count(), nullptr, 10);
+        lpr.adaptive_ps_state_.reset();
+      }
       is_single_row_mode_enabled_ = false;
     } else if (rstatus == PGRES_COPY_OUT || rstatus == PGRES_COPY_IN) {
       // is_copy_in_progress() now returns `true`, copier() returns Copier.
@@ -560,6 +720,7 @@ Connection::handle_input(const bool wait_response)
       reset_copier_state();
       is_single_row_mode_enabled_ = false;
     } else if (rstatus == PGRES_COMMAND_OK) {
+      track_session_state__(response_.command_tag());
       auto& lpr = last_processed_request_;
       DMITIGR_ASSERT(lpr.id_ != Request::Id::prepare || lpr.prepared_statement_);
       DMITIGR_ASSERT(lpr.id_ != Request::Id::describe || lpr.prepared_statement_);
@@ -567,8 +728,9 @@ Connection::handle_input(const bool wait_response)
       if (lpr.id_ == Request::Id::prepare) {
         auto& ps = lpr.prepared_statement_;
         DMITIGR_ASSERT(ps);
-        const auto [p, e] = registered_ps(ps.name());
-        DMITIGR_ASSERT(p == e);
+        // The registered one must be deallocated by SQL DEALLOCATE if any.
+        if (const auto [p, e] = registered_ps(ps.name()); p != e)
+          unregister_ps(p);
         register_ps(std::move(ps)); // can throw (ps will not be affected)
         DMITIGR_ASSERT(last_prepared_statement_);
       } else if (lpr.id_ == Request::Id::describe) {
@@ -627,11 +789,9 @@ DMITIGR_PGFE_INLINE bool Connection::is_nio_output_enabled() const noexcept
 
 DMITIGR_PGFE_INLINE bool Connection::flush_output(const bool wait)
 {
-  if (is_output_flushed_)
-    return true;
-
   using Sr = Socket_readiness;
   if (const int r{PQflush(conn())}; r == 1) {
+    is_output_flushed_ = false;
     if (wait) {
       const auto sr = wait_socket_readiness(Sr::read_ready | Sr::write_ready);
       if (sr == Sr::read_ready) {
@@ -721,8 +881,37 @@ DMITIGR_PGFE_INLINE Error Connection::error() noexcept
 
 DMITIGR_PGFE_INLINE Row Connection::row() noexcept
 {
-  return (response_.status() == PGRES_SINGLE_TUPLE)
-    ? Row{release_response()} : Row{};
+  if (response_.status() == PGRES_SINGLE_TUPLE)
+    return Row{release_response()};
+  else if (!has_row_batch() && is_rows_response())
+    share_rows_response();
+
+  if (has_row_batch()) {
+    Row result{std::shared_ptr<const Row_info>{row_batch_info_}, row_batch_offset_};
+    if (++row_batch_offset_ == row_batch_info_->pq_result_.row_count())
+      release_row_batch();
+    return result;
+  }
+  return Row{};
+}
+
+DMITIGR_PGFE_INLINE Row_batch Connection::row_batch() noexcept
+{
+  if (!has_row_batch() && is_rows_response())
+    share_rows_response();
+
+  if (has_row_batch()) {
+    Row_batch result{row_batch_info_, row_batch_offset_};
+    release_row_batch();
+    return result;
+  }
+  return Row_batch{};
+}
+
+DMITIGR_PGFE_INLINE Result_set Connection::result_set() noexcept
+{
+  return is_whole_result_response() ?
+    Result_set{release_rows_response()} : Result_set{};
 }
 
 DMITIGR_PGFE_INLINE Notification Connection::pop_notification()
@@ -759,7 +948,8 @@ Connection::notification_handler() const noexcept -> const Notification_handler&
 
 DMITIGR_PGFE_INLINE bool Connection::has_response() const noexcept
 {
-  return static_cast<bool>(response_) && (response_status_ == Response_status::ready);
+  return (response_ || has_row_batch() || whole_result_completion_) &&
+    (response_status_ == Response_status::ready);
 }
 
 DMITIGR_PGFE_INLINE Copier Connection::copier() noexcept
@@ -771,6 +961,9 @@ DMITIGR_PGFE_INLINE Copier Connection::copier() noexcept
 
 DMITIGR_PGFE_INLINE Completion Connection::completion() noexcept
 {
+  if (whole_result_completion_ && !has_row_batch())
+    return std::move(whole_result_completion_);
+
   switch (response_.status()) {
   case PGRES_TUPLES_OK:
     return Completion{release_response().command_tag()};
@@ -841,6 +1034,22 @@ DMITIGR_PGFE_INLINE bool Connection::has_uncompleted_request() const noexcept
   return !requests_.empty();
 }
 
+DMITIGR_PGFE_INLINE Request_handle Connection::last_request_handle()
+{
+  if (requests_.empty())
+    throw Client_exception{"cannot get request handle: no uncompleted requests"};
+
+  auto& request = requests_.back();
+  if (!request.handle_state_) {
+    auto connection = handle_connection_ ? handle_connection_ :
+      std::make_shared<Connection*>(this); // can throw
+    request.handle_state_ =
+      std::make_shared<Request_handle::State>(connection); // can throw
+    handle_connection_ = std::move(connection);
+  }
+  return Request_handle{request.handle_state_};
+}
+
 DMITIGR_PGFE_INLINE void
 Connection::prepare_nio(const Statement& statement, const std::string& name)
 {
@@ -873,9 +1082,13 @@ DMITIGR_PGFE_INLINE void Connection::describe_nio(const std::string& name)
     throw Client_exception{"cannot describe prepared statement: "
       "not ready for non-blocking IO request"};
 
+  if (is_ps_limit_reached())
+    throw Client_exception{"cannot describe prepared statement: "
+      "limit of prepared statements reached"};
+
   const auto [p, e] = registered_ps(name);
   auto state = (p == e) ?
-    std::make_shared<Prepared_statement::State>(name, this) : *p;
+    std::make_shared<Prepared_statement::State>(name, this) : p->second;
   Prepared_statement ps{state};
   requests_.emplace(Request::Id::describe, std::move(ps)); // can throw
   try {
@@ -883,7 +1096,7 @@ DMITIGR_PGFE_INLINE void Connection::describe_nio(const std::string& name)
     if (!send_ok)
       throw Client_exception{error_message()};
   } catch (...) {
-    requests_.pop(); // rollback
+    requests_.pop_back(); // rollback
     throw;
   }
 
@@ -895,6 +1108,8 @@ DMITIGR_PGFE_INLINE Prepared_statement Connection::describe(const std::string& n
   if (!is_ready_for_request())
     throw Client_exception{"cannot describe prepared statement: "
       "not ready for non-blocking IO request"};
+  if (is_ps_limit_reached())
+    reclaim_ps__();
   describe_nio(name);
   return wait_prepared_statement__();
 }
@@ -908,9 +1123,9 @@ DMITIGR_PGFE_INLINE void Connection::unprepare_nio(const std::string& name)
   auto name_copy = name; // can throw
   const auto query = "DEALLOCATE " + to_quoted_identifier(name); // can throw
   execute_nio(query); // can throw
-  DMITIGR_ASSERT(requests_.front().id_ == Request::Id::execute);
-  requests_.front().id_ = Request::Id::unprepare; // cannot throw
-  requests_.front().prepared_statement_name_ = std::move(name_copy); // cannot throw
+  DMITIGR_ASSERT(requests_.back().id_ == Request::Id::execute);
+  requests_.back().id_ = Request::Id::unprepare; // cannot throw
+  requests_.back().prepared_statement_name_ = std::move(name_copy); // cannot throw
 
   assert(is_invariant_ok());
 }
@@ -994,6 +1209,157 @@ DMITIGR_PGFE_INLINE Data_format Connection::result_format() const noexcept
   return default_result_format_;
 }
 
+DMITIGR_PGFE_INLINE void
+Connection::set_parameter_format(const Data_format format)
+{
+  default_parameter_format_ = format;
+  assert(is_invariant_ok());
+}
+
+DMITIGR_PGFE_INLINE Data_format Connection::parameter_format() const noexcept
+{
+  return default_parameter_format_;
+}
+
+DMITIGR_PGFE_INLINE void Connection::set_row_batch_size(const std::size_t size)
+{
+  if (!size || size > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+    throw Client_exception{"cannot set row batch size: invalid size"};
+  default_row_batch_size_ = size;
+  assert(is_invariant_ok());
+}
+
+DMITIGR_PGFE_INLINE std::size_t Connection::row_batch_size() const noexcept
+{
+  return default_row_batch_size_;
+}
+
+DMITIGR_PGFE_INLINE void
+Connection::set_result_retrieval(const Result_retrieval retrieval)
+{
+  default_result_retrieval_ = retrieval;
+  assert(is_invariant_ok());
+}
+
+DMITIGR_PGFE_INLINE Result_retrieval
+Connection::result_retrieval() const noexcept
+{
+  return default_result_retrieval_;
+}
+
+DMITIGR_PGFE_INLINE void
+Connection::set_adaptive_result_threshold(const std::size_t row_count)
+{
+  adaptive_result_threshold_ = row_count;
+  assert(is_invariant_ok());
+}
+
+DMITIGR_PGFE_INLINE std::size_t
+Connection::adaptive_result_threshold() const noexcept
+{
+  return adaptive_result_threshold_;
+}
+
+DMITIGR_PGFE_INLINE void
+Connection::set_auto_prepare_threshold(const std::size_t count)
+{
+  auto_prepare_threshold_ = count;
+  assert(is_invariant_ok());
+}
+
+DMITIGR_PGFE_INLINE std::size_t
+Connection::auto_prepare_threshold() const noexcept
+{
+  return auto_prepare_threshold_;
+}
+
+DMITIGR_PGFE_INLINE void
+Connection::set_auto_prepare_capacity(const std::size_t capacity)
+{
+  if (!capacity)
+    throw Client_exception{"cannot set auto-prepare capacity: "
+      "invalid capacity specified"};
+  auto_prepare_capacity_ = capacity;
+  assert(is_invariant_ok());
+}
+
+DMITIGR_PGFE_INLINE std::size_t
+Connection::auto_prepare_capacity() const noexcept
+{
+  return auto_prepare_capacity_;
+}
+
+DMITIGR_PGFE_INLINE std::size_t
+Connection::auto_prepare_hit_count() const noexcept
+{
+  return auto_prepare_hit_count_;
+}
+
+DMITIGR_PGFE_INLINE std::size_t
+Connection::auto_prepare_miss_count() const noexcept
+{
+  return auto_prepare_miss_count_;
+}
+
+DMITIGR_PGFE_INLINE void
+Connection::set_prepared_statement_count_limit(const std::size_t count)
+{
+  ps_count_limit_ = count;
+  assert(is_invariant_ok());
+}
+
+DMITIGR_PGFE_INLINE std::size_t
+Connection::prepared_statement_count_limit() const noexcept
+{
+  return ps_count_limit_;
+}
+
+DMITIGR_PGFE_INLINE void
+Connection::set_prepared_statement_memory_limit(const std::size_t size)
+{
+  ps_memory_limit_ = size;
+  assert(is_invariant_ok());
+}
+
+DMITIGR_PGFE_INLINE std::size_t
+Connection::prepared_statement_memory_limit() const noexcept
+{
+  return ps_memory_limit_;
+}
+
+DMITIGR_PGFE_INLINE std::size_t
+Connection::prepared_statement_count() const noexcept
+{
+  return ps_states_.size();
+}
+
+DMITIGR_PGFE_INLINE Prepared_statement
+Connection::registered_prepared_statement(const std::string_view name,
+  const Statement& statement)
+{
+  if (name.empty())
+    throw Client_exception{"cannot get registered prepared statement: "
+      "empty name specified"};
+
+  if (const auto [p, e] = registered_ps(name); p != e)
+    return Prepared_statement{p->second, &statement, true};
+  return Prepared_statement{};
+}
+
+DMITIGR_PGFE_INLINE std::size_t
+Connection::prepared_statement_memory_size() const noexcept
+{
+  return ps_memory_size_;
+}
+
+DMITIGR_PGFE_INLINE void Connection::reclaim_prepared_statements()
+{
+  if (!is_ready_for_request())
+    throw Client_exception{"cannot reclaim prepared statements: "
+      "not ready for request"};
+  reclaim_ps__({}, {}, true);
+}
+
 DMITIGR_PGFE_INLINE Oid Connection::create_large_object(const Oid oid)
 {
   if (!is_ready_for_request())
@@ -1161,6 +1527,111 @@ DMITIGR_PGFE_INLINE detail::pq::Result Connection::release_response() noexcept
   return std::move(response_);
 }
 
+DMITIGR_PGFE_INLINE detail::pq::Result Connection::release_rows_response() noexcept
+{
+  if (is_whole_result_response())
+    whole_result_completion_ = Completion{response_.command_tag()};
+  return release_response();
+}
+
+DMITIGR_PGFE_INLINE bool Connection::is_whole_result_response() const noexcept
+{
+  return response_.status() == PGRES_TUPLES_OK &&
+    last_processed_request_.id_ == Request::Id::execute &&
+    last_processed_request_.is_whole_result_;
+}
+
+DMITIGR_PGFE_INLINE bool Connection::is_rows_response() const noexcept
+{
+  const auto status = response_.status();
+  return status == PGRES_SINGLE_TUPLE
+#ifdef LIBPQ_HAS_CHUNK_MODE
+    || status == PGRES_TUPLES_CHUNK
+#endif
+    || (is_whole_result_response() && response_.row_count() > 0);
+}
+
+DMITIGR_PGFE_INLINE bool Connection::has_row_batch() const noexcept
+{
+  return row_batch_info_ &&
+    row_batch_offset_ < row_batch_info_->pq_result_.row_count();
+}
+
+DMITIGR_PGFE_INLINE void Connection::reserve_row_batch_info()
+{
+  // The unreferenced instance is reused to avoid the allocation per batch.
+  if (!row_batch_info_ || row_batch_info_.use_count() > 1)
+    row_batch_info_ = std::make_shared<Row_info>(); // can throw
+}
+
+DMITIGR_PGFE_INLINE void Connection::share_rows_response() noexcept
+{
+  DMITIGR_ASSERT(is_rows_response() && !has_row_batch());
+  DMITIGR_ASSERT(row_batch_info_ && row_batch_info_.use_count() == 1);
+  row_batch_info_->pq_result_ = release_rows_response();
+  row_batch_offset_ = 0;
+}
+
+DMITIGR_PGFE_INLINE void Connection::release_row_batch() noexcept
+{
+  if (row_batch_info_) {
+    // The rows might be still referenced by the instances of Row or Row_batch.
+    if (row_batch_info_.use_count() == 1)
+      row_batch_info_->pq_result_ = {};
+    row_batch_offset_ = row_batch_info_->pq_result_.row_count();
+    response_status_ = Response_status::empty; // no rows to respond
+  }
+}
+
+DMITIGR_PGFE_INLINE void Connection::route_response__(const bool is_dismissing)
+{
+  DMITIGR_ASSERT(has_response());
+  const auto status = response_.status();
+  const bool is_rows = status == PGRES_SINGLE_TUPLE
+#ifdef LIBPQ_HAS_CHUNK_MODE
+    || status == PGRES_TUPLES_CHUNK
+#endif
+    ;
+  const auto& request = is_rows ? requests_.front() : last_processed_request_;
+  if (!request.handle_state_) {
+    if (!is_dismissing)
+      // Keep the response to be processed by the generic API.
+      throw Client_exception{"cannot route response to request handle: "
+        "the response to the preceding request without handle is pending"};
+
+    if (request.id_ == Request::Id::prepare || request.id_ == Request::Id::describe)
+      prepared_statement();
+    release_response();
+    whole_result_completion_ = {};
+    return;
+  }
+
+  auto& state = *request.handle_state_;
+  if (is_rows || is_whole_result_response()) {
+    while (auto row = this->row()) // can throw
+      state.rows_.push_back(std::move(row)); // can throw
+    if (!is_rows) {
+      state.completion_ = completion();
+      state.is_ready_ = true;
+    }
+  } else if (status == PGRES_FATAL_ERROR) {
+    state.error_ = error();
+    state.is_ready_ = true;
+  } else if (request.id_ == Request::Id::prepare ||
+    request.id_ == Request::Id::describe) {
+    state.prepared_statement_ = prepared_statement();
+    release_response();
+    state.is_ready_ = true;
+  } else {
+#ifdef LIBPQ_HAS_PIPELINING
+    state.is_aborted_ = status == PGRES_PIPELINE_ABORTED;
+#endif
+    state.completion_ = completion();
+    release_response();
+    state.is_ready_ = true;
+  }
+}
+
 DMITIGR_PGFE_INLINE void
 Connection::reset_response(detail::pq::Result&& response) noexcept
 {
@@ -1171,20 +1642,31 @@ Connection::reset_response(detail::pq::Result&& response) noexcept
 DMITIGR_PGFE_INLINE void Connection::reset_session() noexcept
 {
   session_start_time_.reset();
+  session_state_ = {};
   response_.reset();
   response_status_ = {};
-  requests_ = {};
+  requests_.clear();
+  last_processed_request_ = {};
+  if (handle_connection_) {
+    *handle_connection_ = nullptr; // invalidate instances of Request_handle
+    handle_connection_.reset();
+  }
   is_output_flushed_ = true;
   reset_copier_state();
   is_single_row_mode_enabled_ = false;
+  row_batch_info_.reset();
+  row_batch_offset_ = 0;
+  whole_result_completion_ = {};
 
   // Reset prepared statements.
   last_prepared_statement_ = {};
-  for (auto& s : ps_states_) {
+  for (auto& [id, s] : ps_states_) {
     DMITIGR_ASSERT(s);
     s->connection_ = nullptr;
   }
   ps_states_.clear();
+  ps_memory_size_ = 0;
+  auto_prepared_count_ = 0;
 
   // Reset large objects.
   for (auto& s : lo_states_) {
@@ -1192,6 +1674,31 @@ DMITIGR_PGFE_INLINE void Connection::reset_session() noexcept
     s->connection_ = nullptr;
   }
   lo_states_.clear();
+
+  // Reset the auto-prepare cache.
+  auto_prepared_index_.clear();
+  auto_prepared_.clear();
+  auto_prepared_evicted_.clear();
+}
+
+DMITIGR_PGFE_INLINE void
+Connection::track_session_state__(const char* const command_tag) noexcept
+{
+  using Ss = Session_state;
+  const std::string_view tag{command_tag ? command_tag : ""};
+  if (tag == "SET" || tag == "RESET")
+    session_state_ |= Ss::settings;
+  else if (tag == "CREATE TABLE" || tag == "CREATE VIEW" ||
+    tag == "CREATE SEQUENCE")
+    session_state_ |= Ss::temporary_objects;
+  else if (tag == "LISTEN")
+    session_state_ |= Ss::listening;
+  else if (tag == "PREPARE")
+    session_state_ |= Ss::prepared_statements;
+  else if (tag == "DECLARE CURSOR")
+    session_state_ |= Ss::cursors;
+  else if (tag == "DISCARD ALL")
+    session_state_ = Ss::clean;
 }
 
 DMITIGR_PGFE_INLINE void Connection::reset_copier_state() noexcept
@@ -1202,9 +1709,17 @@ DMITIGR_PGFE_INLINE void Connection::reset_copier_state() noexcept
   }
 }
 
-DMITIGR_PGFE_INLINE void Connection::set_single_row_mode_enabled() noexcept
+DMITIGR_PGFE_INLINE void
+Connection::set_single_row_mode_enabled(const std::size_t row_batch_size) noexcept
 {
+  DMITIGR_ASSERT(row_batch_size > 0);
+#ifdef LIBPQ_HAS_CHUNK_MODE
+  const auto set_ok = row_batch_size > 1 ?
+    PQsetChunkedRowsMode(conn(), static_cast<int>(row_batch_size)) :
+    PQsetSingleRowMode(conn());
+#else
   const auto set_ok = PQsetSingleRowMode(conn());
+#endif
   DMITIGR_ASSERT(set_ok);
   is_single_row_mode_enabled_ = true;
 }
@@ -1241,6 +1756,10 @@ Connection::prepare_nio__(const char* const query, const char* const name,
       "not ready for non-blocking IO request"};
   DMITIGR_ASSERT(query);
   DMITIGR_ASSERT(name);
+  if (*name && registered_ps(name).first == cend(ps_states_) &&
+    is_ps_limit_reached())
+    throw Client_exception{"cannot prepare statement: "
+      "limit of prepared statements reached"};
 
   auto state = std::make_shared<Prepared_statement::State>(name, this);
   Prepared_statement ps{std::move(state), preparsed, true};
@@ -1252,7 +1771,7 @@ Connection::prepare_nio__(const char* const query, const char* const name,
     if (!send_ok)
       throw Client_exception{error_message()};
   } catch (...) {
-    requests_.pop(); // rollback
+    requests_.pop_back(); // rollback
     throw;
   }
 
@@ -1269,11 +1788,77 @@ DMITIGR_PGFE_INLINE Prepared_statement Connection::wait_prepared_statement__()
   return prepared_statement();
 }
 
+DMITIGR_PGFE_INLINE bool
+Connection::is_auto_prepared_name(const std::string_view name) noexcept
+{
+  return name.substr(0, auto_prepared_prefix_.size()) == auto_prepared_prefix_;
+}
+
+DMITIGR_PGFE_INLINE Prepared_statement
+Connection::auto_prepared__(const Statement& statement)
+{
+  if (!auto_prepare_threshold_)
+    return Prepared_statement{};
+
+  auto query = statement.to_query_string(*this); // can throw
+  auto p = begin(auto_prepared_);
+  if (const auto i = auto_prepared_index_.find(query);
+      i != cend(auto_prepared_index_)) {
+    p = i->second;
+    auto_prepared_.splice(begin(auto_prepared_), auto_prepared_, p);
+    if (p->state_ && p->state_->connection_ != this) {
+      // Unprepared by the user.
+      p->state_.reset();
+      p->execution_count_ = 0;
+    }
+    if (p->state_) {
+      ++auto_prepare_hit_count_;
+      return Prepared_statement{p->state_, &statement, false};
+    }
+  } else {
+    /*
+     * Evict the least recently used entries. (The evicted statements are
+     * deallocated by reclaim_ps__() upon the next promotion.)
+     */
+    while (auto_prepared_.size() >= auto_prepare_capacity_) {
+      if (const auto& state = auto_prepared_.back().state_;
+          state && state->connection_ == this)
+        auto_prepared_evicted_.push_back(state->id_); // can throw
+      auto_prepared_index_.erase(auto_prepared_.back().query_);
+      auto_prepared_.pop_back();
+    }
+    auto_prepared_.push_front(Auto_prepared{std::move(query), 0, nullptr}); // can throw
+    p = begin(auto_prepared_);
+    try {
+      auto_prepared_index_.emplace(p->query_, p); // can throw
+    } catch (...) {
+      auto_prepared_.pop_front(); // rollback
+      throw;
+    }
+  }
+
+  ++auto_prepare_miss_count_;
+  if (++p->execution_count_ < auto_prepare_threshold_)
+    return Prepared_statement{};
+
+  auto name = std::string{auto_prepared_prefix_}
+    .append(std::to_string(++auto_prepared_id_));
+  p->state_ = reclaim_ps__(name.c_str(), p->query_.c_str());
+  if (!p->state_) {
+    p->execution_count_ = 0;
+    return Prepared_statement{};
+  }
+  return Prepared_statement{p->state_, &statement, false};
+}
+
 DMITIGR_PGFE_INLINE void
 Connection::register_ps(Prepared_statement&& ps)
 {
-  if (const auto [p, e] = registered_ps(ps.name()); p == e)
-    ps_states_.push_back(ps.state_); // can throw
+  if (const auto [p, e] = registered_ps(ps.name()); p == e) {
+    ps_states_.emplace(ps.state_->id_, ps.state_); // can throw
+    auto_prepared_count_ += is_auto_prepared_name(ps.state_->id_);
+  }
+  account_ps(*ps.state_);
   last_prepared_statement_ = std::move(ps);
   DMITIGR_ASSERT(last_prepared_statement_);
 }
@@ -1289,7 +1874,150 @@ Connection::unregister_ps(const std::string_view name) noexcept
 DMITIGR_PGFE_INLINE void
 Connection::unregister_ps(decltype(ps_states_)::const_iterator p) noexcept
 {
-  unregister(ps_states_, p);
+  /*
+   * `p == cend(ps_states_)` on attempt to unregister the statement prepared
+   * with SQL PREPARE but deallocated with unprepare().
+   */
+  if (p != cend(ps_states_)) {
+    auto& state = *p->second;
+    DMITIGR_ASSERT(state.connection_ == this);
+    DMITIGR_ASSERT(state.description_size_ <= ps_memory_size_);
+    ps_memory_size_ -= state.description_size_;
+    state.description_size_ = 0;
+    state.connection_ = nullptr; // invalidate instance(-s)
+    auto_prepared_count_ -= is_auto_prepared_name(p->first);
+    ps_states_.erase(p);         // remove the copy of state
+  }
+}
+
+DMITIGR_PGFE_INLINE bool
+Connection::is_ps_limit_reached(const std::size_t reclaimed_count,
+  const std::size_t reclaimed_size) const noexcept
+{
+  DMITIGR_ASSERT(reclaimed_size <= ps_memory_size_);
+  const auto count = ps_states_.size() - ps_states_.count(std::string_view{});
+  DMITIGR_ASSERT(reclaimed_count <= count);
+  return
+    (ps_count_limit_ && count - reclaimed_count >= ps_count_limit_) ||
+    (ps_memory_limit_ && ps_memory_size_ - reclaimed_size >= ps_memory_limit_);
+}
+
+DMITIGR_PGFE_INLINE void
+Connection::account_ps(Prepared_statement::State& state) noexcept
+{
+  DMITIGR_ASSERT(state.description_size_ <= ps_memory_size_);
+  ps_memory_size_ -= state.description_size_;
+  state.description_size_ = state.actual_description_size();
+  ps_memory_size_ += state.description_size_;
+}
+
+DMITIGR_PGFE_INLINE std::shared_ptr<Prepared_statement::State>
+Connection::reclaim_ps__(const char* const name, const char* const query,
+  const bool is_user_named_included)
+{
+  DMITIGR_ASSERT(is_ready_for_request());
+  DMITIGR_ASSERT(!name == !query);
+
+  /*
+   * Collect the unreferenced statements evicted from the auto-prepare cache,
+   * and also the unreferenced statements named by the user if requested.
+   */
+  std::vector<std::string_view> garbage;
+  std::size_t garbage_size{};
+  const auto collect = [&garbage, &garbage_size](const auto& entry)
+  {
+    if (entry.second.use_count() == 1) {
+      garbage.push_back(entry.first); // can throw
+      garbage_size += entry.second->description_size_;
+    }
+  };
+  for (const auto& id : auto_prepared_evicted_) {
+    if (const auto [p, e] = registered_ps(id); p != e)
+      collect(*p);
+  }
+  if (is_user_named_included) {
+    for (const auto& entry : ps_states_) {
+      if (!entry.first.empty() && !is_auto_prepared_name(entry.first))
+        collect(entry);
+    }
+  }
+  auto_prepared_evicted_.clear();
+  const bool is_prepare = name && !is_ps_limit_reached(garbage.size(),
+    garbage_size);
+
+#ifdef LIBPQ_HAS_PIPELINING
+  /*
+   * Send DEALLOCATE for the each statement followed by PREPARE (if any) in
+   * the single round trip. Each of the requests is followed by the
+   * synchronization point in order to isolate possible errors.
+   */
+  if (!garbage.empty()) {
+    set_pipeline_enabled(true);
+    ExecStatusType prepare_status{PGRES_FATAL_ERROR};
+    try {
+      bool send_ok{true};
+      for (const auto id : garbage) {
+        const auto deallocate = "DEALLOCATE " + to_quoted_identifier(id);
+        send_ok = PQsendQueryParams(conn(), deallocate.c_str(), 0, nullptr,
+          nullptr, nullptr, nullptr, 0) && PQpipelineSync(conn());
+        if (!send_ok)
+          break;
+      }
+      if (send_ok && is_prepare)
+        send_ok = PQsendPrepare(conn(), name, query, 0, nullptr) &&
+          PQpipelineSync(conn());
+      if (!send_ok)
+        throw Client_exception{error_message()};
+
+      // Collect the results up to the last synchronization point.
+      const auto sync_count = garbage.size() + is_prepare;
+      for (std::size_t i{}; i < sync_count;) {
+        detail::pq::Result result{PQgetResult(conn())};
+        if (!result) {
+          if (!is_connected())
+            throw Client_exception{error_message()};
+        } else if (const auto status = result.status(); status == PGRES_PIPELINE_SYNC)
+          ++i;
+        else if (i == garbage.size())
+          prepare_status = status;
+      }
+      set_pipeline_enabled(false);
+    } catch (...) {
+      disconnect(); // the state of connection is unknown
+      throw;
+    }
+
+    for (const auto id : garbage)
+      unregister_ps(id);
+
+    if (is_prepare && prepare_status == PGRES_COMMAND_OK) {
+      auto state = std::make_shared<Prepared_statement::State>(name, this);
+      state->preparsed_ = true;
+      ps_states_.emplace(state->id_, state); // can throw
+      ++auto_prepared_count_;
+      return state;
+    }
+    return nullptr;
+  }
+#endif
+
+  for (const auto id : garbage) {
+    const std::string id_copy{id}; // id is invalidated by unregistering
+    try {
+      unprepare(id_copy);
+    } catch (const Server_exception&) {
+      unregister_ps(id_copy); // deallocated by SQL DEALLOCATE
+    }
+  }
+
+  if (is_prepare) {
+    try {
+      prepare_nio__(query, name, nullptr);
+      const auto ps = wait_prepared_statement__();
+      return ps.state_;
+    } catch (const Server_exception&) {}
+  }
+  return nullptr;
 }
 
 DMITIGR_PGFE_INLINE int Connection::socket() const noexcept
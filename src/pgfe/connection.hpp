@@ -18,6 +18,7 @@
 #define DMITIGR_PGFE_CONNECTION_HPP
 
 #include "../base/assert.hpp"
+#include "../util/ring_queue.hpp"
 #include "basics.hpp"
 #include "completion.hpp"
 #include "connection_options.hpp"
@@ -30,7 +31,10 @@
 #include "notification.hpp"
 #include "pq.hpp"
 #include "prepared_statement.hpp"
+#include "request_handle.hpp"
+#include "result_set.hpp"
 #include "row.hpp"
+#include "row_batch.hpp"
 #include "types_fwd.hpp"
 
 #include <cassert>
@@ -40,9 +44,11 @@
 #include <list>
 #include <memory>
 #include <optional>
-#include <queue>
 #include <string>
+#include <string_view>
 #include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 namespace dmitigr::pgfe {
 
@@ -151,6 +157,59 @@ public:
   DMITIGR_PGFE_API std::optional<std::chrono::system_clock::time_point>
   session_start_time() const noexcept;
 
+  /**
+   * @returns The bitmask of the aspects of the session state which are mutated
+   * since the session start or the last call of reset_session_state().
+   *
+   * @details The mutations are tracked by the command tags of the completed
+   * commands (e.g. `SET`, `LISTEN`, `PREPARE`, `DECLARE CURSOR`), and by the
+   * current transaction_status() and the registered named prepared statements.
+   * The statements prepared automatically (see set_auto_prepare_threshold())
+   * are managed by the library and don't make the state dirty.
+   * The tracking is conservative: the commands like `CREATE TABLE` mark the
+   * session as having `Session_state::temporary_objects` even if the created
+   * objects are permanent. The successful `DISCARD ALL` cleans the state.
+   *
+   * @remarks The mutations which cannot be identified by the command tag (e.g.
+   * the effects of functions like `set_config()` or `pg_advisory_lock()`, or
+   * `CREATE TEMP TABLE AS`) are not tracked.
+   *
+   * @see reset_session_state().
+   */
+  DMITIGR_PGFE_API Session_state session_state() const noexcept;
+
+  /// @returns `session_state() != Session_state::clean`.
+  DMITIGR_PGFE_API bool is_session_state_dirty() const noexcept;
+
+  /**
+   * @brief Resets the specified aspects of the session state by the targeted
+   * commands and waits the results.
+   *
+   * @details The commands are: `ROLLBACK` for `Session_state::transaction`,
+   * `CLOSE ALL` for `Session_state::cursors`, `SET SESSION AUTHORIZATION
+   * DEFAULT` and `RESET ALL` for `Session_state::settings`, `UNLISTEN *` for
+   * `Session_state::listening`, `DISCARD TEMP` for
+   * `Session_state::temporary_objects` and `DEALLOCATE ALL` for
+   * `Session_state::prepared_statements`. (The latter invalidates all the
+   * instances of Prepared_statement.) The commands are sent within the single
+   * round trip if pipelining is available. Nothing is sent if
+   * `(state & session_state()) == Session_state::clean`. If the state of the
+   * connection becomes unknown because of an error of the communication, the
+   * connection is closed.
+   *
+   * @par Requires
+   * `is_ready_for_request()`.
+   *
+   * @par Effects
+   * `(session_state() & state) == Session_state::clean` on success.
+   *
+   * @par Exception safety guarantee
+   * Basic.
+   *
+   * @see session_state().
+   */
+  DMITIGR_PGFE_API void reset_session_state(Session_state state);
+
   ///@}
 
   // ---------------------------------------------------------------------------
@@ -316,7 +375,8 @@ public:
   DMITIGR_PGFE_API bool flush_output(bool wait = false);
 
   /**
-   * @returns `true` if the output has been flushed completely.
+   * @returns `true` if the output has been flushed completely upon the last
+   * call of flush_output().
    *
    * @see flush_output().
    */
@@ -402,6 +462,10 @@ public:
    *
    * @remarks All signals retrieved upon waiting the Response will be handled
    * by signals handlers being set.
+   * @remarks In pipeline mode, the rows of the current response which are not
+   * yet returned by row(), and then the Completion of the whole result
+   * released by row_batch() or result_set() are responded before the response
+   * to the next request.
    *
    * @see wait_response_throw().
    */
@@ -467,10 +531,43 @@ public:
    * @par Exception safety guarantee
    * Strong.
    *
-   * @see wait_response(), completion().
+   * @remarks If the response is a batch of rows, the next row of the batch is
+   * returned. Such a row refers to the data of the batch without copying.
+   *
+   * @see wait_response(), row_batch(), completion().
    */
   DMITIGR_PGFE_API Row row() noexcept;
 
+  /**
+   * @returns The Row_batch as response on request if available. If some rows
+   * of the batch are already returned by row(), the rest rows are returned.
+   *
+   * @par Effects
+   * `!row_batch() && !row()`.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   *
+   * @see wait_response(), set_row_batch_size(), row(), completion().
+   */
+  DMITIGR_PGFE_API Row_batch row_batch() noexcept;
+
+  /**
+   * @returns The Result_set as response on request executed with
+   * Result_retrieval::whole if available and if none of its rows are
+   * returned by row() or row_batch().
+   *
+   * @par Effects
+   * `!result_set() && !row()`. The completion() returns the Completion of
+   * the request afterwards.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   *
+   * @see wait_response(), set_result_retrieval(), completion().
+   */
+  DMITIGR_PGFE_API Result_set result_set() noexcept;
+
   /**
    * @returns The Copier as response on request if available.
    *
@@ -513,6 +610,9 @@ public:
    *   return an invalid instance of type Completion after the callback returns.
    *   In case of success, an invalid instance of type Error will be passed as the
    *   second argument of the callback;
+   *   - can be defined with a parameter of type `Row_batch&&` (and optionally
+   *   with the second parameter of type `Error&&`) to be called for each
+   *   retrieved batch of rows instead of each row;
    *   - can return a value of type Row_processing to indicate further behavior.
    *
    * @see execute(), invoke(), call(), Row_processing.
@@ -534,7 +634,7 @@ public:
           Client_exception process_responses_error{""};
           try {
             // std::function is used as the workaround for GCC 7.5
-            std::function<void(Row&&, Error&&)> f = [&err](auto&&, auto&& e)
+            std::function<void(Row_batch&&, Error&&)> f = [&err](auto&&, auto&& e)
             {
               if (e)
                 err = std::move(e);
@@ -565,14 +665,15 @@ public:
       }
     };
 
+    using Argument = typename Traits::Argument;
     Row_processing rowpro{Row_processing::continu};
     while (true) {
       if constexpr (Traits::has_error_parameter) {
         wait_response();
         if (auto e = error()) {
-          callback(Row{}, std::move(e));
+          callback(Argument{}, std::move(e));
           return Completion{};
-        } else if (auto r = row()) {
+        } else if (auto r = rows__<Argument>()) {
           with_complete_on_exception([this, &callback, &rowpro, &r]
           {
             if constexpr (!Traits::is_result_void)
@@ -584,7 +685,7 @@ public:
           return completion();
       } else {
         wait_response_throw();
-        if (auto r = row()) {
+        if (auto r = rows__<Argument>()) {
           with_complete_on_exception([this, &callback, &rowpro, &r]
           {
             if constexpr (!Traits::is_result_void)
@@ -672,6 +773,24 @@ public:
    */
   DMITIGR_PGFE_API bool has_uncompleted_request() const noexcept;
 
+  /**
+   * @returns The handle of the last submitted uncompleted request, which can
+   * be used to await or poll the responses to this request.
+   *
+   * @par Requires
+   * `has_uncompleted_request()`.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   *
+   * @remarks The handle can be obtained for requests submitted by any of the
+   * `*_nio()` methods (including send_sync()). Requests without handles
+   * don't imply any overhead.
+   *
+   * @see Request_handle.
+   */
+  DMITIGR_PGFE_API Request_handle last_request_handle();
+
   /**
    * @brief Submits a request to a server to prepare the statement.
    *
@@ -828,6 +947,8 @@ public:
    * Strong.
    *
    * @remarks See remarks of prepare().
+   * @remarks If auto-prepare is enabled the statement may be executed by using
+   * the named prepared statement. See set_auto_prepare_threshold().
    *
    * @see process_responses().
    */
@@ -838,7 +959,10 @@ public:
   {
     if (!is_ready_for_request())
       throw Client_exception{"cannot execute statement: not ready for request"};
-    execute_nio(statement, std::forward<Types>(parameters)...);
+    if (auto ps = auto_prepared__(statement))
+      ps.bind_many(std::forward<Types>(parameters)...).execute_nio();
+    else
+      execute_nio(statement, std::forward<Types>(parameters)...);
     return completion_or_throw(
       process_responses<on_exception>(std::forward<F>(callback)));
   }
@@ -851,6 +975,69 @@ public:
       std::forward<Types>(parameters)...);
   }
 
+  /**
+   * @brief Requests the server to prepare and execute the unnamed statement
+   * from the preparsed SQL string, and waits for the whole result.
+   *
+   * @param statement A *preparsed* statement to execute.
+   * @param parameters Parameters to bind with a parameterized statement.
+   *
+   * @returns The whole result, or invalid instance if the `statement` doesn't
+   * produce rows.
+   *
+   * @par Requires
+   * `is_ready_for_request() && !statement.has_missing_parameters()`.
+   *
+   * @par Exception safety guarantee
+   * Basic.
+   *
+   * @remarks This method is intended for the queries that produce a few rows.
+   *
+   * @see Result_retrieval.
+   */
+  template<typename ... Types>
+  Result_set execute_result_set(const Statement& statement, Types&& ... parameters)
+  {
+    if (!is_ready_for_request())
+      throw Client_exception{"cannot execute statement: not ready for request"};
+    Prepared_statement ps{execute_ps_state_, &statement, false};
+    ps.set_result_retrieval(Result_retrieval::whole);
+    ps.bind_many(std::forward<Types>(parameters)...).execute_nio(statement);
+    wait_response_throw();
+    auto result = result_set();
+    completion();
+    return result;
+  }
+
+  /**
+   * @brief Prepares the unnamed statement from the preparsed SQL string and
+   * executes it for each element of `range` in pipeline mode.
+   *
+   * @param statement A *preparsed* statement to execute.
+   * @param range A range of parameter tuples.
+   * @param sync_window The maximum number of elements between synchronization
+   * points.
+   *
+   * @returns The aggregated completion.
+   *
+   * @par Requires
+   * `is_ready_for_request() && sync_window > 0`.
+   *
+   * @par Exception safety guarantee
+   * Basic.
+   *
+   * @see Prepared_statement::execute_many().
+   */
+  template<class Range>
+  Bulk_completion execute_many(const Statement& statement, Range&& range,
+    const std::size_t sync_window = 256)
+  {
+    if (!is_ready_for_request())
+      throw Client_exception{"cannot execute statement: not ready for request"};
+    auto ps = prepare(statement);
+    return ps.execute_many(std::forward<Range>(range), sync_window);
+  }
+
   /**
    * @brief Requests the server to invoke the specified function and waits for
    * a response.
@@ -1073,6 +1260,223 @@ public:
   /// @returns The default data format of a statement execution result.
   DMITIGR_PGFE_API Data_format result_format() const noexcept;
 
+  /**
+   * @brief Sets the default data format of the statement parameters.
+   *
+   * @details If `format == Data_format::binary`, the parameters of the types
+   * whose Conversions support the binary format (numerics except `long double`,
+   * `bool` and `std::vector<std::byte>`) are sent to the server in binary
+   * format, thus skipping the text formatting on the client and the parsing on
+   * the server. The parameters of the other types are still sent in text
+   * format.
+   *
+   * @par Requires
+   * If `format == Data_format::binary` the type of each parameter sent in
+   * binary format must be exactly the one expected by the server. (For
+   * example, `int` must be bound to `integer`, `long long` - to `bigint`,
+   * `double` - to `double precision`.)
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   *
+   * @see Prepared_statement::set_parameter_format().
+   */
+  DMITIGR_PGFE_API void set_parameter_format(const Data_format format);
+
+  /// @returns The default data format of the statement parameters.
+  DMITIGR_PGFE_API Data_format parameter_format() const noexcept;
+
+  /**
+   * @brief Sets the default maximum number of rows in a batch of rows of
+   * statements execution results.
+   *
+   * @details If `size > 1` and the libpq in use supports the chunked rows mode
+   * (PostgreSQL 17+), the rows are retrieved from the server by batches of up
+   * to `size` rows. Otherwise, the rows are retrieved one by one (in the single
+   * row mode).
+   *
+   * @par Requires
+   * `size > 0 && size <= std::numeric_limits<int>::max()`.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   *
+   * @see row_batch(), Prepared_statement::set_row_batch_size().
+   */
+  DMITIGR_PGFE_API void set_row_batch_size(std::size_t size);
+
+  /// @returns The default maximum number of rows in a batch of rows.
+  DMITIGR_PGFE_API std::size_t row_batch_size() const noexcept;
+
+  /**
+   * @brief Sets the default result retrieval mode of statements execution.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   *
+   * @see result_set(), Prepared_statement::set_result_retrieval().
+   */
+  DMITIGR_PGFE_API void set_result_retrieval(Result_retrieval retrieval);
+
+  /// @returns The default result retrieval mode of statements execution.
+  DMITIGR_PGFE_API Result_retrieval result_retrieval() const noexcept;
+
+  /**
+   * @brief Sets the maximum number of rows produced by the previous execution
+   * of a prepared statement for which the whole result is retrieved in
+   * Result_retrieval::adaptive mode.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   */
+  DMITIGR_PGFE_API void set_adaptive_result_threshold(std::size_t row_count);
+
+  /// @returns The threshold of Result_retrieval::adaptive mode.
+  DMITIGR_PGFE_API std::size_t adaptive_result_threshold() const noexcept;
+
+  ///@}
+
+  // ---------------------------------------------------------------------------
+
+  /// @name Auto-prepare
+  /// @{
+
+  /**
+   * @brief Sets the number of executions of the same statement by execute()
+   * upon which the statement is prepared on the server and executed by using
+   * the named prepared statement thereafter.
+   *
+   * @details Statements are identified by their query strings. The statements
+   * prepared automatically are evicted from the cache in the least recently
+   * used order. The evicted statements are deallocated upon the next preparing
+   * within the same round trip if pipelining is available.
+   *
+   * @param count The number of executions, or `0` to disable auto-prepare.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   *
+   * @remarks Auto-prepare is disabled by default.
+   *
+   * @see set_auto_prepare_capacity().
+   */
+  DMITIGR_PGFE_API void set_auto_prepare_threshold(std::size_t count);
+
+  /// @returns The number of executions upon which statements are prepared.
+  DMITIGR_PGFE_API std::size_t auto_prepare_threshold() const noexcept;
+
+  /**
+   * @brief Sets the maximum number of statements tracked by the auto-prepare
+   * cache, including the ones not yet prepared.
+   *
+   * @par Requires
+   * `capacity > 0`.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   */
+  DMITIGR_PGFE_API void set_auto_prepare_capacity(std::size_t capacity);
+
+  /// @returns The capacity of the auto-prepare cache.
+  DMITIGR_PGFE_API std::size_t auto_prepare_capacity() const noexcept;
+
+  /// @returns The number of executions by using auto-prepared statements.
+  DMITIGR_PGFE_API std::size_t auto_prepare_hit_count() const noexcept;
+
+  /**
+   * @returns The number of executions of statements which were not prepared
+   * at that time while auto-prepare was enabled.
+   */
+  DMITIGR_PGFE_API std::size_t auto_prepare_miss_count() const noexcept;
+
+  ///@}
+
+  // ---------------------------------------------------------------------------
+
+  /// @name Prepared statements registry
+  /// @{
+
+  /**
+   * @brief Sets the maximum number of named prepared statements registered
+   * on the connection.
+   *
+   * @details When the limit is reached, the statements evicted from the
+   * auto-prepare cache and not referenced by any instance of Prepared_statement
+   * are reclaimed on the next preparing or describing in a blocking manner. The
+   * statements named by the user are never reclaimed implicitly. If the limit
+   * is still reached the request is rejected by throwing Client_exception. The
+   * unnamed statement, as well as preparing the statement with the name which
+   * is already registered, are not subject to the limit.
+   *
+   * @param count The maximum number of statements, or `0` for no limit.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   *
+   * @see reclaim_prepared_statements().
+   */
+  DMITIGR_PGFE_API void set_prepared_statement_count_limit(std::size_t count);
+
+  /// @returns The maximum number of registered prepared statements.
+  DMITIGR_PGFE_API std::size_t prepared_statement_count_limit() const noexcept;
+
+  /**
+   * @brief Sets the maximum number of bytes allocated for descriptions of
+   * the prepared statements registered on the connection.
+   *
+   * @details The limit is treated the same way as the one set by
+   * set_prepared_statement_count_limit().
+   *
+   * @param size The maximum number of bytes, or `0` for no limit.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   */
+  DMITIGR_PGFE_API void set_prepared_statement_memory_limit(std::size_t size);
+
+  /// @returns The maximum size of descriptions of prepared statements.
+  DMITIGR_PGFE_API std::size_t prepared_statement_memory_limit() const noexcept;
+
+  /**
+   * @returns The number of prepared statements registered on the connection,
+   * including the ones not referenced by any instance of Prepared_statement.
+   */
+  DMITIGR_PGFE_API std::size_t prepared_statement_count() const noexcept;
+
+  /**
+   * @returns The named prepared statement registered on the connection, or
+   * invalid instance if there is no such a statement.
+   *
+   * @param name A name of prepared statement.
+   * @param statement A statement the prepared statement is prepared from. (It's
+   * used to bind the named parameters.)
+   *
+   * @par Requires
+   * `!name.empty()`.
+   */
+  DMITIGR_PGFE_API Prepared_statement
+  registered_prepared_statement(std::string_view name, const Statement& statement);
+
+  /// @returns The number of bytes allocated for descriptions of statements.
+  DMITIGR_PGFE_API std::size_t prepared_statement_memory_size() const noexcept;
+
+  /**
+   * @brief Deallocates the named prepared statements not referenced by any
+   * instance of Prepared_statement.
+   *
+   * @details Unlike the reclamation upon reaching the limits, the statements
+   * named by the user (including the ones prepared by Connection_pool from its
+   * catalog) are deallocated as well. The statements are deallocated within
+   * the single round trip if pipelining is available.
+   *
+   * @par Requires
+   * `is_ready_for_request()`.
+   *
+   * @par Exception safety guarantee
+   * Basic.
+   */
+  DMITIGR_PGFE_API void reclaim_prepared_statements();
+
   ///@}
 
   // ---------------------------------------------------------------------------
@@ -1232,9 +1636,14 @@ public:
 
   ///@}
 private:
+  friend Async_connection;
+  friend Async_scheduler;
+  friend Connection_pool;
+  friend Connection_reactor;
   friend Copier;
   friend Large_object;
   friend Prepared_statement;
+  friend Request_handle;
 
   // ---------------------------------------------------------------------------
   // Persistent data
@@ -1248,6 +1657,16 @@ private:
   Notice_handler notice_handler_{&default_notice_handler};
   Notification_handler notification_handler_;
   Data_format default_result_format_{Data_format::text};
+  Data_format default_parameter_format_{Data_format::text};
+  std::size_t default_row_batch_size_{1};
+  Result_retrieval default_result_retrieval_{Result_retrieval::streaming};
+  std::size_t adaptive_result_threshold_{64};
+  std::size_t auto_prepare_threshold_{};
+  std::size_t auto_prepare_capacity_{64};
+  std::size_t auto_prepare_hit_count_{};
+  std::size_t auto_prepare_miss_count_{};
+  std::size_t ps_count_limit_{};
+  std::size_t ps_memory_limit_{};
 
   // Persistent data / private-modifiable data
   std::shared_ptr<Prepared_statement::State> execute_ps_state_;
@@ -1286,9 +1705,14 @@ private:
     Id id_{};
     Prepared_statement prepared_statement_;
     std::optional<std::string> prepared_statement_name_;
+    std::size_t row_batch_size_{1};
+    bool is_whole_result_{};
+    std::weak_ptr<Prepared_statement::State> adaptive_ps_state_;
+    std::shared_ptr<Request_handle::State> handle_state_;
   };
 
   std::optional<std::chrono::system_clock::time_point> session_start_time_;
+  Session_state session_state_{}; // tracked by command tags
 
   detail::pq::Result response_; // synchronized with response_status_ ...
   Response_status response_status_{}; // ... by handle_input()
@@ -1296,12 +1720,32 @@ private:
   bool is_output_flushed_{true};
   std::shared_ptr<Connection*> copier_state_;
   bool is_single_row_mode_enabled_{};
+  std::shared_ptr<Row_info> row_batch_info_; // shared by Row and Row_batch
+  int row_batch_offset_{}; // the number of rows of row_batch_info_ returned
+  Completion whole_result_completion_; // set when the whole result is released
 
-  std::list<std::shared_ptr<Prepared_statement::State>> ps_states_;
+  std::unordered_map<std::string_view, // State::id_
+    std::shared_ptr<Prepared_statement::State>> ps_states_;
+  std::size_t ps_memory_size_{}; // of the descriptions of ps_states_
   std::list<std::shared_ptr<Large_object::State>> lo_states_;
 
-  std::queue<Request> requests_;
+  util::Ring_queue<Request> requests_;
   Request last_processed_request_;
+  std::shared_ptr<Connection*> handle_connection_; // shared by Request_handle
+
+  /// An entry of the auto-prepare cache.
+  struct Auto_prepared final {
+    std::string query_;
+    std::size_t execution_count_{};
+    std::shared_ptr<Prepared_statement::State> state_; // set when prepared
+  };
+  std::list<Auto_prepared> auto_prepared_; // most recently used first
+  std::unordered_map<std::string_view,
+    decltype(auto_prepared_)::iterator> auto_prepared_index_;
+  std::uint_fast64_t auto_prepared_id_{};
+  std::vector<std::string> auto_prepared_evicted_; // deallocated on promotion
+  std::size_t auto_prepared_count_{}; // of ps_states_
+  static constexpr std::string_view auto_prepared_prefix_{"dmitigr_pgfe_auto_"};
 
   bool is_invariant_ok() const noexcept;
 
@@ -1336,10 +1780,19 @@ private:
   }
 
   detail::pq::Result release_response() noexcept;
+  detail::pq::Result release_rows_response() noexcept;
+  bool is_whole_result_response() const noexcept;
+  bool is_rows_response() const noexcept;
+  bool has_row_batch() const noexcept;
+  void reserve_row_batch_info();
+  void share_rows_response() noexcept;
+  void release_row_batch() noexcept;
+  void route_response__(bool is_dismissing = false);
   void reset_response(detail::pq::Result&& response) noexcept;
   void reset_session() noexcept;
+  void track_session_state__(const char* command_tag) noexcept;
   void reset_copier_state() noexcept;
-  void set_single_row_mode_enabled() noexcept;
+  void set_single_row_mode_enabled(std::size_t row_batch_size = 1) noexcept;
 
   // ---------------------------------------------------------------------------
   // Handlers
@@ -1352,9 +1805,18 @@ private:
   // Prepared statement helpers
   // ---------------------------------------------------------------------------
 
-  static constexpr void ignore_row(Row&&) noexcept
+  static constexpr void ignore_row(Row_batch&&) noexcept
   {}
 
+  template<class R>
+  R rows__()
+  {
+    if constexpr (std::is_same_v<R, Row>)
+      return row();
+    else
+      return row_batch();
+  }
+
   void prepare_nio__(const char* const query, const char* const name,
     const Statement* const preparsed);
 
@@ -1363,6 +1825,8 @@ private:
   {
     if (!is_ready_for_request())
       throw Client_exception{"cannot prepare statement: not ready for request"};
+    if (is_ps_limit_reached())
+      reclaim_ps__();
     (this->*prepare)(std::forward<T>(statement), name);
     auto result = wait_prepared_statement__();
     DMITIGR_ASSERT(result);
@@ -1373,11 +1837,19 @@ private:
 
   auto registered_ps(const std::string_view name) const noexcept
   {
-    return registered(ps_states_, name);
+    return std::make_pair(ps_states_.find(name), cend(ps_states_));
   }
+  bool is_ps_limit_reached(std::size_t reclaimed_count = 0,
+    std::size_t reclaimed_size = 0) const noexcept;
+  void account_ps(Prepared_statement::State& state) noexcept;
   void register_ps(Prepared_statement&& ps);
   void unregister_ps(std::string_view name) noexcept;
   void unregister_ps(decltype(ps_states_)::const_iterator p) noexcept;
+  std::shared_ptr<Prepared_statement::State>
+  reclaim_ps__(const char* name = {}, const char* query = {},
+    bool is_user_named_included = false);
+  static bool is_auto_prepared_name(std::string_view name) noexcept;
+  Prepared_statement auto_prepared__(const Statement& statement);
 
   // ---------------------------------------------------------------------------
   // Utilities helpers
@@ -1497,6 +1969,46 @@ Prepared_statement::execute(F&& callback, Types&& ... parameters)
     connection().process_responses<on_exception>(std::forward<F>(callback)));
 }
 
+template<class Range>
+Bulk_completion
+Prepared_statement::execute_many(Range&& range, const std::size_t sync_window)
+{
+  if (!is_valid() || !connection().is_ready_for_request())
+    throw_exception("cannot bulk execute");
+  else if (!sync_window)
+    throw Client_exception{"cannot bulk execute prepared statement: "
+      "invalid sync window specified"};
+
+  auto& conn = connection();
+  conn.set_pipeline_enabled(true);
+  Bulk_completion result;
+  try {
+    std::size_t count{};
+    for (auto&& element : range) {
+      bind_element__(std::forward<decltype(element)>(element)).execute_nio();
+      if (!(++count % sync_window)) {
+        conn.send_sync();
+        if (count > sync_window)
+          process_many__(&result, 1); // the previous window
+      }
+    }
+    process_many__(&result);
+    conn.set_pipeline_enabled(false);
+  } catch (...) {
+    // Attempt to restore the state of the connection.
+    try {
+      if (conn.pipeline_status() != Pipeline_status::disabled) {
+        process_many__(nullptr);
+        conn.set_pipeline_enabled(false);
+      }
+    } catch (...) {}
+    throw;
+  }
+
+  assert(is_invariant_ok());
+  return result;
+}
+
 /**
  * @ingroup main
  *
@@ -1513,6 +2025,7 @@ inline void swap(Connection& lhs, Connection& rhs) noexcept
 #include "connection.cpp"
 #include "large_object.cpp"
 #include "prepared_statement.cpp"
+#include "request_handle.cpp"
 #endif
 
 #endif  // DMITIGR_PGFE_CONNECTION_HPP
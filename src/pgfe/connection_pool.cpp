@@ -16,6 +16,7 @@
 
 #include "../base/assert.hpp"
 #include "connection_pool.hpp"
+#include "connection_reactor.hpp"
 
 #include <algorithm>
 #include <cassert>
@@ -72,6 +73,62 @@ DMITIGR_PGFE_INLINE Connection_pool* Connection_pool::Handle::pool() noexcept
   return const_cast<Connection_pool*>(static_cast<const Handle*>(this)->pool());
 }
 
+DMITIGR_PGFE_INLINE Prepared_statement
+Connection_pool::Handle::prepared_statement(const std::string& name)
+{
+  auto* const p = pool();
+  if (!is_valid() || !p)
+    throw Client_exception{"cannot get prepared statement of invalid "
+      "connection pool handle"};
+
+  std::shared_ptr<const Statement> statement;
+  bool is_prepared{};
+  Catalog stale; // the replaced or removed entries to deallocate
+  {
+    const std::lock_guard lg{p->mutex_};
+    if (const auto i = p->catalog_.find(name); i != p->catalog_.cend())
+      statement = i->second;
+
+    auto& state = p->states_[state_index_];
+    if (state.catalog_version_ != p->catalog_version_) {
+      for (auto i = state.prepared_.begin(); i != state.prepared_.end();) {
+        const auto e = p->catalog_.find(i->first);
+        if (e == p->catalog_.cend() || e->second != i->second) {
+          stale.insert(std::move(*i));
+          i = state.prepared_.erase(i);
+        } else
+          ++i;
+      }
+      state.catalog_version_ = p->catalog_version_;
+    }
+    if (statement) {
+      const auto i = state.prepared_.find(name);
+      is_prepared = i != state.prepared_.cend() && i->second == statement;
+    }
+  }
+
+  for (const auto& [nm, st] : stale) {
+    if (connection_->registered_prepared_statement(nm, *st))
+      connection_->unprepare(nm);
+  }
+
+  if (!statement)
+    throw Client_exception{"cannot get prepared statement \"" + name +
+      "\" which is not in the catalog of connection pool"};
+
+  if (auto result = connection_->registered_prepared_statement(name, *statement)) {
+    if (is_prepared)
+      return result;
+    connection_->unprepare(name); // prepared not from the catalog
+  }
+  auto result = connection_->prepare(*statement, name);
+  {
+    const std::lock_guard lg{p->mutex_};
+    p->states_[state_index_].prepared_.insert_or_assign(name, statement);
+  }
+  return result;
+}
+
 DMITIGR_PGFE_INLINE void Connection_pool::Handle::release() noexcept
 {
   if (auto* const p = pool())
@@ -98,23 +155,44 @@ DMITIGR_PGFE_INLINE Connection_pool::Handle::Handle(
 
 DMITIGR_PGFE_INLINE Connection_pool::~Connection_pool() noexcept
 {
+  stop_maintainer__();
   for (auto& state : states_) {
-    DMITIGR_ASSERT(state.second);
-    *state.second = nullptr;
+    DMITIGR_ASSERT(state.self_);
+    *state.self_ = nullptr;
   }
 }
 
-DMITIGR_PGFE_INLINE Connection_pool::Connection_pool(std::size_t count,
+DMITIGR_PGFE_INLINE Connection_pool::Connection_pool(const std::size_t count,
   const Connection_options& options)
-  : release_handler_{[](Connection& conn)
+  : Connection_pool{count, count, options}
+{}
+
+DMITIGR_PGFE_INLINE Connection_pool::Connection_pool(const std::size_t min_count,
+  const std::size_t max_count, const Connection_options& options)
+  : min_count_{min_count}
+  , release_handler_{[this](Connection& conn)
   {
+    // Attention! mutex_ is locked here!
     conn.process_responses([](auto&&){});
-    conn.execute("DISCARD ALL");
+    auto state = conn.session_state();
+    if (!catalog_.empty())
+      state &= ~Session_state::prepared_statements; // keep the catalog
+    conn.reset_session_state(state);
   }}
 {
+  if (!(min_count <= max_count))
+    throw Client_exception{"cannot create connection pool: "
+      "minimum size is greater than maximum size"};
+
   const auto self = std::make_shared<Connection_pool*>(this);
-  for (; count > 0; --count)
-    states_.emplace_back(std::make_unique<Connection>(options), self);
+  states_.reserve(max_count);
+  free_.reserve(max_count); // free__() doesn't allocate
+  closed_.reserve(max_count);
+  for (std::size_t i{}; i < max_count; ++i) {
+    states_.push_back(State{std::make_unique<Connection>(options), self,
+      {}, {}, {}});
+    closed_.push_back(max_count - 1 - i); // the first state is at the back
+  }
 }
 
 DMITIGR_PGFE_INLINE bool Connection_pool::is_valid() const noexcept
@@ -148,36 +226,363 @@ Connection_pool::release_handler() const noexcept
   return release_handler_;
 }
 
-DMITIGR_PGFE_INLINE void Connection_pool::connect()
+DMITIGR_PGFE_INLINE void
+Connection_pool::set_idle_timeout(const std::optional<std::chrono::milliseconds> timeout)
+{
+  if (!(!timeout || timeout->count() >= 0))
+    throw Client_exception{"cannot set connection pool idle timeout: "
+      "invalid timeout specified"};
+
+  const std::lock_guard lg{mutex_};
+  idle_timeout_ = timeout;
+}
+
+DMITIGR_PGFE_INLINE std::optional<std::chrono::milliseconds>
+Connection_pool::idle_timeout() const noexcept
+{
+  const std::lock_guard lg{mutex_};
+  return idle_timeout_;
+}
+
+DMITIGR_PGFE_INLINE void
+Connection_pool::set_validation_batch_size(const std::size_t size)
+{
+  if (!size)
+    throw Client_exception{"cannot set connection pool validation batch size: "
+      "invalid size specified"};
+
+  const std::lock_guard lg{mutex_};
+  validation_batch_size_ = size;
+}
+
+DMITIGR_PGFE_INLINE std::size_t
+Connection_pool::validation_batch_size() const noexcept
 {
   const std::lock_guard lg{mutex_};
+  return validation_batch_size_;
+}
+
+DMITIGR_PGFE_INLINE void Connection_pool::set_validation_idle_threshold(
+  const std::chrono::milliseconds threshold)
+{
+  if (!(threshold.count() >= 0))
+    throw Client_exception{"cannot set connection pool validation idle "
+      "threshold: invalid threshold specified"};
+
+  const std::lock_guard lg{mutex_};
+  validation_idle_threshold_ = threshold;
+}
+
+DMITIGR_PGFE_INLINE std::chrono::milliseconds
+Connection_pool::validation_idle_threshold() const noexcept
+{
+  const std::lock_guard lg{mutex_};
+  return validation_idle_threshold_;
+}
 
+DMITIGR_PGFE_INLINE void Connection_pool::set_maintenance_interval(
+  const std::optional<std::chrono::milliseconds> interval)
+{
+  if (!(!interval || interval->count() > 0))
+    throw Client_exception{"cannot set connection pool maintenance interval: "
+      "invalid interval specified"};
+
+  stop_maintainer__();
+  const std::lock_guard lg{mutex_};
+  maintenance_interval_ = interval;
   if (is_connected_)
-    return;
+    start_maintainer__();
+}
+
+DMITIGR_PGFE_INLINE std::optional<std::chrono::milliseconds>
+Connection_pool::maintenance_interval() const noexcept
+{
+  const std::lock_guard lg{mutex_};
+  return maintenance_interval_;
+}
+
+DMITIGR_PGFE_INLINE void Connection_pool::maintain()
+{
+  std::vector<std::pair<std::size_t, std::unique_ptr<Connection>>> taken;
+  std::vector<std::size_t> validated; // indexes of free_ to validate
+  std::size_t batch_size{};
+  std::function<void(Connection&)> connect_handler;
+  Catalog catalog;
+  std::uint_fast64_t catalog_version{};
+  {
+    const std::lock_guard lg{mutex_};
+
+    if (!is_connected_)
+      return;
+
+    const auto open_count = [this]
+    {
+      return states_.size() - closed_.size();
+    };
+
+    // Close the connections idle for too long.
+    const auto now = Clock::now();
+    if (idle_timeout_) {
+      for (auto i = free_.begin(); i != free_.end() && open_count() > min_count_;) {
+        auto& state = states_[*i];
+        if (now - state.idle_since_ >= *idle_timeout_) {
+          state.connection_->disconnect();
+          closed_.push_back(*i);
+          i = free_.erase(i);
+          ++idle_close_count_;
+        } else
+          ++i;
+      }
+    }
+
+    // Select the free connections to validate.
+    for (const auto index : free_) {
+      if (now - states_[index].idle_since_ >= validation_idle_threshold_)
+        validated.push_back(index);
+    }
+    batch_size = validation_batch_size_;
+
+    // Take the closed connections to open.
+    taken.reserve(std::max(min_count_, batch_size));
+    while (open_count() < min_count_ && !closed_.empty()) {
+      const auto index = closed_.back();
+      closed_.pop_back();
+      taken.emplace_back(index, std::move(states_[index].connection_));
+    }
+    connect_handler = connect_handler_;
+    catalog = catalog_;
+    catalog_version = catalog_version_;
+  }
+
+  const auto give_back = [this, &taken, &catalog, catalog_version](
+    const std::size_t broken_count, const bool is_opened)
+  {
+    const std::lock_guard lg{mutex_};
+    broken_count_ += broken_count;
+    const auto now = Clock::now();
+    for (auto& [index, conn] : taken) {
+      if (!is_connected_)
+        conn->disconnect();
+      auto& state = states_[index];
+      state.connection_ = std::move(conn);
+      if (is_opened) {
+        state.idle_since_ = now; // the validated ones keep their idle time
+        state.prepared_ = catalog;
+        state.catalog_version_ = catalog_version;
+      }
+      free__(index);
+    }
+    taken.clear();
+  };
+
+  const auto log_error = []
+  {
+    try {
+      throw;
+    } catch (const std::exception& e) {
+      std::clog << "connection pool's maintenance: error: " << e.what() << '\n';
+    } catch (...) {
+      std::clog << "connection pool's maintenance: unknown error\n";
+    }
+  };
+
+  // Open the connections.
+  for (auto& [index, conn] : taken) {
+    try {
+      conn->connect();
+      if (connect_handler)
+        connect_handler(*conn);
+      prepare_catalog__(*conn, catalog);
+    } catch (...) {
+      log_error();
+    }
+    if (!conn->is_ready_for_request())
+      conn->disconnect();
+  }
+  give_back(0, true);
+
+  // Validate the free connections by batches.
+  for (auto v = validated.cbegin(); v != validated.cend();) {
+    {
+      const std::lock_guard lg{mutex_};
+      if (!is_connected_)
+        return;
+
+      while (v != validated.cend() && taken.size() < batch_size) {
+        // Skip the connections acquired meanwhile.
+        const auto index = *v++;
+        if (const auto i = std::find(free_.begin(), free_.end(), index);
+            i != free_.end()) {
+          free_.erase(i);
+          taken.emplace_back(index, std::move(states_[index].connection_));
+        }
+      }
+    }
+
+    // Send all the requests at first in order to overlap the round trips.
+    for (auto& [index, conn] : taken) {
+      try {
+        conn->execute_nio("SELECT 1");
+      } catch (...) {
+        log_error();
+      }
+    }
+    std::size_t broken_count{};
+    for (auto& [index, conn] : taken) {
+      try {
+        if (conn->has_uncompleted_request())
+          conn->process_responses([](auto&&){});
+      } catch (...) {
+        log_error();
+      }
+      if (!conn->is_ready_for_request()) {
+        conn->disconnect();
+        ++broken_count;
+      }
+    }
+    give_back(broken_count, false);
+  }
+}
+
+DMITIGR_PGFE_INLINE void
+Connection_pool::add_prepared_statement(std::string name, Statement statement)
+{
+  if (name.empty())
+    throw Client_exception{"cannot add prepared statement to connection pool: "
+      "empty name specified"};
+  else if (statement.has_missing_parameters())
+    throw Client_exception{"cannot add prepared statement to connection pool: "
+      "statement has missing parameters"};
+
+  auto st = std::make_shared<const Statement>(std::move(statement));
+  const std::lock_guard lg{mutex_};
+  catalog_.insert_or_assign(std::move(name), std::move(st));
+  ++catalog_version_;
+}
 
-  for (const auto& state : states_) {
-    auto& conn = state.first;
-    conn->connect();
-    if (connect_handler_)
-      connect_handler_(*conn);
+DMITIGR_PGFE_INLINE void
+Connection_pool::remove_prepared_statement(const std::string& name)
+{
+  const std::lock_guard lg{mutex_};
+  if (catalog_.erase(name))
+    ++catalog_version_;
+}
+
+DMITIGR_PGFE_INLINE std::size_t
+Connection_pool::prepared_statement_count() const noexcept
+{
+  const std::lock_guard lg{mutex_};
+  return catalog_.size();
+}
+
+DMITIGR_PGFE_INLINE void Connection_pool::connect()
+{
+  /*
+   * The connections to open are taken from the pool, so they are unavailable
+   * for acquisition meanwhile, and opened without locking the pool.
+   */
+  const std::lock_guard clg{connect_mutex_};
+  std::vector<std::pair<std::size_t, std::unique_ptr<Connection>>> opened;
+  std::function<void(Connection&)> connect_handler;
+  Catalog catalog;
+  std::uint_fast64_t catalog_version{};
+  {
+    const std::lock_guard lg{mutex_};
+
+    if (is_connected_)
+      return;
+
+    opened.reserve(min_count_);
+    while (states_.size() - closed_.size() < min_count_ && !closed_.empty()) {
+      const auto index = closed_.back();
+      closed_.pop_back();
+      opened.emplace_back(index, std::move(states_[index].connection_));
+    }
+    connect_handler = connect_handler_;
+    catalog = catalog_;
+    catalog_version = catalog_version_;
+  }
+
+  // Drive the establishment of the connections concurrently.
+  const Connection* failed{};
+  std::error_code failed_errc;
+  try {
+    Connection_reactor reactor;
+    for (auto& [index, conn] : opened) {
+      reactor.add_connection(*conn,
+        [&failed, &failed_errc](Connection& conn, const std::error_code errc)
+        {
+          if (errc && !failed) {
+            failed = &conn;
+            failed_errc = errc;
+          }
+        });
+    }
+    reactor.run();
+
+    if (failed) {
+      if (failed_errc == Client_errc::timed_out)
+        throw Client_exception{Client_errc::timed_out, "connection timeout"};
+      else
+        throw Client_exception{failed->error_message()};
+    }
+
+    for (auto& [index, conn] : opened) {
+      if (connect_handler)
+        connect_handler(*conn);
+      prepare_catalog__(*conn, catalog);
+    }
+  } catch (...) {
+    const std::lock_guard lg{mutex_};
+    for (auto& [index, conn] : opened) {
+      conn->disconnect();
+      states_[index].connection_ = std::move(conn);
+      closed_.push_back(index);
+    }
+    throw;
+  }
+
+  const std::lock_guard lg{mutex_};
+  const auto now = Clock::now();
+  for (auto& [index, conn] : opened) {
+    auto& state = states_[index];
+    state.connection_ = std::move(conn);
+    state.idle_since_ = now;
+    state.prepared_ = catalog;
+    state.catalog_version_ = catalog_version;
+    free_.push_back(index);
   }
 
   is_connected_ = is_valid();
+  if (is_connected_)
+    start_maintainer__();
 }
 
 DMITIGR_PGFE_INLINE void Connection_pool::disconnect() noexcept
 {
+  const std::lock_guard clg{connect_mutex_};
+  stop_maintainer__();
+
   const std::lock_guard lg{mutex_};
 
   if (!is_connected_)
     return;
 
-  for (const auto& state : states_) {
-    if (auto& conn = state.first)
-      conn->disconnect();
+  for (const auto index : free_) {
+    states_[index].connection_->disconnect();
+    closed_.push_back(index);
+  }
+  free_.clear();
+
+  for (auto* const waiter : waiters_) {
+    waiter->is_cancelled_ = true;
+    waiter->cv_.notify_one();
   }
+  waiters_.clear();
 
   is_connected_ = false;
+  if (free_handler_)
+    free_handler_();
 }
 
 DMITIGR_PGFE_INLINE bool Connection_pool::is_connected() const noexcept
@@ -188,26 +593,85 @@ DMITIGR_PGFE_INLINE bool Connection_pool::is_connected() const noexcept
 
 DMITIGR_PGFE_INLINE auto Connection_pool::connection() -> Handle
 {
-  const std::lock_guard lg{mutex_};
+  Handle result;
+  {
+    const std::lock_guard lg{mutex_};
 
-  if (!is_connected_)
+    if (!is_connected_)
+      throw Client_exception{"cannot obtain connection from disconnected "
+        "connection pool"};
+
+    if (const auto index = pop_free__())
+      result = acquire__(*index);
+    else
+      return result;
+  }
+  connect__(result);
+  return result;
+}
+
+DMITIGR_PGFE_INLINE auto
+Connection_pool::connection(const std::optional<std::chrono::milliseconds> timeout)
+  -> Handle
+{
+  using std::chrono::milliseconds;
+
+  if (!(!timeout || timeout >= milliseconds::zero()))
+    throw Client_exception{"cannot obtain connection from connection pool: "
+      "invalid timeout specified"};
+
+  std::unique_lock lk{mutex_};
+
+  static const auto throw_disconnected = []
+  {
     throw Client_exception{"cannot obtain connection from disconnected "
       "connection pool"};
+  };
+
+  if (!is_connected_)
+    throw_disconnected();
+
+  const auto acquire_and_connect = [this, &lk](const std::size_t index)
+  {
+    auto result = acquire__(index);
+    lk.unlock();
+    connect__(result);
+    return result;
+  };
+
+  if (const auto index = pop_free__()) {
+    DMITIGR_ASSERT(waiters_.empty());
+    return acquire_and_connect(*index);
+  }
 
-  const auto b = begin(states_);
-  const auto e = end(states_);
-  const auto i = find_if(b, e, [](const auto& pair)
+  Waiter waiter;
+  waiters_.push_back(&waiter);
+  const auto is_woken = [&waiter]
   {
-    return static_cast<bool>(pair.first);
-  });
-  if (i != e) {
-    auto& conn = i->first;
-    auto& self = i->second;
-    conn->connect();
-    DMITIGR_ASSERT(conn->is_ready_for_request());
-    return {self, std::move(conn), static_cast<std::size_t>(i - b)};
-  } else
-    return {};
+    return waiter.state_index_ || waiter.is_cancelled_;
+  };
+  const auto started = Clock::now();
+  if (timeout)
+    waiter.cv_.wait_until(lk, started + *timeout, is_woken);
+  else
+    waiter.cv_.wait(lk, is_woken);
+
+  const auto waited = Clock::now() - started;
+  ++wait_count_;
+  wait_time_ += waited;
+  max_wait_time_ = std::max<std::chrono::nanoseconds>(max_wait_time_, waited);
+
+  if (waiter.state_index_)
+    return acquire_and_connect(*waiter.state_index_);
+  else if (waiter.is_cancelled_)
+    throw_disconnected();
+
+  const auto i = std::find(waiters_.begin(), waiters_.end(), &waiter);
+  DMITIGR_ASSERT(i != waiters_.end());
+  waiters_.erase(i);
+  ++wait_timeout_count_;
+  throw Client_exception{Client_errc::timed_out,
+    "cannot obtain connection from connection pool: timeout expired"};
 }
 
 DMITIGR_PGFE_INLINE void Connection_pool::release(Handle& handle) noexcept
@@ -242,10 +706,13 @@ DMITIGR_PGFE_INLINE void Connection_pool::release(Handle& handle) noexcept
   if (!conn.is_ready_for_request() || !is_connected_)
     conn.disconnect();
 
-  states_[index].first = std::move(handle.connection_);
+  auto& state = states_[index];
+  state.connection_ = std::move(handle.connection_);
+  state.idle_since_ = Clock::now();
   handle.connection_ = {};
   handle.state_index_ = {};
   DMITIGR_ASSERT(!handle.is_valid());
+  free__(index);
 }
 
 DMITIGR_PGFE_INLINE std::size_t Connection_pool::size() const noexcept
@@ -254,4 +721,236 @@ DMITIGR_PGFE_INLINE std::size_t Connection_pool::size() const noexcept
   return states_.size();
 }
 
+DMITIGR_PGFE_INLINE std::size_t Connection_pool::min_size() const noexcept
+{
+  const std::lock_guard lg{mutex_};
+  return min_count_;
+}
+
+DMITIGR_PGFE_INLINE std::size_t Connection_pool::open_count() const noexcept
+{
+  const std::lock_guard lg{mutex_};
+  return states_.size() - closed_.size();
+}
+
+DMITIGR_PGFE_INLINE std::size_t Connection_pool::free_count() const noexcept
+{
+  const std::lock_guard lg{mutex_};
+  return free_.size();
+}
+
+DMITIGR_PGFE_INLINE std::size_t Connection_pool::idle_close_count() const noexcept
+{
+  const std::lock_guard lg{mutex_};
+  return idle_close_count_;
+}
+
+DMITIGR_PGFE_INLINE std::size_t Connection_pool::broken_count() const noexcept
+{
+  const std::lock_guard lg{mutex_};
+  return broken_count_;
+}
+
+DMITIGR_PGFE_INLINE std::size_t Connection_pool::wait_queue_size() const noexcept
+{
+  const std::lock_guard lg{mutex_};
+  return waiters_.size();
+}
+
+DMITIGR_PGFE_INLINE std::size_t Connection_pool::wait_count() const noexcept
+{
+  const std::lock_guard lg{mutex_};
+  return wait_count_;
+}
+
+DMITIGR_PGFE_INLINE std::size_t Connection_pool::wait_timeout_count() const noexcept
+{
+  const std::lock_guard lg{mutex_};
+  return wait_timeout_count_;
+}
+
+DMITIGR_PGFE_INLINE std::chrono::nanoseconds
+Connection_pool::wait_time() const noexcept
+{
+  const std::lock_guard lg{mutex_};
+  return wait_time_;
+}
+
+DMITIGR_PGFE_INLINE std::chrono::nanoseconds
+Connection_pool::max_wait_time() const noexcept
+{
+  const std::lock_guard lg{mutex_};
+  return max_wait_time_;
+}
+
+DMITIGR_PGFE_INLINE std::optional<std::size_t>
+Connection_pool::pop_free__() noexcept
+{
+  // Attention! mutex_ must be locked here!
+  std::optional<std::size_t> result;
+  if (!free_.empty()) {
+    result = free_.back();
+    free_.pop_back();
+  } else if (!closed_.empty()) {
+    // Grow on demand. (The connection is opened by connect__().)
+    result = closed_.back();
+    closed_.pop_back();
+  }
+  return result;
+}
+
+DMITIGR_PGFE_INLINE auto Connection_pool::acquire__(const std::size_t index)
+  -> Handle
+{
+  // Attention! mutex_ must be locked here!
+  DMITIGR_ASSERT(index < states_.size());
+  auto& state = states_[index];
+  DMITIGR_ASSERT(state.connection_);
+  return {state.self_, std::move(state.connection_), index};
+}
+
+DMITIGR_PGFE_INLINE void Connection_pool::connect__(Handle& handle)
+{
+  // Attention! mutex_ must not be locked here!
+  DMITIGR_ASSERT(handle);
+  if (handle->is_connected())
+    return;
+
+  /*
+   * The connection possibly closed upon of calling release() is reopened
+   * without locking the pool. On failure the handle returns the connection
+   * back to the pool.
+   */
+  handle->connect();
+  std::function<void(Connection&)> handler;
+  Catalog catalog;
+  std::uint_fast64_t catalog_version{};
+  {
+    const std::lock_guard lg{mutex_};
+    handler = connect_handler_;
+    catalog = catalog_;
+    catalog_version = catalog_version_;
+  }
+  if (handler)
+    handler(*handle);
+  prepare_catalog__(*handle, catalog);
+  DMITIGR_ASSERT(handle->is_ready_for_request());
+  {
+    const std::lock_guard lg{mutex_};
+    auto& state = states_[handle.state_index_];
+    state.prepared_ = std::move(catalog);
+    state.catalog_version_ = catalog_version;
+  }
+}
+
+DMITIGR_PGFE_INLINE void Connection_pool::free__(const std::size_t index) noexcept
+{
+  // Attention! mutex_ must be locked here!
+  DMITIGR_ASSERT(index < states_.size() && states_[index].connection_);
+  if (!waiters_.empty()) {
+    auto* const waiter = waiters_.front();
+    waiters_.pop_front();
+    waiter->state_index_ = index;
+    waiter->cv_.notify_one();
+  } else {
+    if (states_[index].connection_->is_connected())
+      free_.push_back(index);
+    else
+      closed_.push_back(index);
+    if (free_handler_)
+      free_handler_();
+  }
+}
+
+DMITIGR_PGFE_INLINE void Connection_pool::start_maintainer__()
+{
+  // Attention! mutex_ must be locked here!
+  if (maintenance_interval_ && !maintainer_.joinable()) {
+    is_maintainer_stopping_ = false;
+    maintainer_ = std::thread{&Connection_pool::maintainer_loop__, this};
+  }
+}
+
+DMITIGR_PGFE_INLINE void Connection_pool::stop_maintainer__() noexcept
+{
+  // Attention! mutex_ must not be locked here!
+  {
+    const std::lock_guard lg{mutex_};
+    if (!maintainer_.joinable())
+      return;
+    is_maintainer_stopping_ = true;
+  }
+  maintainer_cv_.notify_one();
+  try {
+    maintainer_.join();
+  } catch (const std::exception& e) {
+    std::clog << "connection pool's maintenance: error: " << e.what() << '\n';
+    maintainer_.detach();
+  }
+}
+
+DMITIGR_PGFE_INLINE void Connection_pool::maintainer_loop__() noexcept
+{
+  std::unique_lock lk{mutex_};
+  while (true) {
+    DMITIGR_ASSERT(maintenance_interval_);
+    if (maintainer_cv_.wait_for(lk, *maintenance_interval_,
+        [this]{return is_maintainer_stopping_;}))
+      break;
+
+    lk.unlock();
+    try {
+      maintain();
+    } catch (const std::exception& e) {
+      std::clog << "connection pool's maintenance: error: " << e.what() << '\n';
+    } catch (...) {
+      std::clog << "connection pool's maintenance: unknown error\n";
+    }
+    lk.lock();
+  }
+}
+
+DMITIGR_PGFE_INLINE void
+Connection_pool::prepare_catalog__(Connection& conn, const Catalog& catalog)
+{
+  DMITIGR_ASSERT(conn.is_ready_for_request());
+  if (catalog.empty())
+    return;
+
+  /*
+   * Prepare the statements in the single round trip. Each of the requests is
+   * followed by the synchronization point in order to isolate possible errors.
+   * The statements failed to prepare are reported upon the first use by
+   * Handle::prepared_statement().
+   */
+#ifdef LIBPQ_HAS_PIPELINING
+  conn.set_pipeline_enabled(true);
+  try {
+    for (const auto& [name, statement] : catalog) {
+      conn.prepare_nio(*statement, name);
+      conn.send_sync();
+    }
+    while (conn.has_uncompleted_request()) {
+      conn.wait_response();
+      if (conn.error() || conn.ready_for_query())
+        continue;
+      else if (conn.response_.status() == PGRES_PIPELINE_ABORTED)
+        conn.release_response();
+      else if (!conn.prepared_statement() && conn.has_response())
+        throw Client_exception{Client_errc::invalid_response};
+    }
+    conn.set_pipeline_enabled(false);
+  } catch (...) {
+    conn.disconnect(); // the state of connection is unknown
+    throw;
+  }
+#else
+  for (const auto& [name, statement] : catalog) {
+    try {
+      conn.prepare(*statement, name);
+    } catch (const Server_exception&) {}
+  }
+#endif
+}
+
 } // namespace dmitigr::pgfe
@@ -19,10 +19,19 @@
 
 #include "connection.hpp"
 #include "dll.hpp"
+#include "statement.hpp"
 
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -32,6 +41,16 @@ namespace dmitigr::pgfe {
  * @ingroup utilities
  *
  * @brief A thread-safe pool of connections to a PostgreSQL server.
+ *
+ * @details The free connections are kept in the free-list, so acquiring is
+ * O(1). The threads waiting for a free connection are queued in FIFO order,
+ * and each released connection is handed off directly to the first waiter.
+ *
+ * The pool is elastic: it opens connections on demand up to its size(), and
+ * (being maintained) closes the connections idle for too long down to its
+ * min_size(), validates the idle ones and reopens the broken ones.
+ *
+ * @see maintain().
  */
 class Connection_pool final {
 public:
@@ -98,11 +117,24 @@ public:
     /// @overload
     DMITIGR_PGFE_API Connection_pool* pool() noexcept;
 
+    /**
+     * @returns The prepared statement `name` of the catalog of pool(). The
+     * statement is prepared on the connection if it's not yet.
+     *
+     * @par Requires
+     * `is_valid() && pool()` and the catalog of pool() contains the statement
+     * `name`.
+     *
+     * @see Connection_pool::add_prepared_statement().
+     */
+    DMITIGR_PGFE_API Prepared_statement prepared_statement(const std::string& name);
+
     /// Calls pool()->release(*this) if `pool()`.
     DMITIGR_PGFE_API void release() noexcept;
 
   private:
     friend Connection_pool;
+    friend Sharded_connection_pool;
 
     std::shared_ptr<Connection_pool*> pool_;
     std::unique_ptr<Connection> connection_;
@@ -120,7 +152,8 @@ public:
   /**
    * @brief The destructor.
    *
-   * @details Nullifies the pool() for each Handle instance.
+   * @details Stops the background maintenance and nullifies the pool() for
+   * each Handle instance.
    */
   DMITIGR_PGFE_API ~Connection_pool() noexcept;
 
@@ -148,6 +181,19 @@ public:
   explicit DMITIGR_PGFE_API Connection_pool(std::size_t count,
     const Connection_options& options = {});
 
+  /**
+   * @brief The constructor of elastic pool.
+   *
+   * @param min_count A number of connections kept open.
+   * @param max_count A maximum number of connections in the pool.
+   * @param options A connection options to be used for connections of pool.
+   *
+   * @par Requires
+   * `min_count <= max_count`.
+   */
+  DMITIGR_PGFE_API Connection_pool(std::size_t min_count,
+    std::size_t max_count, const Connection_options& options = {});
+
   /// @returns `true` if this instance is valid.
   DMITIGR_PGFE_API bool is_valid() const noexcept;
 
@@ -161,6 +207,9 @@ public:
    * @brief Sets the handler which will be called for each connection in the
    * pool just after connecting to the PostgreSQL server.
    *
+   * @details The handler is called either by connect(), or without locking the
+   * pool upon reopening the connection by connection().
+   *
    * @remarks For example, it could be used to execute a query like
    * `SET application_name to 'foo'`.
    *
@@ -180,7 +229,11 @@ public:
    * @brief Sets the handler which will be called just after returning a
    * connection to the pool.
    *
-   * @remarks By default, it executes the `DISCARD ALL` statement.
+   * @remarks By default, it resets the mutated aspects of the session state
+   * only, so releasing the connection used for read-only work costs no round
+   * trip.
+   *
+   * @see Connection::reset_session_state().
    *
    * @see release_handler().
    */
@@ -195,9 +248,133 @@ public:
   DMITIGR_PGFE_API const std::function<void(Connection&)>&
   release_handler() const noexcept;
 
+  /**
+   * @brief Sets the timeout after which the idle connection is closed by
+   * maintain() if the number of open connections exceeds min_size().
+   *
+   * @param timeout The value of `std::nullopt` means *eternity*.
+   *
+   * @par Requires
+   * `!timeout || timeout->count() >= 0`.
+   */
+  DMITIGR_PGFE_API void
+  set_idle_timeout(std::optional<std::chrono::milliseconds> timeout);
+
+  /// @returns The current idle timeout.
+  DMITIGR_PGFE_API std::optional<std::chrono::milliseconds>
+  idle_timeout() const noexcept;
+
+  /**
+   * @brief Sets the maximum number of the free connections validated by
+   * maintain() at once.
+   *
+   * @details The connections of the batch are validated concurrently and
+   * they are unavailable for acquisition meanwhile, while the rest of the
+   * free connections remain available.
+   *
+   * @par Requires
+   * `size > 0`.
+   *
+   * @remarks The default is `8`.
+   */
+  DMITIGR_PGFE_API void set_validation_batch_size(std::size_t size);
+
+  /// @returns The current validation batch size.
+  DMITIGR_PGFE_API std::size_t validation_batch_size() const noexcept;
+
+  /**
+   * @brief Sets the time the free connection must be idle for in order to be
+   * validated by maintain().
+   *
+   * @details The connections used recently are known to be alive, so there
+   * is no need to validate them.
+   *
+   * @par Requires
+   * `threshold.count() >= 0`.
+   *
+   * @remarks The default is one second.
+   */
+  DMITIGR_PGFE_API void
+  set_validation_idle_threshold(std::chrono::milliseconds threshold);
+
+  /// @returns The current validation idle threshold.
+  DMITIGR_PGFE_API std::chrono::milliseconds
+  validation_idle_threshold() const noexcept;
+
+  /**
+   * @brief Sets the interval of calling maintain() by the background thread
+   * while the pool is connected.
+   *
+   * @param interval The value of `std::nullopt` means no background
+   * maintenance.
+   *
+   * @par Requires
+   * `!interval || interval->count() > 0`.
+   */
+  DMITIGR_PGFE_API void
+  set_maintenance_interval(std::optional<std::chrono::milliseconds> interval);
+
+  /// @returns The current maintenance interval.
+  DMITIGR_PGFE_API std::optional<std::chrono::milliseconds>
+  maintenance_interval() const noexcept;
+
+  /**
+   * @brief Maintains the connected pool.
+   *
+   * @details Does the following:
+   *   -# closes the free connections idle longer than idle_timeout() while
+   *   `open_count() > min_size()`;
+   *   -# opens the connections while `open_count() < min_size()`;
+   *   -# validates the free connections idle for at least
+   *   validation_idle_threshold() by a round trip to the server by batches
+   *   of validation_batch_size() connections, and closes the broken ones.
+   *
+   * The connections are validated and opened without locking the pool, and
+   * they are unavailable for acquisition meanwhile.
+   */
+  DMITIGR_PGFE_API void maintain();
+
+  /**
+   * @brief Adds the statement to the catalog of the prepared statements.
+   *
+   * @details The statements of the catalog are prepared on each connection
+   * upon its (re)opening within the single round trip if pipelining is
+   * available, or upon the first use by Handle::prepared_statement(). The
+   * default release handler doesn't deallocate the prepared statements while
+   * the catalog is not empty.
+   *
+   * @param name A name of prepared statement.
+   * @param statement A statement to prepare.
+   *
+   * @par Requires
+   * `!name.empty() && !statement.has_missing_parameters()`.
+   *
+   * @remarks The connections which are already open prepare the added
+   * statement upon the first use. If the catalog already contains the statement
+   * `name`, it's replaced and the previous one is deallocated on each connection
+   * upon the first use of Handle::prepared_statement().
+   */
+  DMITIGR_PGFE_API void add_prepared_statement(std::string name,
+    Statement statement);
+
+  /**
+   * @brief Removes the statement from the catalog of the prepared statements.
+   *
+   * @remarks The statement is deallocated on each open connection upon the
+   * first use of Handle::prepared_statement().
+   */
+  DMITIGR_PGFE_API void remove_prepared_statement(const std::string& name);
+
+  /// @returns The number of statements in the catalog.
+  DMITIGR_PGFE_API std::size_t prepared_statement_count() const noexcept;
+
   /**
    * @brief Opens the connections to the server.
    *
+   * @details The min_size() connections are established concurrently without
+   * locking the pool. If any of them cannot be established, all the connections
+   * are closed.
+   *
    * @par Effects
    * `is_connected() == is_valid()` on success.
    *
@@ -227,6 +404,28 @@ public:
    */
   DMITIGR_PGFE_API Handle connection();
 
+  /**
+   * @brief Waits for a free connection in the pool.
+   *
+   * @details The waiting threads are served in FIFO order.
+   *
+   * @param timeout The value of `std::nullopt` means *eternity*.
+   *
+   * @returns The valid connection handle.
+   *
+   * @par Requires
+   * `!timeout || timeout->count() >= 0`.
+   *
+   * @throws Client_exception if:
+   *   - `!is_connected()`, including the case when the pool is disconnected
+   *   while waiting;
+   *   - there is no free connection within the specified `timeout` (with code
+   *   Client_errc::timed_out);
+   *   - attempt to reopen the connection possibly closed upon of calling
+   *   release() is failed.
+   */
+  DMITIGR_PGFE_API Handle connection(std::optional<std::chrono::milliseconds> timeout);
+
   /**
    * @brief Returns the connection of `handle` back to the pool.
    *
@@ -243,21 +442,96 @@ public:
    */
   DMITIGR_PGFE_API void release(Handle& handle) noexcept;
 
-  /// @returns The size of the pool.
+  /// @returns The size of the pool, i.e. the maximum number of connections.
   DMITIGR_PGFE_API std::size_t size() const noexcept;
 
+  /// @returns The number of connections kept open.
+  DMITIGR_PGFE_API std::size_t min_size() const noexcept;
+
+  /// @returns The number of open (both free and busy) connections.
+  DMITIGR_PGFE_API std::size_t open_count() const noexcept;
+
+  /// @returns The number of free open connections in the pool.
+  DMITIGR_PGFE_API std::size_t free_count() const noexcept;
+
+  /// @returns The total number of connections closed by maintain() as idle.
+  DMITIGR_PGFE_API std::size_t idle_close_count() const noexcept;
+
+  /// @returns The total number of connections found broken by maintain().
+  DMITIGR_PGFE_API std::size_t broken_count() const noexcept;
+
+  /// @returns The number of threads waiting for a free connection.
+  DMITIGR_PGFE_API std::size_t wait_queue_size() const noexcept;
+
+  /// @returns The total number of acquisitions which had to wait.
+  DMITIGR_PGFE_API std::size_t wait_count() const noexcept;
+
+  /// @returns The total number of acquisitions which timed out.
+  DMITIGR_PGFE_API std::size_t wait_timeout_count() const noexcept;
+
+  /// @returns The total time spent waiting for free connections.
+  DMITIGR_PGFE_API std::chrono::nanoseconds wait_time() const noexcept;
+
+  /// @returns The maximum time spent waiting for a free connection.
+  DMITIGR_PGFE_API std::chrono::nanoseconds max_wait_time() const noexcept;
+
 private:
   friend Handle;
+  friend Sharded_connection_pool;
 
-  using State = std::pair<
-    std::unique_ptr<Connection>,
-    std::shared_ptr<Connection_pool*>>;
+  using Clock = std::chrono::steady_clock;
+
+  using Catalog = std::unordered_map<std::string, std::shared_ptr<const Statement>>;
+
+  struct State final {
+    std::unique_ptr<Connection> connection_; // nullptr if busy
+    std::shared_ptr<Connection_pool*> self_;
+    Clock::time_point idle_since_;
+    Catalog prepared_; // the entries of catalog_ prepared on connection_
+    std::uint_fast64_t catalog_version_{}; // of prepared_
+  };
+
+  struct Waiter final {
+    std::condition_variable cv_;
+    std::optional<std::size_t> state_index_;
+    bool is_cancelled_{};
+  };
 
   mutable std::mutex mutex_;
+  std::mutex connect_mutex_; // serializes connect() and disconnect()
   bool is_connected_{};
   std::vector<State> states_;
+  std::size_t min_count_{};
+  std::vector<std::size_t> free_; // indexes of states_ of open connections
+  std::vector<std::size_t> closed_; // indexes of states_ of closed connections
+  std::deque<Waiter*> waiters_;
+  std::size_t wait_count_{};
+  std::size_t wait_timeout_count_{};
+  std::chrono::nanoseconds wait_time_{};
+  std::chrono::nanoseconds max_wait_time_{};
   std::function<void(Connection&)> connect_handler_;
   std::function<void(Connection&)> release_handler_;
+  std::function<void()> free_handler_; // called by free__() and disconnect()
+  Catalog catalog_;
+  std::uint_fast64_t catalog_version_{}; // incremented on each change
+  std::optional<std::chrono::milliseconds> idle_timeout_;
+  std::size_t validation_batch_size_{8};
+  std::chrono::milliseconds validation_idle_threshold_{1000};
+  std::optional<std::chrono::milliseconds> maintenance_interval_;
+  std::size_t idle_close_count_{};
+  std::size_t broken_count_{};
+  std::thread maintainer_;
+  std::condition_variable maintainer_cv_;
+  bool is_maintainer_stopping_{};
+
+  std::optional<std::size_t> pop_free__() noexcept;
+  Handle acquire__(std::size_t index);
+  void connect__(Handle& handle);
+  void free__(std::size_t index) noexcept;
+  void start_maintainer__();
+  void stop_maintainer__() noexcept;
+  void maintainer_loop__() noexcept;
+  static void prepare_catalog__(Connection& conn, const Catalog& catalog);
 };
 
 } // namespace dmitigr::pgfe
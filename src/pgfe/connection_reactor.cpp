@@ -0,0 +1,473 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "../base/assert.hpp"
+#include "connection.hpp"
+#include "connection_reactor.hpp"
+#include "errctg.hpp"
+#include "exceptions.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace dmitigr::pgfe {
+
+namespace {
+inline std::error_code make_timed_out_error_code() noexcept
+{
+  return std::error_code{static_cast<int>(Client_errc::timed_out),
+    client_error_category()};
+}
+} // namespace
+
+DMITIGR_PGFE_INLINE Connection_reactor::~Connection_reactor() noexcept = default;
+
+DMITIGR_PGFE_INLINE Connection_reactor::Connection_reactor()
+  : poller_{false}
+{
+  assert(is_invariant_ok());
+}
+
+DMITIGR_PGFE_INLINE void
+Connection_reactor::add_connection(Connection& connection,
+  Connect_handler handler, std::optional<std::chrono::milliseconds> timeout)
+{
+  using std::chrono::milliseconds;
+
+  if (has_connection(connection))
+    throw Client_exception{"cannot add connection to reactor: "
+      "connection already added"};
+  else if (!(!timeout || timeout >= milliseconds{-1}))
+    throw Client_exception{"cannot add connection to reactor: "
+      "invalid timeout specified"};
+
+  auto& entry = entries_[&connection]; // can throw
+  entry.connection_ = &connection;
+  entry.connect_timer_ = timers_.end();
+  bool is_connect_done{};
+  try {
+    if (!connection.is_connected()) {
+      if (timeout == milliseconds{-1})
+        timeout = connection.options().connect_timeout();
+
+      connection.connect_nio(); // can throw
+      if (timeout)
+        entry.connect_timer_ = timers_.emplace(Clock::now() + *timeout,
+          Timer{&entry, nullptr}); // can throw
+      entry.connect_handler_ = std::move(handler);
+      entry.is_connecting_ = true;
+      ++pending_count_;
+
+      const auto status = connection.status();
+      is_connect_done = status == Connection_status::connected ||
+        status == Connection_status::failure;
+    }
+    if (!is_connect_done)
+      update_events__(entry); // can throw
+  } catch (...) {
+    remove_connection(connection);
+    throw;
+  }
+
+  if (is_connect_done)
+    finish_connect__(entry, connection.is_connected() ? std::error_code{} :
+      std::make_error_code(std::errc::not_connected));
+
+  assert(is_invariant_ok());
+}
+
+DMITIGR_PGFE_INLINE void
+Connection_reactor::remove_connection(const Connection& connection) noexcept
+{
+  const auto i = entries_.find(&connection);
+  if (i == entries_.end())
+    return;
+
+  auto& entry = i->second;
+  unwatch__(entry);
+  if (entry.is_connecting_) {
+    if (entry.connect_timer_ != timers_.end())
+      timers_.erase(entry.connect_timer_);
+    --pending_count_;
+  }
+  for (const auto& request : entry.requests_) {
+    if (request.timer_ != timers_.end())
+      timers_.erase(request.timer_);
+    --pending_count_;
+  }
+  entries_.erase(i);
+
+  assert(is_invariant_ok());
+}
+
+DMITIGR_PGFE_INLINE bool
+Connection_reactor::has_connection(const Connection& connection) const noexcept
+{
+  return entries_.find(&connection) != entries_.end();
+}
+
+DMITIGR_PGFE_INLINE std::size_t
+Connection_reactor::connection_count() const noexcept
+{
+  return entries_.size();
+}
+
+DMITIGR_PGFE_INLINE void
+Connection_reactor::add_request(Connection& connection,
+  Row_handler row_handler, Done_handler done_handler,
+  std::optional<std::chrono::milliseconds> timeout)
+{
+  using std::chrono::milliseconds;
+
+  auto* const entry = entry__(&connection);
+  if (!entry)
+    throw Client_exception{"cannot add request to reactor: "
+      "connection not added"};
+  else if (!connection.is_connected())
+    throw Client_exception{"cannot add request to reactor: not connected"};
+  else if (!(!timeout || timeout >= milliseconds{-1}))
+    throw Client_exception{"cannot add request to reactor: "
+      "invalid timeout specified"};
+
+  if (timeout == milliseconds{-1})
+    timeout = connection.options().wait_response_timeout();
+
+  auto& requests = entry->requests_;
+  requests.push_back(Pending{connection.last_request_handle(),
+    std::move(row_handler), std::move(done_handler), timers_.end()}); // can throw
+  try {
+    auto& request = requests.back();
+    if (timeout)
+      request.timer_ = timers_.emplace(Clock::now() + *timeout,
+        Timer{entry, &request}); // can throw
+    connection.flush_output(false); // can throw
+    update_events__(*entry); // can throw
+  } catch (...) {
+    if (requests.back().timer_ != timers_.end())
+      timers_.erase(requests.back().timer_);
+    requests.pop_back();
+    throw;
+  }
+  ++pending_count_;
+
+  assert(is_invariant_ok());
+}
+
+DMITIGR_PGFE_INLINE std::size_t
+Connection_reactor::pending_count() const noexcept
+{
+  return pending_count_;
+}
+
+DMITIGR_PGFE_INLINE std::size_t
+Connection_reactor::run_once(const std::optional<std::chrono::milliseconds> timeout)
+{
+  using std::chrono::ceil;
+  using std::chrono::milliseconds;
+
+  if (!(!timeout || timeout >= milliseconds::zero()))
+    throw Client_exception{"cannot run connection reactor: "
+      "invalid timeout specified"};
+
+  static const auto to_int = [](const milliseconds value) noexcept
+  {
+    using Lim = std::numeric_limits<int>;
+    return static_cast<int>(std::clamp<milliseconds::rep>(value.count(),
+      0, Lim::max()));
+  };
+
+  int wait_timeout{timeout ? to_int(*timeout) : -1};
+  if (!timers_.empty()) {
+    const int left{to_int(ceil<milliseconds>(timers_.begin()->first -
+      Clock::now()))};
+    wait_timeout = wait_timeout < 0 ? left : std::min(wait_timeout, left);
+  }
+  if (entries_.empty() && wait_timeout < 0)
+    return 0;
+
+  wait__(wait_timeout);
+  std::size_t result{};
+  for (const auto& event : events_)
+    result += drive__(event);
+  result += expire__(Clock::now());
+
+  assert(is_invariant_ok());
+  return result;
+}
+
+DMITIGR_PGFE_INLINE std::size_t Connection_reactor::run()
+{
+  std::size_t result{};
+  while (pending_count_)
+    result += run_once();
+  return result;
+}
+
+DMITIGR_PGFE_INLINE bool Connection_reactor::is_invariant_ok() const noexcept
+{
+  const bool timers_ok = timers_.size() <= pending_count_;
+  const bool sockets_ok = sockets_.size() <= entries_.size();
+  return timers_ok && sockets_ok;
+}
+
+DMITIGR_PGFE_INLINE auto
+Connection_reactor::entry__(const Connection* const connection) noexcept -> Entry*
+{
+  const auto i = entries_.find(connection);
+  return i != entries_.end() ? &i->second : nullptr;
+}
+
+DMITIGR_PGFE_INLINE std::size_t Connection_reactor::drive__(const Event& event)
+{
+  auto* const entry = entry__(event.connection_);
+  if (!entry)
+    return 0; // removed by a handler
+
+  auto& connection = *entry->connection_;
+  if (entry->is_connecting_) {
+    try {
+      connection.connect_nio();
+    } catch (const std::exception&) {
+      return abort__(&connection);
+    }
+    switch (connection.status()) {
+    case Connection_status::connected:
+      finish_connect__(*entry, {});
+      return 1;
+    case Connection_status::failure:
+      finish_connect__(*entry, std::make_error_code(std::errc::not_connected));
+      return 1;
+    default:
+      update_events__(*entry);
+      return 0;
+    }
+  } else if (!connection.is_connected())
+    return fail__(&connection);
+
+  if (event.is_writable_) {
+    try {
+      connection.flush_output(false);
+    } catch (const std::exception&) {
+      return abort__(&connection);
+    }
+  }
+
+  const auto result = event.is_readable_ ? dispatch__(&connection) : 0;
+  if (auto* const e = entry__(&connection))
+    update_events__(*e);
+  return result;
+}
+
+DMITIGR_PGFE_INLINE std::size_t
+Connection_reactor::dispatch__(Connection* const connection)
+{
+  std::size_t result{};
+  while (auto* const entry = entry__(connection)) {
+    if (entry->requests_.empty()) {
+      // Handle the signals and dismiss the responses to requests without handles.
+      try {
+        connection->read_input();
+        while (true) {
+          if (connection->has_response())
+            connection->route_response__(true);
+          else if (connection->handle_input(false) != Response_status::ready)
+            break;
+        }
+      } catch (const std::exception&) {
+        result += abort__(connection);
+      }
+      break;
+    }
+
+    auto& request = entry->requests_.front();
+    bool is_ready{};
+    try {
+      is_ready = request.handle_.is_valid() && request.handle_.poll__(true);
+    } catch (const std::exception&) {
+      return result + abort__(connection);
+    }
+    if (!request.handle_.is_valid() || !connection->is_connected())
+      return result + fail__(connection);
+
+    while (auto row = request.handle_.row()) {
+      if (request.row_handler_)
+        request.row_handler_(std::move(row));
+    }
+    if (!is_ready)
+      break;
+
+    auto handle = std::move(request.handle_);
+    auto handler = std::move(request.done_handler_);
+    if (request.timer_ != timers_.end())
+      timers_.erase(request.timer_);
+    entry->requests_.pop_front();
+    --pending_count_;
+    ++result;
+    if (handler)
+      handler(std::move(handle), std::error_code{});
+  }
+  return result;
+}
+
+DMITIGR_PGFE_INLINE std::size_t
+Connection_reactor::fail__(Connection* const connection)
+{
+  const auto errc = std::make_error_code(std::errc::not_connected);
+  std::size_t result{};
+  while (auto* const entry = entry__(connection)) {
+    unwatch__(*entry);
+    if (entry->is_connecting_) {
+      finish_connect__(*entry, errc);
+      ++result;
+      continue;
+    } else if (entry->requests_.empty())
+      break;
+
+    auto& request = entry->requests_.front();
+    auto handle = std::move(request.handle_);
+    auto handler = std::move(request.done_handler_);
+    if (request.timer_ != timers_.end())
+      timers_.erase(request.timer_);
+    entry->requests_.pop_front();
+    --pending_count_;
+    ++result;
+    if (handler)
+      handler(std::move(handle), errc);
+  }
+  return result;
+}
+
+DMITIGR_PGFE_INLINE std::size_t
+Connection_reactor::abort__(Connection* const connection)
+{
+  if (auto* const entry = entry__(connection))
+    unwatch__(*entry);
+  connection->disconnect(); // the state of connection is unknown
+  return fail__(connection);
+}
+
+DMITIGR_PGFE_INLINE void
+Connection_reactor::finish_connect__(Entry& entry, const std::error_code errc)
+{
+  DMITIGR_ASSERT(entry.is_connecting_);
+  if (entry.connect_timer_ != timers_.end()) {
+    timers_.erase(entry.connect_timer_);
+    entry.connect_timer_ = timers_.end();
+  }
+  entry.is_connecting_ = false;
+  --pending_count_;
+  auto& connection = *entry.connection_;
+  auto handler = std::move(entry.connect_handler_);
+  update_events__(entry);
+  if (handler)
+    handler(connection, errc);
+}
+
+DMITIGR_PGFE_INLINE std::size_t
+Connection_reactor::expire__(const Clock::time_point now)
+{
+  std::size_t result{};
+  while (!timers_.empty() && timers_.begin()->first <= now) {
+    const auto timer = timers_.begin()->second;
+    timers_.erase(timers_.begin());
+    auto& entry = *timer.entry_;
+    ++result;
+    if (!timer.request_) {
+      entry.connect_timer_ = timers_.end();
+      unwatch__(entry);
+      entry.connection_->disconnect(); // abandon the establishment
+      finish_connect__(entry, make_timed_out_error_code());
+      continue;
+    }
+
+    auto& requests = entry.requests_;
+    const auto i = std::find_if(requests.begin(), requests.end(),
+      [&timer](const auto& request){return &request == timer.request_;});
+    DMITIGR_ASSERT(i != requests.end());
+    auto handle = std::move(i->handle_);
+    auto handler = std::move(i->done_handler_);
+    requests.erase(i);
+    --pending_count_;
+    if (handler)
+      handler(std::move(handle), make_timed_out_error_code());
+  }
+  return result;
+}
+
+DMITIGR_PGFE_INLINE void Connection_reactor::update_events__(Entry& entry)
+{
+  using Sr = Socket_readiness;
+
+  auto mask = Sr::unready;
+  const auto& connection = *entry.connection_;
+  const auto status = connection.status();
+  if (entry.is_connecting_) {
+    if (status == Connection_status::establishment_reading)
+      mask = Sr::read_ready;
+    else if (status == Connection_status::establishment_writing)
+      mask = Sr::write_ready;
+  } else if (status == Connection_status::connected) {
+    mask = Sr::read_ready;
+    if (!connection.is_output_flushed())
+      mask |= Sr::write_ready;
+  }
+
+  const int socket{mask != Sr::unready ? connection.socket() : -1};
+  if (socket != entry.socket_)
+    unwatch__(entry);
+  else if (mask == entry.mask_)
+    return;
+
+  if (socket >= 0) {
+    const auto [i, is_new] = sockets_.emplace(socket, entry.connection_); // can throw
+    try {
+      poller_.watch(socket, mask); // can throw
+    } catch (...) {
+      if (is_new)
+        sockets_.erase(i);
+      throw;
+    }
+    entry.socket_ = socket;
+    entry.mask_ = mask;
+  }
+}
+
+DMITIGR_PGFE_INLINE void Connection_reactor::unwatch__(Entry& entry) noexcept
+{
+  if (entry.socket_ < 0)
+    return;
+
+  poller_.unwatch(entry.socket_);
+  sockets_.erase(entry.socket_);
+  entry.socket_ = -1;
+  entry.mask_ = Socket_readiness::unready;
+}
+
+DMITIGR_PGFE_INLINE void Connection_reactor::wait__(const int timeout)
+{
+  using Sr = Socket_readiness;
+
+  events_.clear();
+  for (const auto& event : poller_.wait(timeout)) {
+    if (const auto i = sockets_.find(event.socket_); i != sockets_.end())
+      events_.push_back(Event{i->second,
+        bool(event.readiness_ & Sr::read_ready),
+        bool(event.readiness_ & Sr::write_ready)}); // can throw
+  }
+}
+
+} // namespace dmitigr::pgfe
@@ -0,0 +1,270 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DMITIGR_PGFE_CONNECTION_REACTOR_HPP
+#define DMITIGR_PGFE_CONNECTION_REACTOR_HPP
+
+#include "dll.hpp"
+#include "poller.hpp"
+#include "request_handle.hpp"
+#include "row.hpp"
+#include "types_fwd.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <optional>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+namespace dmitigr::pgfe {
+
+/**
+ * @ingroup utilities
+ *
+ * @brief A single-threaded multiplexer of I/O of many connections.
+ *
+ * @details The sockets of the added connections are watched in the single
+ * set (which is implemented by epoll(7) on Linux and by poll() elsewhere).
+ * Upon the socket readiness the reactor drives the connection establishment,
+ * flushes the output, reads and handles the input and dispatches the rows
+ * and the completions to the callbacks of the particular requests. All the
+ * deadlines are kept in the single timer structure, which is consulted once
+ * per iteration of the event loop.
+ *
+ * @remarks The added connections must be driven only by the reactor, and they
+ * must be removed from the reactor before their destruction. The responses to
+ * the requests not tracked by add_request() are dismissed.
+ *
+ * @remarks Functions of this class are not thread-safe.
+ */
+class Connection_reactor final {
+public:
+  /**
+   * @brief An alias of a connection handler.
+   *
+   * @details Called upon completion of the connection establishment with an
+   * empty error code on success, with `Client_errc::timed_out` on timeout or
+   * with `std::errc::not_connected` on failure. The connection is disconnected
+   * on timeout, as well as on failure caused by an exception.
+   */
+  using Connect_handler = std::function<void(Connection&, std::error_code)>;
+
+  /// An alias of a row handler.
+  using Row_handler = std::function<void(Row&&)>;
+
+  /**
+   * @brief An alias of a request completion handler.
+   *
+   * @details Called with the ready request handle and an empty error code
+   * upon the request completion, with the unready handle and
+   * `Client_errc::timed_out` on timeout, or with `std::errc::not_connected`
+   * if the connection is failed. The connection is disconnected if the
+   * failure is caused by an exception (e.g. because of an error of the I/O
+   * or of the protocol).
+   */
+  using Done_handler = std::function<void(Request_handle&&, std::error_code)>;
+
+  /**
+   * @brief The destructor.
+   *
+   * @details The handlers of the uncompleted operations are not called.
+   */
+  DMITIGR_PGFE_API ~Connection_reactor() noexcept;
+
+  /**
+   * @brief The constructor.
+   *
+   * @throws Client_exception if the underlying event notification facility
+   * cannot be initialized.
+   */
+  DMITIGR_PGFE_API Connection_reactor();
+
+  /// Non copy-constructible.
+  Connection_reactor(const Connection_reactor&) = delete;
+
+  /// Non copy-assignable.
+  Connection_reactor& operator=(const Connection_reactor&) = delete;
+
+  /// Non move-constructible.
+  Connection_reactor(Connection_reactor&&) = delete;
+
+  /// Non move-assignable.
+  Connection_reactor& operator=(Connection_reactor&&) = delete;
+
+  /**
+   * @brief Adds the `connection` to the reactor.
+   *
+   * @details If the `connection` is not connected, the connection
+   * establishment is initiated with connect_nio() and then driven by the
+   * reactor until completion, after which the `handler` is called.
+   *
+   * @param timeout The value of `-1` means `connection.options().connect_timeout()`,
+   * the value of `std::nullopt` means *eternity*.
+   *
+   * @par Requires
+   * `!has_connection(connection) && (!timeout || timeout->count() >= -1)`.
+   *
+   * @par Exception safety guarantee
+   * Basic.
+   */
+  DMITIGR_PGFE_API void add_connection(Connection& connection,
+    Connect_handler handler = {},
+    std::optional<std::chrono::milliseconds> timeout =
+    std::chrono::milliseconds{-1});
+
+  /**
+   * @brief Removes the `connection` from the reactor.
+   *
+   * @details The handlers of the uncompleted operations of the `connection`
+   * are not called.
+   */
+  DMITIGR_PGFE_API void remove_connection(const Connection& connection) noexcept;
+
+  /// @returns `true` if the `connection` is added to the reactor.
+  DMITIGR_PGFE_API bool has_connection(const Connection& connection) const noexcept;
+
+  /// @returns The number of connections added to the reactor.
+  DMITIGR_PGFE_API std::size_t connection_count() const noexcept;
+
+  /**
+   * @brief Tracks the last request submitted on the `connection`.
+   *
+   * @details The rows of the request are passed to `row_handler` as they are
+   * received and the `done_handler` is called upon the request completion.
+   *
+   * @param timeout The value of `-1` means `connection.options().wait_response_timeout()`,
+   * the value of `std::nullopt` means *eternity*. The timeout is applied to
+   * the request as a whole.
+   *
+   * @par Requires
+   * `has_connection(connection) && connection.is_connected() &&
+   *  connection.has_uncompleted_request() &&
+   *  (!timeout || timeout->count() >= -1)`.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   *
+   * @see Connection::last_request_handle().
+   */
+  DMITIGR_PGFE_API void add_request(Connection& connection,
+    Row_handler row_handler, Done_handler done_handler,
+    std::optional<std::chrono::milliseconds> timeout =
+    std::chrono::milliseconds{-1});
+
+  /**
+   * @returns The number of uncompleted connection establishments and
+   * requests.
+   */
+  DMITIGR_PGFE_API std::size_t pending_count() const noexcept;
+
+  /**
+   * @brief Waits for the events and dispatches them to the handlers.
+   *
+   * @param timeout The maximum time to wait for the events. The value of
+   * `std::nullopt` means *until the nearest deadline*, or *eternity* if
+   * there are no deadlines.
+   *
+   * @returns The number of completed (including timed out and failed)
+   * connection establishments and requests.
+   *
+   * @par Requires
+   * `!timeout || timeout->count() >= 0`.
+   *
+   * @par Exception safety guarantee
+   * Basic. The exceptions thrown by the handlers are propagated. The errors
+   * of the particular connections are reported to the handlers of their
+   * operations instead.
+   */
+  DMITIGR_PGFE_API std::size_t
+  run_once(std::optional<std::chrono::milliseconds> timeout = std::nullopt);
+
+  /**
+   * @brief Calls run_once() until `!pending_count()`.
+   *
+   * @returns The total number of completed connection establishments and
+   * requests.
+   */
+  DMITIGR_PGFE_API std::size_t run();
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Entry;
+  struct Pending;
+
+  struct Timer final {
+    Entry* entry_{};
+    Pending* request_{}; // nullptr denotes the connection establishment
+  };
+
+  using Timers = std::multimap<Clock::time_point, Timer>;
+
+  struct Pending final {
+    Request_handle handle_;
+    Row_handler row_handler_;
+    Done_handler done_handler_;
+    Timers::iterator timer_;
+  };
+
+  struct Entry final {
+    Connection* connection_{};
+    int socket_{-1};
+    Socket_readiness mask_{};
+    bool is_connecting_{};
+    Connect_handler connect_handler_;
+    Timers::iterator connect_timer_;
+    std::list<Pending> requests_;
+  };
+
+  struct Event final {
+    const Connection* connection_{};
+    bool is_readable_{};
+    bool is_writable_{};
+  };
+
+  detail::Poller poller_;
+  std::unordered_map<const Connection*, Entry> entries_;
+  std::unordered_map<int, const Connection*> sockets_; // watched by poller_
+  Timers timers_;
+  std::vector<Event> events_;
+  std::size_t pending_count_{};
+
+  bool is_invariant_ok() const noexcept;
+
+  Entry* entry__(const Connection* connection) noexcept;
+  std::size_t drive__(const Event& event);
+  std::size_t dispatch__(Connection* connection);
+  std::size_t fail__(Connection* connection);
+  std::size_t abort__(Connection* connection);
+  void finish_connect__(Entry& entry, std::error_code errc);
+  std::size_t expire__(Clock::time_point now);
+  void update_events__(Entry& entry);
+  void unwatch__(Entry& entry) noexcept;
+  void wait__(int timeout);
+};
+
+} // namespace dmitigr::pgfe
+
+#ifndef DMITIGR_PGFE_NOT_HEADER_ONLY
+#include "connection_reactor.cpp"
+#endif
+
+#endif  // DMITIGR_PGFE_CONNECTION_REACTOR_HPP
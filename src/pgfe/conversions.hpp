@@ -17,6 +17,7 @@
 #ifndef DMITIGR_PGFE_CONVERSIONS_HPP
 #define DMITIGR_PGFE_CONVERSIONS_HPP
 
+#include "../base/assert.hpp"
 #include "../net/conversions.hpp"
 #include "array_conversions.hpp"
 #include "basic_conversions.hpp"
@@ -24,14 +25,95 @@
 #include "data.hpp"
 #include "exceptions.hpp"
 #include "row.hpp"
+#include "tuple.hpp"
 #include "types_fwd.hpp"
 
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
 #include <cstring>
 #include <limits>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <type_traits>
 #include <utility>
+#include <vector>
+
+namespace dmitigr::pgfe {
+
+/**
+ * @ingroup conversions
+ *
+ * @brief A non-owning view of the bytes of the PostgreSQL's bytea.
+ *
+ * @details The view converted from the data of Data_format::binary format
+ * points directly into the memory of that data (for example, into the memory
+ * of the row received from the server) and thus must not outlive it.
+ */
+class Bytea_view final {
+public:
+  /// Constructs the empty view.
+  Bytea_view() noexcept = default;
+
+  /**
+   * @brief The constructor.
+   *
+   * @par Requires
+   * `data || !size`.
+   */
+  Bytea_view(const std::byte* const data, const std::size_t size) noexcept
+    : data_{data}
+    , size_{size}
+  {
+    DMITIGR_ASSERT(data || !size);
+  }
+
+  /// @returns The pointer to the first byte.
+  const std::byte* data() const noexcept
+  {
+    return data_;
+  }
+
+  /// @returns The number of bytes.
+  std::size_t size() const noexcept
+  {
+    return size_;
+  }
+
+  /// @returns `(size() == 0)`.
+  bool is_empty() const noexcept
+  {
+    return !size_;
+  }
+
+  /// @returns The iterator that points to the first byte.
+  const std::byte* begin() const noexcept
+  {
+    return data_;
+  }
+
+  /// @returns The iterator that points to the byte after the last one.
+  const std::byte* end() const noexcept
+  {
+    return data_ + size_;
+  }
+
+  /// @returns The view of bytes as characters.
+  std::string_view to_string_view() const noexcept
+  {
+    return {reinterpret_cast<const char*>(data_), size_};
+  }
+
+private:
+  const std::byte* data_{};
+  std::size_t size_{};
+};
+
+} // namespace dmitigr::pgfe
 
 namespace dmitigr::pgfe::detail {
 
@@ -101,144 +183,108 @@ struct Generic_data_conversions final {
 // Optimized numeric to/from std::string conversions
 // -----------------------------------------------------------------------------
 
-/// The common implementation of numeric to/from `std::string` conversions.
-template<typename T>
-struct Numeric_string_conversions_base {
-  using Type = T;
+/// `true` if `std::from_chars()` and `std::to_chars()` support floating point.
+#ifdef __cpp_lib_to_chars
+inline constexpr bool is_floating_point_charconv_available{true};
+#else
+inline constexpr bool is_floating_point_charconv_available{false};
+#endif
 
-  template<typename ... Types>
-  static std::string to_string(Type value, Types&& ... args)
-  {
-    if constexpr (std::is_floating_point_v<Type>) {
-      return Generic_string_conversions<Type>::to_string(value,
-        std::forward<Types>(args)...);
-    } else
-      return std::to_string(value);
-  }
+/// The size of the buffer enough for the text representation of numerics.
+inline constexpr std::size_t numeric_text_capacity{64};
 
-protected:
-  template<typename R, typename ... Types>
-  static Type to_numeric__(const std::string& text,
-    R(*converter)(const std::string&, std::size_t*, Types ...))
-  {
-    Type result;
-    std::size_t idx;
-    if constexpr (std::is_floating_point_v<R>) // workaround for GCC 7.5
-      result = converter(text, &idx);
+/**
+ * @returns The numeric converted from the `text` without allocations.
+ *
+ * @details The leading whitespaces and the plus sign are skipped for
+ * compatibility with `std::stoi()` and friends.
+ */
+template<typename T>
+T to_numeric(const std::string_view text)
+{
+  static_assert(std::is_arithmetic_v<T>);
+
+  const char* first = text.data();
+  const char* const last = first + text.size();
+  while (first != last && std::isspace(static_cast<unsigned char>(*first)))
+    ++first;
+  if (last - first > 1 && *first == '+' && first[1] != '-')
+    ++first;
+
+  T result{};
+  if constexpr (std::is_integral_v<T> || is_floating_point_charconv_available) {
+    const auto [ptr, ec] = std::from_chars(first, last, result);
+    if (ec == std::errc::result_out_of_range)
+      throw Client_exception{"cannot convert to numeric: "
+        "value is out of range of the type"};
+    else if (ec != std::errc{} || ptr != last)
+      throw Client_exception{"cannot convert to numeric: "
+        "input contains non-convertible symbols"};
+  } else {
+    const std::string str{first, last};
+    std::size_t idx{};
+    if constexpr (std::is_same_v<T, float>)
+      result = std::stof(str, &idx);
+    else if constexpr (std::is_same_v<T, double>)
+      result = std::stod(str, &idx);
     else
-      result = converter(text, &idx, 10);
-
-    if (idx != text.size())
+      result = std::stold(str, &idx);
+    if (idx != str.size())
       throw Client_exception{"cannot convert to numeric: "
         "input contains non-convertible symbols"};
-
-    return result;
   }
-};
+  return result;
+}
 
-// -----------------------------------------------------------------------------
-
-/// The implementation of `short int` to/from `std::string` conversions.
-template<>
-struct Numeric_string_conversions<short int> final
-  : private Numeric_string_conversions_base<int> {
-  using Type = short int;
-  using Numeric_string_conversions_base::to_string;
-
-  template<typename ... Types>
-  static Type to_type(const std::string& text, Types&& ...)
-  {
-    const int result = to_numeric__(text, &std::stoi);
-    constexpr auto max = std::numeric_limits<short int>::max();
-    if (result > max)
-      throw Client_exception{"cannot convert to type: numeric value "
-        + std::to_string(result) + " is greater than " + std::to_string(max)};
-
-    return static_cast<Type>(result);
-  }
-};
-
-/// The implementation of `int` to/from `std::string` conversions.
-template<>
-struct Numeric_string_conversions<int> final
-  : private Numeric_string_conversions_base<int> {
-  using Type = int;
-  using Numeric_string_conversions_base::to_string;
-
-  template<typename ... Types>
-  static Type to_type(const std::string& text, Types&& ...)
-  {
-    return to_numeric__(text, &std::stoi);
-  }
-};
-
-/// The implementation of `long int` to/from `std::string` conversions.
-template<>
-struct Numeric_string_conversions<long int> final
-  : private Numeric_string_conversions_base<long int> {
-  using Type = long int;
-  using Numeric_string_conversions_base::to_string;
-
-  template<typename ... Types>
-  static Type to_type(const std::string& text, Types&& ...)
-  {
-    return to_numeric__(text, &std::stol);
-  }
-};
-
-/// The implementation of `long long int` to/from `std::string` conversions.
-template<>
-struct Numeric_string_conversions<long long int> final
-  : private Numeric_string_conversions_base<long long int> {
-  using Type = long long int;
-  using Numeric_string_conversions_base::to_string;
-
-  template<typename ... Types>
-  static Type to_type(const std::string& text, Types&& ...)
-  {
-    return to_numeric__(text, &std::stoll);
-  }
-};
-
-/// The implementation of `float` to/from `std::string` conversions.
-template<>
-struct Numeric_string_conversions<float> final
-  : private Numeric_string_conversions_base<float> {
-  using Type = float;
-  using Numeric_string_conversions_base::to_string;
-
-  template<typename ... Types>
-  static Type to_type(const std::string& text, Types&& ...)
-  {
-    return to_numeric__(text, &std::stof);
+/**
+ * @returns The text representation of the numeric `value` written into the
+ * `buffer` without allocations.
+ *
+ * @details Floating point numbers are represented by the shortest text which
+ * can be converted back to exactly the same `value`.
+ */
+template<typename T>
+std::string_view to_numeric_text(const T value,
+  char (&buffer)[numeric_text_capacity])
+{
+  static_assert(std::is_arithmetic_v<T>);
+
+  if constexpr (std::is_integral_v<T> || is_floating_point_charconv_available) {
+    const auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    if (ec != std::errc{})
+      throw Client_exception{"cannot convert to string: "
+        "invalid native representation"};
+    return {buffer, static_cast<std::size_t>(ptr - buffer)};
+  } else {
+    constexpr int precision{std::numeric_limits<T>::max_digits10};
+    const int size = std::is_same_v<T, long double> ?
+      std::snprintf(buffer, sizeof(buffer), "%.*Lg", precision,
+        static_cast<long double>(value)) :
+      std::snprintf(buffer, sizeof(buffer), "%.*g", precision,
+        static_cast<double>(value));
+    if (!(0 < size && static_cast<std::size_t>(size) < sizeof(buffer)))
+      throw Client_exception{"cannot convert to string: "
+        "invalid native representation"};
+    return {buffer, static_cast<std::size_t>(size)};
   }
-};
+}
 
-/// The implementation of `double` to/from `std::string` conversions.
-template<>
-struct Numeric_string_conversions<double> final
-  : private Numeric_string_conversions_base<double> {
-  using Type = double;
-  using Numeric_string_conversions_base::to_string;
+/// The implementation of numeric to/from `std::string` conversions.
+template<typename T>
+struct Numeric_string_conversions final {
+  using Type = T;
 
   template<typename ... Types>
   static Type to_type(const std::string& text, Types&& ...)
   {
-    return to_numeric__(text, &std::stod);
+    return to_numeric<Type>(text);
   }
-};
-
-/// The implementation of `long double` to/from `std::string` conversions.
-template<>
-struct Numeric_string_conversions<long double> final
-  : private Numeric_string_conversions_base<long double> {
-  using Type = long double;
-  using Numeric_string_conversions_base::to_string;
 
   template<typename ... Types>
-  static Type to_type(const std::string& text, Types&& ...)
+  static std::string to_string(const Type value, Types&& ...)
   {
-    return to_numeric__(text, &std::stold);
+    char buffer[numeric_text_capacity];
+    return std::string{to_numeric_text(value, buffer)};
   }
 };
 
@@ -251,14 +297,24 @@ template<typename T, class StringConversions>
 struct Numeric_data_conversions final {
   using Type = T;
 
+  /// The OID of the PostgreSQL type of the binary format of `Type`.
+  static constexpr Oid binary_type_oid{std::is_floating_point_v<Type> ?
+    (sizeof(Type) == 4 ? 700 : sizeof(Type) == 8 ? 701 : invalid_oid) :
+    (sizeof(Type) == 2 ? 21 : sizeof(Type) == 4 ? 23 :
+      sizeof(Type) == 8 ? 20 : invalid_oid)};
+
+  /// `true` if there is the PostgreSQL type of the binary format of `Type`.
+  static constexpr bool is_binary_data_convertible{
+    binary_type_oid != invalid_oid};
+
   template<typename ... Types>
-  static Type to_type(const Data& data, Types&& ... args)
+  static Type to_type(const Data& data, Types&& ...)
   {
     if (data.format() == Data_format::binary)
       return net::conv<Type>(data.bytes(), data.size());
     else
-      return Generic_data_conversions<Type, StringConversions>::to_type(data,
-        std::forward<Types>(args)...);
+      return to_numeric<Type>({static_cast<const char*>(data.bytes()),
+        data.size()});
   }
 
   template<typename ... Types>
@@ -266,14 +322,31 @@ struct Numeric_data_conversions final {
   {
     if (!data)
       throw Client_exception{"cannot convert to type: null data given"};
-    return to_type(data, std::forward<Types>(args)...);
+    return to_type(*data, std::forward<Types>(args)...);
+  }
+
+  template<typename ... Types>
+  static std::unique_ptr<Data> to_data(const Type value, Types&& ...)
+  {
+    char buffer[numeric_text_capacity];
+    return Data::make(to_numeric_text(value, buffer), Data_format::text);
   }
 
   template<typename ... Types>
-  static std::unique_ptr<Data> to_data(Type value, Types&& ... args)
+  static std::unique_ptr<Data> to_data(const Type value,
+    const Data_format format, Types&& ...)
   {
-    return Generic_data_conversions<Type, StringConversions>::to_data(value,
-      std::forward<Types>(args)...);
+    if (format == Data_format::text)
+      return to_data(value);
+
+    if constexpr (is_binary_data_convertible) {
+      char buffer[sizeof(Type)];
+      net::copy(buffer, sizeof(buffer), value);
+      return Data::make(std::string_view{buffer, sizeof(buffer)},
+        Data_format::binary);
+    } else
+      throw Client_exception{"cannot convert to binary data: "
+        "no PostgreSQL type of such a numeric"};
   }
 };
 
@@ -426,6 +499,398 @@ struct Bool_data_conversions final {
     return Data::make(Bool_string_conversions::to_string(value),
       Data_format::text);
   }
+
+  template<typename ... Types>
+  static std::unique_ptr<Data> to_data(const Type value,
+    const Data_format format, Types&& ...)
+  {
+    if (format == Data_format::text)
+      return to_data(value);
+
+    const char byte = value ? 1 : 0;
+    return Data::make(std::string_view{&byte, 1}, Data_format::binary);
+  }
+};
+
+// -----------------------------------------------------------------------------
+// bytea conversions
+// -----------------------------------------------------------------------------
+
+/// @returns The hex-format text representation of the bytea.
+inline std::string to_bytea_hex_string(const std::byte* const bytes,
+  const std::size_t size)
+{
+  constexpr const char* digits{"0123456789abcdef"};
+  std::string result(2 + 2*size, '\\');
+  result[1] = 'x';
+  auto* out = result.data() + 2;
+  for (const auto* b = bytes; b != bytes + size; ++b) {
+    const auto value = std::to_integer<unsigned>(*b);
+    *out++ = digits[value >> 4];
+    *out++ = digits[value & 0xf];
+  }
+  return result;
+}
+
+/// The implementation of bytea to/from `std::string` conversions.
+struct Bytea_string_conversions final {
+  using Type = std::vector<std::byte>;
+
+  template<typename ... Types>
+  static Type to_type(const std::string& text, Types&& ...)
+  {
+    return to_type(std::string_view{text});
+  }
+
+  /// Decodes the `text` right into the result without intermediate copies.
+  static Type to_type(const std::string_view text)
+  {
+    Type result(Data::decoded_bytea_capacity(text));
+    result.resize(Data::decode_bytea(text, result.data(), result.size()));
+    return result;
+  }
+
+  /// @returns The hex-format text representation of the bytea.
+  template<typename ... Types>
+  static std::string to_string(const Type& value, Types&& ...)
+  {
+    return to_bytea_hex_string(value.data(), value.size());
+  }
+};
+
+/// The implementation of bytea to/from Data conversions.
+struct Bytea_data_conversions final {
+  using Type = std::vector<std::byte>;
+
+  template<typename ... Types>
+  static Type to_type(const Data& data, Types&& ...)
+  {
+    if (data.format() == Data_format::binary) {
+      const auto* const bytes = static_cast<const std::byte*>(data.bytes());
+      return Type(bytes, bytes + data.size());
+    } else
+      return Bytea_string_conversions::to_type(std::string_view{
+        static_cast<const char*>(data.bytes()), data.size()});
+  }
+
+  template<typename ... Types>
+  static Type to_type(std::unique_ptr<Data>&& data, Types&& ...)
+  {
+    if (!data)
+      throw Client_exception{"cannot convert to bytea: null data given"};
+    return to_type(*data);
+  }
+
+  template<typename ... Types>
+  static std::unique_ptr<Data> to_data(const Type& value, Types&& ...)
+  {
+    return Data::make(Bytea_string_conversions::to_string(value),
+      Data_format::text);
+  }
+
+  template<typename ... Types>
+  static std::unique_ptr<Data> to_data(const Type& value,
+    const Data_format format, Types&& ...)
+  {
+    if (format == Data_format::text)
+      return to_data(value);
+
+    return Data::make(std::string_view{
+      reinterpret_cast<const char*>(value.data()), value.size()},
+      Data_format::binary);
+  }
+};
+
+/// The implementation of Bytea_view to `std::string` conversions.
+struct Bytea_view_string_conversions final {
+  using Type = Bytea_view;
+
+  /// @returns The hex-format text representation of the bytea.
+  template<typename ... Types>
+  static std::string to_string(const Type& value, Types&& ...)
+  {
+    return to_bytea_hex_string(value.data(), value.size());
+  }
+};
+
+/// The implementation of Bytea_view to/from Data conversions.
+struct Bytea_view_data_conversions final {
+  using Type = Bytea_view;
+
+  template<typename ... Types>
+  static Type to_type(const Data& data, Types&& ...)
+  {
+    if (data.format() != Data_format::binary)
+      throw Client_exception{"cannot convert to bytea view: data is not in"
+        " binary format"};
+    return Type{static_cast<const std::byte*>(data.bytes()), data.size()};
+  }
+
+  template<typename ... Types>
+  static std::unique_ptr<Data> to_data(const Type& value, Types&& ...)
+  {
+    return Data::make(Bytea_view_string_conversions::to_string(value),
+      Data_format::text);
+  }
+
+  /// @returns The data which refers to the bytes of `value` if `format` is binary.
+  template<typename ... Types>
+  static std::unique_ptr<Data> to_data(const Type& value,
+    const Data_format format, Types&& ...)
+  {
+    if (format == Data_format::text)
+      return to_data(value);
+
+    return Data::make_no_copy(value.to_string_view(), Data_format::binary);
+  }
+};
+
+// -----------------------------------------------------------------------------
+// Tuple conversions
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief The implementation of Tuple to/from `std::string` conversions.
+ *
+ * @details The text representation of PostgreSQL records is like
+ * `(1,"a b",)`, where the empty unquoted field represents NULL.
+ */
+struct Tuple_string_conversions final {
+  using Type = Tuple;
+
+  template<typename ... Types>
+  static Type to_type(const std::string& text, Types&& ...)
+  {
+    return to_type__(text.data(), text.size());
+  }
+
+  /**
+   * @returns The text representation of the record.
+   *
+   * @par Requires
+   * Each element of `value` is either NULL or the data of Data_format::text.
+   */
+  template<typename ... Types>
+  static std::string to_string(const Type& value, Types&& ...)
+  {
+    std::string result{'('};
+    for (const auto& element : value.vector()) {
+      if (&element != value.vector().data())
+        result += ',';
+      if (const auto& data = element.second) {
+        if (data->format() != Data_format::text)
+          throw Client_exception{"cannot convert tuple to string: "
+            "field data is not in text format"};
+
+        result += '"';
+        const auto* const bytes = static_cast<const char*>(data->bytes());
+        for (std::size_t i{}; i < data->size(); ++i) {
+          if (bytes[i] == '"' || bytes[i] == '\\')
+            result += bytes[i];
+          result += bytes[i];
+        }
+        result += '"';
+      }
+    }
+    result += ')';
+    return result;
+  }
+
+private:
+  friend struct Tuple_data_conversions;
+
+  /**
+   * @returns The tuple of unnamed fields parsed from the record literal.
+   *
+   * @remarks The literal `()` represents the record of one NULL field.
+   */
+  static Type to_type__(const char* const text, const std::size_t size)
+  {
+    const char* pos{text};
+    const char* const end{text + size};
+    const auto skip_spaces = [&pos, end]
+    {
+      while (pos != end && std::isspace(static_cast<unsigned char>(*pos)))
+        ++pos;
+    };
+
+    skip_spaces();
+    if (pos == end || *pos++ != '(')
+      throw Client_exception{Client_errc::malformed_literal};
+
+    std::vector<Tuple::Element> elements;
+    while (true) {
+      if (pos == end)
+        throw Client_exception{Client_errc::malformed_literal};
+      else if (*pos == ',' || *pos == ')')
+        elements.emplace_back(std::string{}, nullptr);
+      else {
+        std::string value;
+        bool is_quoted{};
+        while (true) {
+          if (pos == end)
+            throw Client_exception{Client_errc::malformed_literal};
+          else if (!is_quoted && (*pos == ',' || *pos == ')'))
+            break;
+
+          const char c{*pos++};
+          if (c == '\\') {
+            if (pos == end)
+              throw Client_exception{Client_errc::malformed_literal};
+            value += *pos++;
+          } else if (c == '"') {
+            if (is_quoted && pos != end && *pos == '"') {
+              value += '"';
+              ++pos;
+            } else
+              is_quoted = !is_quoted;
+          } else
+            value += c;
+        }
+        elements.emplace_back(std::string{},
+          Data::make(std::move(value), Data_format::text));
+      }
+      if (*pos++ == ')')
+        break;
+    }
+    skip_spaces();
+    if (pos != end)
+      throw Client_exception{Client_errc::malformed_literal};
+
+    return Tuple{std::move(elements)};
+  }
+};
+
+/**
+ * @brief The implementation of Tuple to/from Data conversions.
+ *
+ * @details The binary format of PostgreSQL records is:
+ *   -# the number of fields (int32);
+ *   -# for each field: the OID of its type (uint32), the size of its data
+ *   (int32) or `-1` for NULL, and the data in binary format.
+ */
+struct Tuple_data_conversions final {
+  using Type = Tuple;
+
+  /**
+   * @returns The tuple of unnamed fields. The fields of the tuple converted
+   * from the data of Data_format::binary format refer to the bytes of `data`
+   * (for example, to the memory of the row received from the server) and thus
+   * the tuple must not outlive it. The fields of the tuple converted from the
+   * data of Data_format::text format are always copied.
+   */
+  template<typename ... Types>
+  static Type to_type(const Data& data, Types&& ...)
+  {
+    const char* bytes = static_cast<const char*>(data.bytes());
+    const char* const end = bytes + data.size();
+    if (data.format() == Data_format::text)
+      return Tuple_string_conversions::to_type__(bytes, data.size());
+
+    const auto field_count = read_binary_int32(bytes, end);
+    if (field_count < 0 || (end - bytes) / 8 < field_count)
+      throw Client_exception{Client_errc::malformed_literal};
+
+    std::vector<Tuple::Element> elements;
+    elements.reserve(static_cast<std::size_t>(field_count));
+    for (std::int32_t i{}; i < field_count; ++i) {
+      read_binary_int32(bytes, end); // the type OID is not needed
+      const auto length = read_binary_int32(bytes, end);
+      if (length < 0)
+        elements.emplace_back(std::string{}, nullptr);
+      else if (end - bytes < length)
+        throw Client_exception{Client_errc::malformed_literal};
+      else {
+        elements.emplace_back(std::string{}, Data::make_no_copy(
+          {bytes, static_cast<std::size_t>(length)}, Data_format::binary));
+        bytes += length;
+      }
+    }
+    if (bytes != end)
+      throw Client_exception{Client_errc::malformed_literal};
+
+    return Tuple{std::move(elements)};
+  }
+
+  /// @returns The tuple of fields which own the copies of their data.
+  template<typename ... Types>
+  static Type to_type(std::unique_ptr<Data>&& data, Types&& ...)
+  {
+    if (!data)
+      throw Client_exception{"cannot convert to tuple: null data given"};
+
+    auto result = to_type(*data);
+    if (data->format() == Data_format::binary) {
+      for (auto& element : result.vector()) {
+        if (element.second)
+          element.second = element.second->to_data();
+      }
+    }
+    return result;
+  }
+
+  static std::unique_ptr<Data> to_data(const Type& value)
+  {
+    return Data::make(Tuple_string_conversions::to_string(value),
+      Data_format::text);
+  }
+
+  /**
+   * @par Requires
+   * `format == Data_format::text`, since the binary representation of records
+   * requires the OIDs of the field types.
+   */
+  static std::unique_ptr<Data> to_data(const Type& value,
+    const Data_format format)
+  {
+    if (format != Data_format::text)
+      throw Client_exception{"cannot convert tuple to binary data: "
+        "field types are not specified"};
+    return to_data(value);
+  }
+
+  /**
+   * @returns The data of the record which fields are of the types
+   * `field_types`, or the text representation if `format` is text.
+   *
+   * @par Requires
+   * `field_types.size() == value.field_count()` and each element of `value`
+   * is either NULL or the data of Data_format::binary if `format` is binary.
+   */
+  static std::unique_ptr<Data> to_data(const Type& value,
+    const Data_format format, const std::vector<Oid>& field_types)
+  {
+    if (format == Data_format::text)
+      return to_data(value);
+
+    const auto& elements = value.vector();
+    if (field_types.size() != elements.size())
+      throw Client_exception{"cannot convert tuple to binary data: "
+        "invalid number of field types"};
+    else if (elements.size() > static_cast<std::size_t>(
+        std::numeric_limits<std::int32_t>::max()))
+      throw Client_exception{"cannot convert tuple to binary data: "
+        "too many fields"};
+
+    std::string result;
+    write_binary_int32(result, static_cast<std::int32_t>(elements.size()));
+    for (std::size_t i{}; i < elements.size(); ++i) {
+      write_binary_int32(result, static_cast<std::int32_t>(field_types[i]));
+      if (const auto& data = elements[i].second) {
+        if (data->format() != Data_format::binary)
+          throw Client_exception{"cannot convert tuple to binary data: "
+            "field data is not in binary format"};
+        else if (data->size() > static_cast<std::size_t>(
+            std::numeric_limits<std::int32_t>::max()))
+          throw Client_exception{"cannot convert tuple to binary data: "
+            "too large field"};
+        write_binary_int32(result, static_cast<std::int32_t>(data->size()));
+        result.append(static_cast<const char*>(data->bytes()), data->size());
+      } else
+        write_binary_int32(result, -1);
+    }
+    return Data::make(std::move(result), Data_format::binary);
+  }
 };
 
 // -----------------------------------------------------------------------------
@@ -468,7 +933,8 @@ namespace dmitigr::pgfe {
  *
  * @details Support of the following data formats is implemented for:
  *   - input data  - Data_format::text, Data_format::binary;
- *   - output data - Data_format::text.
+ *   - output data - Data_format::text, Data_format::binary (except
+ *   `long double`).
  *
  * @par Requires
  * When converting to the native type `Type`, the size of the input data in
@@ -478,7 +944,15 @@ template<typename T>
 struct Numeric_conversions : Basic_conversions<
   T,
   detail::Numeric_string_conversions<T>,
-  detail::Numeric_data_conversions<T>> {};
+  detail::Numeric_data_conversions<T>> {
+  /// The OID of the PostgreSQL type of the binary format.
+  static constexpr Oid binary_type_oid{
+    detail::Numeric_data_conversions<T>::binary_type_oid};
+
+  /// `true` if the output data can be in Data_format::binary.
+  static constexpr bool is_binary_data_convertible{
+    detail::Numeric_data_conversions<T>::is_binary_data_convertible};
+};
 
 // -----------------------------------------------------------------------------
 
@@ -525,7 +999,14 @@ struct Conversions<std::string> final : Basic_conversions<
   std::string,
   detail::Forwarding_string_conversions,
   detail::Generic_data_conversions<std::string,
-    detail::Forwarding_string_conversions>> {};
+    detail::Forwarding_string_conversions>> {
+  /**
+   * @brief The OID of `text`.
+   *
+   * @details Used only to convert the arrays of strings to Data_format::binary.
+   */
+  static constexpr Oid binary_type_oid{25};
+};
 
 /**
  * @ingroup conversions
@@ -622,14 +1103,92 @@ struct Conversions<char> final : Basic_conversions<char,
  *
  * @details Support of the following data formats is implemented for:
  *   - input data  - Data_format::text, Data_format::binary;
- *   - output data - Data_format::text.
+ *   - output data - Data_format::text, Data_format::binary.
  *
  * @par Requires
  * The size of the input data of Data_format::binary format must be exactly `1`.
  */
 template<>
 struct Conversions<bool> final : Basic_conversions<bool,
-  detail::Bool_string_conversions, detail::Bool_data_conversions> {};
+  detail::Bool_string_conversions, detail::Bool_data_conversions> {
+  /// The OID of `boolean`.
+  static constexpr Oid binary_type_oid{16};
+
+  /// `true` since the output data can be in Data_format::binary.
+  static constexpr bool is_binary_data_convertible{true};
+};
+
+/**
+ * @ingroup conversions
+ *
+ * @brief Full specialization of Conversions for `std::vector<std::byte>`
+ * which represents the PostgreSQL's bytea.
+ *
+ * @details Support of the following data formats is implemented for:
+ *   - input data  - Data_format::text, Data_format::binary;
+ *   - output data - Data_format::text (in hex format), Data_format::binary.
+ */
+template<>
+struct Conversions<std::vector<std::byte>> final : Basic_conversions<
+  std::vector<std::byte>,
+  detail::Bytea_string_conversions, detail::Bytea_data_conversions> {
+  /// The OID of `bytea`.
+  static constexpr Oid binary_type_oid{17};
+
+  /// `true` since the output data can be in Data_format::binary.
+  static constexpr bool is_binary_data_convertible{true};
+};
+
+/**
+ * @ingroup conversions
+ *
+ * @brief Full specialization of Conversions for Bytea_view.
+ *
+ * @details Support of the following data formats is implemented for:
+ *   - input data  - Data_format::binary only, since the view refers to the
+ *   bytes of the input data without copying them;
+ *   - output data - Data_format::text (in hex format), Data_format::binary
+ *   (without copying).
+ *
+ * @remarks To decode the bytea of Data_format::text format either convert it
+ * to `std::vector<std::byte>` or use Data::decode_bytea() with a preallocated
+ * buffer.
+ */
+template<>
+struct Conversions<Bytea_view> final : Basic_conversions<Bytea_view,
+  detail::Bytea_view_string_conversions, detail::Bytea_view_data_conversions> {
+  /// The OID of `bytea`.
+  static constexpr Oid binary_type_oid{17};
+
+  /// `true` since the output data can be in Data_format::binary.
+  static constexpr bool is_binary_data_convertible{true};
+};
+
+/**
+ * @ingroup conversions
+ *
+ * @brief Full specialization of Conversions for Tuple which represents the
+ * PostgreSQL's record (or composite type).
+ *
+ * @details Support of the following data formats is implemented for:
+ *   - input data  - Data_format::text, Data_format::binary (the fields refer
+ *   to the input data without copying, so the tuple must not outlive it);
+ *   - output data - Data_format::text, Data_format::binary (only if the OIDs of
+ *   field types are passed as `std::vector<Oid>` after the format).
+ *
+ * @remarks The tuples are never converted to Data_format::binary implicitly,
+ * so Prepared_statement::bind() always binds them in Data_format::text. The
+ * record in binary format can be bound explicitly, for example:
+ * @code
+ * Tuple point;
+ * point.append("x", to_data(1, Data_format::binary));
+ * point.append("y", to_data(2, Data_format::binary));
+ * ps.bind(0, to_data(point, Data_format::binary, std::vector<Oid>{23, 23}));
+ * @endcode
+ */
+template<>
+struct Conversions<Tuple> final : Basic_conversions<Tuple,
+  detail::Tuple_string_conversions, detail::Tuple_data_conversions> {};
 
 /**
  * @ingroup conversions
@@ -640,11 +1199,15 @@ template<typename T>
 struct Conversions<std::optional<T>> final {
   using Type = std::optional<T>;
 
+  /// `true` if the output data can be in Data_format::binary.
+  static constexpr bool is_binary_data_convertible{
+    detail::Is_binary_data_convertible<T>::value};
+
   template<typename ... Types>
   static Type to_type(const Data& data, Types&& ... args)
   {
     if (data)
-      return Conversions<T>::to_type(data, std::forward(args)...);
+      return Conversions<T>::to_type(data, std::forward<Types>(args)...);
     else
       return std::nullopt;
   }
@@ -653,7 +1216,7 @@ struct Conversions<std::optional<T>> final {
   static Type to_type(std::unique_ptr<Data>&& data, Types&& ... args)
   {
     if (data && *data)
-      return Conversions<T>::to_type(std::move(data), std::forward(args)...);
+      return Conversions<T>::to_type(std::move(data), std::forward<Types>(args)...);
     else
       return std::nullopt;
   }
@@ -662,7 +1225,7 @@ struct Conversions<std::optional<T>> final {
   static std::unique_ptr<Data> to_data(const Type& value, Types&& ... args)
   {
     if (value)
-      return Conversions<T>::to_data(*value, std::forward(args)...);
+      return Conversions<T>::to_data(*value, std::forward<Types>(args)...);
     else
       return nullptr;
   }
@@ -671,7 +1234,7 @@ struct Conversions<std::optional<T>> final {
   static std::unique_ptr<Data> to_data(Type&& value, Types&& ... args)
   {
     if (value)
-      return Conversions<T>::to_data(std::move(*value), std::forward(args)...);
+      return Conversions<T>::to_data(std::move(*value), std::forward<Types>(args)...);
     else
       return nullptr;
   }
@@ -680,7 +1243,7 @@ struct Conversions<std::optional<T>> final {
   static Type to_type(const Row& row, Types&& ... args)
   {
     if (row)
-      return Conversions<T>::to_type(row, std::forward(args)...);
+      return Conversions<T>::to_type(row, std::forward<Types>(args)...);
     else
       return std::nullopt;
   }
@@ -689,7 +1252,7 @@ struct Conversions<std::optional<T>> final {
   static Type to_type(Row&& row, Types&& ... args)
   {
     if (row)
-      return Conversions<T>::to_type(std::move(row), std::forward(args)...);
+      return Conversions<T>::to_type(std::move(row), std::forward<Types>(args)...);
     else
       return std::nullopt;
   }
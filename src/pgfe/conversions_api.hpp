@@ -85,6 +85,24 @@ namespace dmitigr::pgfe {
  *   the value of type `T`. These conversions might be used to convert an entire
  *   row from a server representation to a natural client representation.
  *
+ * If the specialization can produce the instances of type Data in
+ * Data_format::binary format, it should define
+ * @code
+ * static constexpr bool is_binary_data_convertible{true};
+ * @endcode
+ * and accept the value of type Data_format as the first optional argument
+ * of `to_data()`. Such a specialization is used by Prepared_statement::bind()
+ * to bind the parameters in the format specified by
+ * Prepared_statement::parameter_format().
+ *
+ * If the binary representation of `T` corresponds to the particular PostgreSQL
+ * type, the specialization should define
+ * @code
+ * static constexpr Oid binary_type_oid{...};
+ * @endcode
+ * which is required to convert the arrays of elements of type `T` to the
+ * instances of type Data in Data_format::binary format.
+ *
  * Variadic arguments (args) are *optional* and may be used in cases when
  * some extra information (for example, a server version) need to be passed into
  * the conversion routine. Absence of these arguments for conversion routines
@@ -106,6 +124,35 @@ namespace dmitigr::pgfe {
  */
 template<typename> struct Conversions;
 
+namespace detail {
+
+/**
+ * @brief The trait which is `true` if `Conversions<T>::to_data()` can produce
+ * the instances of type Data in Data_format::binary format.
+ */
+template<typename T, typename = void>
+struct Is_binary_data_convertible : std::false_type {};
+
+/// @overload
+template<typename T>
+struct Is_binary_data_convertible<T,
+  std::enable_if_t<Conversions<T>::is_binary_data_convertible>>
+  : std::true_type {};
+
+/**
+ * @brief The trait which value is the OID of the PostgreSQL type of the binary
+ * representation of `T`, or `invalid_oid` if there is no such a type.
+ */
+template<typename T, typename = void>
+struct Binary_type_oid : std::integral_constant<Oid, invalid_oid> {};
+
+/// @overload
+template<typename T>
+struct Binary_type_oid<T, std::void_t<decltype(Conversions<T>::binary_type_oid)>>
+  : std::integral_constant<Oid, Conversions<T>::binary_type_oid> {};
+
+} // namespace detail
+
 /**
  * @ingroup conversions
  *
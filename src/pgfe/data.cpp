@@ -14,14 +14,20 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "../base/assert.hpp"
+#include "../str/predicate.hpp"
 #include "data.hpp"
 #include "exceptions.hpp"
-#include "pq.hpp"
 
 #include <algorithm> // swap
 #include <cassert>
 #include <cstring>
-#include <new> // bad_alloc
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+  (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DMITIGR_PGFE_BYTEA_DECODER_SSE2
+#include <emmintrin.h>
+#endif
 
 namespace dmitigr::pgfe::detail {
 
@@ -176,19 +182,148 @@ namespace dmitigr::pgfe {
 
 namespace {
 
-inline std::unique_ptr<pgfe::Data> to_bytea__(const void* const text)
+[[noreturn]] inline void throw_bytea_decoding_error__(const char* const what)
 {
-  if (!text)
-    throw Client_exception{"cannot convert data to bytea: null input data"};
+  throw Client_exception{std::string{"cannot decode bytea: "}.append(what)};
+}
 
-  const auto* const bytes = static_cast<const unsigned char*>(text);
-  std::size_t storage_size{};
-  using Uptr = std::unique_ptr<void, void(*)(void*)>;
-  if (auto storage = Uptr{PQunescapeBytea(bytes, &storage_size), &PQfreemem})
-    return pgfe::Data::make(std::move(storage), storage_size,
-      pgfe::Data_format::binary);
+inline int hex_digit_value__(const char c) noexcept
+{
+  if ('0' <= c && c <= '9')
+    return c - '0';
+  else if ('a' <= c && c <= 'f')
+    return c - 'a' + 10;
+  else if ('A' <= c && c <= 'F')
+    return c - 'A' + 10;
   else
-    throw std::bad_alloc{};
+    return -1;
+}
+
+#ifdef DMITIGR_PGFE_BYTEA_DECODER_SSE2
+/**
+ * @returns The values of the 16 hex digits of `chars`. The bits of `invalid`
+ * are set for characters which are not hex digits.
+ */
+inline __m128i hex_digit_values__(const __m128i chars, int& invalid) noexcept
+{
+  // Signed comparisons reject the characters above 0x7f too.
+  const __m128i lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+  const __m128i is_digit = _mm_and_si128(
+    _mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)),
+    _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+  const __m128i is_letter = _mm_and_si128(
+    _mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+    _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+  invalid |= _mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)) ^ 0xffff;
+  return _mm_or_si128(
+    _mm_and_si128(is_digit, _mm_sub_epi8(chars, _mm_set1_epi8('0'))),
+    _mm_and_si128(is_letter, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+}
+
+/**
+ * @brief Decodes 32 hex digits of `in` into 16 bytes of `out`.
+ *
+ * @returns `false` without touching `out` if `in` contains non hex digits.
+ */
+inline bool decode_hex_block__(const char* const in, unsigned char* const out)
+  noexcept
+{
+  int invalid{};
+  const __m128i first = hex_digit_values__(
+    _mm_loadu_si128(reinterpret_cast<const __m128i*>(in)), invalid);
+  const __m128i second = hex_digit_values__(
+    _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 16)), invalid);
+  if (invalid)
+    return false;
+
+  // Each 16-bit lane holds the high nibble in the low byte and vice versa.
+  const auto to_bytes = [](const __m128i pairs) noexcept
+  {
+    return _mm_or_si128(
+      _mm_slli_epi16(_mm_and_si128(pairs, _mm_set1_epi16(0x00ff)), 4),
+      _mm_srli_epi16(pairs, 8));
+  };
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+    _mm_packus_epi16(to_bytes(first), to_bytes(second)));
+  return true;
+}
+#endif
+
+inline std::size_t decode_bytea_hex__(const char* in, const char* const end,
+  unsigned char* const buffer, const std::size_t buffer_size)
+{
+  auto* out = buffer;
+  auto* const out_end = buffer + buffer_size;
+  while (in != end) {
+#ifdef DMITIGR_PGFE_BYTEA_DECODER_SSE2
+    if (end - in >= 32 && out_end - out >= 16 && decode_hex_block__(in, out)) {
+      in += 32;
+      out += 16;
+      continue;
+    }
+#endif
+    // The whitespaces between the pairs of digits are allowed by PostgreSQL.
+    if (str::is_space(*in)) {
+      ++in;
+      continue;
+    }
+
+    const int high = hex_digit_value__(*in++);
+    const int low = in != end ? hex_digit_value__(*in++) : -1;
+    if (high < 0 || low < 0)
+      throw_bytea_decoding_error__("invalid hexadecimal data");
+    else if (out == out_end)
+      throw_bytea_decoding_error__("buffer is too small");
+    *out++ = static_cast<unsigned char>(high << 4 | low);
+  }
+  return static_cast<std::size_t>(out - buffer);
+}
+
+inline std::size_t decode_bytea_escape__(const char* in, const char* const end,
+  unsigned char* const buffer, const std::size_t buffer_size)
+{
+  const auto is_octal = [](const char c, const char max = '7') noexcept
+  {
+    return '0' <= c && c <= max;
+  };
+
+  auto* out = buffer;
+  auto* const out_end = buffer + buffer_size;
+  while (in != end) {
+    if (out == out_end)
+      throw_bytea_decoding_error__("buffer is too small");
+
+    if (*in != '\\') {
+      *out++ = static_cast<unsigned char>(*in++);
+    } else if (end - in >= 2 && in[1] == '\\') {
+      *out++ = '\\';
+      in += 2;
+    } else if (end - in >= 4 && is_octal(in[1], '3') && is_octal(in[2]) &&
+      is_octal(in[3])) {
+      *out++ = static_cast<unsigned char>(
+        (in[1] - '0') << 6 | (in[2] - '0') << 3 | (in[3] - '0'));
+      in += 4;
+    } else
+      throw_bytea_decoding_error__("invalid escape sequence");
+  }
+  return static_cast<std::size_t>(out - buffer);
+}
+
+inline bool is_bytea_hex__(const std::string_view text_data) noexcept
+{
+  return text_data.size() >= 2 && text_data[0] == '\\' && text_data[1] == 'x';
+}
+
+inline std::unique_ptr<pgfe::Data> to_bytea__(const char* const text,
+  const std::size_t size)
+{
+  const std::string_view text_data{text, size};
+  const auto capacity = Data::decoded_bytea_capacity(text_data);
+  std::unique_ptr<char[]> storage{new char[capacity]};
+  const auto storage_size = Data::decode_bytea(text_data, storage.get(),
+    capacity);
+  return std::make_unique<detail::array_memory_Data>(std::move(storage),
+    storage_size, pgfe::Data_format::binary);
 }
 
 } // namespace
@@ -205,19 +340,42 @@ DMITIGR_PGFE_INLINE std::unique_ptr<Data> Data::to_bytea() const
     throw Client_exception{"cannot convert data to bytea:"
       " invalid input data format"};
 
-  return to_bytea__(bytes());
+  return to_bytea__(static_cast<const char*>(bytes()), size());
 }
 
 DMITIGR_PGFE_INLINE std::unique_ptr<Data>
 Data::to_bytea(const char* const text_data)
 {
-  return to_bytea__(text_data);
+  if (!text_data)
+    throw Client_exception{"cannot convert data to bytea: null input data"};
+
+  return to_bytea__(text_data, std::strlen(text_data));
 }
 
 DMITIGR_PGFE_INLINE std::unique_ptr<Data>
 Data::to_bytea(const std::string& text_data)
 {
-  return to_bytea__(text_data.c_str());
+  return to_bytea__(text_data.data(), text_data.size());
+}
+
+DMITIGR_PGFE_INLINE std::size_t Data::decode_bytea(
+  const std::string_view text_data, void* const buffer,
+  const std::size_t buffer_size)
+{
+  DMITIGR_ASSERT(buffer || !buffer_size);
+  const char* const end = text_data.data() + text_data.size();
+  auto* const out = static_cast<unsigned char*>(buffer);
+  if (is_bytea_hex__(text_data))
+    return decode_bytea_hex__(text_data.data() + 2, end, out, buffer_size);
+  else
+    return decode_bytea_escape__(text_data.data(), end, out, buffer_size);
+}
+
+DMITIGR_PGFE_INLINE std::size_t
+Data::decoded_bytea_capacity(const std::string_view text_data) noexcept
+{
+  return is_bytea_hex__(text_data) ? (text_data.size() - 2) / 2 :
+    text_data.size();
 }
 
 DMITIGR_PGFE_INLINE bool Data::is_invariant_ok() const
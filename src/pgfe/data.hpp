@@ -118,6 +118,33 @@ public:
   static DMITIGR_PGFE_API std::unique_ptr<Data>
   to_bytea(const std::string& text_data);
 
+  /**
+   * @brief Decodes the text representation of the PostgreSQL's Bytea data type
+   * (in either hex or escape format) into the `buffer`.
+   *
+   * @details The hex format is decoded by blocks of 32 characters when SSE2 is
+   * available. The decoded_bytea_capacity() bytes are always enough for the
+   * `buffer` to fit the decoded data.
+   *
+   * @returns The number of bytes written to the `buffer`.
+   *
+   * @par Requires
+   * `buffer || !buffer_size`.
+   *
+   * @throws Client_exception if `text_data` is not a valid representation of
+   * Bytea or if the decoded data does not fit the `buffer`.
+   */
+  static DMITIGR_PGFE_API std::size_t decode_bytea(std::string_view text_data,
+    void* buffer, std::size_t buffer_size);
+
+  /**
+   * @returns The size of the buffer sufficient for decode_bytea() to fit the
+   * decoded `text_data`, i.e. `(text_data.size() - 2) / 2` for the hex format,
+   * or `text_data.size()` for the escape format.
+   */
+  static DMITIGR_PGFE_API std::size_t
+  decoded_bytea_capacity(std::string_view text_data) noexcept;
+
   /// @}
 
   /// @name Observers
@@ -0,0 +1,470 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DMITIGR_PGFE_DECIMAL_HPP
+#define DMITIGR_PGFE_DECIMAL_HPP
+
+// The Decimal is available only if the compiler supports 128-bit integers.
+#ifdef __SIZEOF_INT128__
+
+#include "../net/conversions.hpp"
+#include "basic_conversions.hpp"
+#include "basics.hpp"
+#include "conversions_api.hpp"
+#include "data.hpp"
+#include "exceptions.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace dmitigr::pgfe {
+
+/**
+ * @ingroup conversions
+ *
+ * @brief The fixed-point decimal number (PostgreSQL `numeric`).
+ *
+ * @details The value is represented as `unscaled_value() * 10^-scale()`,
+ * where the unscaled value is the 128-bit integer of at most `max_digit_count`
+ * decimal digits. Thus, the values of `numeric(38, s)` are represented exactly.
+ *
+ * @remarks Available only if the compiler supports `__int128`.
+ */
+class Decimal final {
+public:
+  /// The type of the unscaled value.
+  __extension__ typedef __int128 Unscaled;
+
+  /// The maximum number of decimal digits of the unscaled value.
+  static constexpr int max_digit_count{38};
+
+  /// Constructs zero.
+  constexpr Decimal() noexcept = default;
+
+  /**
+   * @brief Constructs the decimal `unscaled_value * 10^-scale`.
+   *
+   * @par Requires
+   * `0 <= scale && scale <= max_digit_count` and the unscaled value must
+   * have at most `max_digit_count` digits.
+   */
+  Decimal(const Unscaled unscaled_value, const int scale = 0)
+    : unscaled_value_{unscaled_value}
+    , scale_{scale}
+  {
+    if (!(0 <= scale && scale <= max_digit_count))
+      throw Client_exception{"cannot create decimal: invalid scale"};
+    else if (!(-limit() < unscaled_value && unscaled_value < limit()))
+      throw Client_exception{"cannot create decimal: too many digits"};
+  }
+
+  /// @returns The unscaled value.
+  constexpr Unscaled unscaled_value() const noexcept
+  {
+    return unscaled_value_;
+  }
+
+  /// @returns The number of digits after the decimal point.
+  constexpr int scale() const noexcept
+  {
+    return scale_;
+  }
+
+  /**
+   * @returns The decimal with the given `scale`. The value is rounded half
+   * away from zero if the scale is decreased.
+   *
+   * @par Requires
+   * `0 <= scale && scale <= max_digit_count` and the result must have at most
+   * `max_digit_count` digits.
+   */
+  Decimal rescaled(const int scale) const
+  {
+    if (!(0 <= scale && scale <= max_digit_count))
+      throw Client_exception{"cannot rescale decimal: invalid scale"};
+
+    if (scale >= scale_) {
+      const Unscaled factor{power_of_ten(scale - scale_)};
+      if (!(abs(unscaled_value_) < limit() / factor))
+        throw Client_exception{"cannot rescale decimal: too many digits"};
+      return Decimal{unscaled_value_ * factor, scale};
+    } else {
+      const Unscaled divisor{power_of_ten(scale_ - scale)};
+      Unscaled result{unscaled_value_ / divisor};
+      if (2 * abs(unscaled_value_ % divisor) >= divisor)
+        result += unscaled_value_ < 0 ? -1 : 1;
+      return Decimal{result, scale};
+    }
+  }
+
+  /// @returns The nearest value of type `long double`.
+  long double to_long_double() const noexcept
+  {
+    return static_cast<long double>(unscaled_value_) /
+      static_cast<long double>(power_of_ten(scale_));
+  }
+
+  /**
+   * @returns The negative value if `lhs < rhs`, zero if `lhs == rhs`, or
+   * the positive value if `lhs > rhs`.
+   */
+  friend int compare(const Decimal& lhs, const Decimal& rhs) noexcept
+  {
+    const bool is_lhs_less_scaled{lhs.scale_ < rhs.scale_};
+    const Decimal& less_scaled{is_lhs_less_scaled ? lhs : rhs};
+    const Decimal& more_scaled{is_lhs_less_scaled ? rhs : lhs};
+    const Unscaled factor{power_of_ten(more_scaled.scale_ - less_scaled.scale_)};
+    int result{};
+    if (abs(less_scaled.unscaled_value_) < limit() / factor) {
+      const Unscaled value{less_scaled.unscaled_value_ * factor};
+      result = value < more_scaled.unscaled_value_ ? -1 :
+        value > more_scaled.unscaled_value_;
+    } else
+      // The less scaled value is greater in magnitude.
+      result = less_scaled.unscaled_value_ < 0 ? -1 : 1;
+    return is_lhs_less_scaled ? result : -result;
+  }
+
+  /// @returns `compare(lhs, rhs) == 0`.
+  friend bool operator==(const Decimal& lhs, const Decimal& rhs) noexcept
+  {
+    return !compare(lhs, rhs);
+  }
+
+  /// @returns `compare(lhs, rhs) != 0`.
+  friend bool operator!=(const Decimal& lhs, const Decimal& rhs) noexcept
+  {
+    return compare(lhs, rhs);
+  }
+
+  /// @returns `compare(lhs, rhs) < 0`.
+  friend bool operator<(const Decimal& lhs, const Decimal& rhs) noexcept
+  {
+    return compare(lhs, rhs) < 0;
+  }
+
+  /**
+   * @returns `10^exponent`.
+   *
+   * @par Requires
+   * `0 <= exponent && exponent <= max_digit_count`.
+   */
+  static constexpr Unscaled power_of_ten(const int exponent) noexcept
+  {
+    return powers_of_ten_[exponent];
+  }
+
+  /// @returns `10^max_digit_count`.
+  static constexpr Unscaled limit() noexcept
+  {
+    return power_of_ten(max_digit_count);
+  }
+
+private:
+  static constexpr std::array<Unscaled, max_digit_count + 1> powers_of_ten_{[]
+  {
+    std::array<Unscaled, max_digit_count + 1> result{1};
+    for (std::size_t i{1}; i < result.size(); ++i)
+      result[i] = result[i - 1] * 10;
+    return result;
+  }()};
+
+  Unscaled unscaled_value_{};
+  int scale_{};
+
+  static constexpr Unscaled abs(const Unscaled value) noexcept
+  {
+    return value < 0 ? -value : value;
+  }
+};
+
+namespace detail {
+
+/// The implementation of Decimal to/from `std::string` conversions.
+struct Decimal_string_conversions final {
+  using Type = Decimal;
+
+  template<typename ... Types>
+  static Type to_type(const std::string& text, Types&& ...)
+  {
+    return to_type__(text.data(), text.size());
+  }
+
+  template<typename ... Types>
+  static std::string to_string(const Type& value, Types&& ...)
+  {
+    __extension__ typedef unsigned __int128 Unsigned;
+    const auto unscaled = value.unscaled_value();
+    Unsigned magnitude = unscaled < 0 ? -static_cast<Unsigned>(unscaled) :
+      static_cast<Unsigned>(unscaled);
+
+    // The digits are written from the right.
+    char buffer[Decimal::max_digit_count + 3];
+    char* const end{buffer + sizeof(buffer)};
+    char* pos{end};
+    int count{};
+    do {
+      if (count++ == value.scale() && value.scale())
+        *--pos = '.';
+      *--pos = static_cast<char>('0' + static_cast<int>(magnitude % 10));
+      magnitude /= 10;
+    } while (magnitude || count <= value.scale());
+    if (unscaled < 0)
+      *--pos = '-';
+    return std::string(pos, end - pos);
+  }
+
+private:
+  friend struct Decimal_data_conversions;
+
+  /// @returns The decimal parsed from the representation `[{+|-}]D[.D]`.
+  static Type to_type__(const char* const text, const std::size_t size)
+  {
+    const char* pos{text};
+    const char* const end{text + size};
+    const bool is_negative{pos != end && *pos == '-'};
+    if (pos != end && (*pos == '-' || *pos == '+'))
+      ++pos;
+
+    Decimal::Unscaled result{};
+    int digit_count{};
+    int scale{};
+    bool has_digits{};
+    bool has_point{};
+    for (; pos != end; ++pos) {
+      const char c{*pos};
+      if (c == '.' && !has_point) {
+        has_point = true;
+        continue;
+      } else if (!('0' <= c && c <= '9'))
+        throw Client_exception{"cannot convert to decimal: "
+          "invalid text representation"};
+
+      has_digits = true;
+      if ((result || c != '0') && ++digit_count > Decimal::max_digit_count)
+        throw Client_exception{"cannot convert to decimal: too many digits"};
+      result = result*10 + (c - '0');
+      scale += has_point;
+    }
+    if (!has_digits)
+      throw Client_exception{"cannot convert to decimal: "
+        "invalid text representation"};
+    else if (scale > Decimal::max_digit_count)
+      throw Client_exception{"cannot convert to decimal: too large scale"};
+
+    return Decimal{is_negative ? -result : result, scale};
+  }
+};
+
+/**
+ * @brief The implementation of Decimal to/from Data conversions.
+ *
+ * @details The binary format of PostgreSQL `numeric` is:
+ *   -# the number of base-10000 digits (int16);
+ *   -# the weight of the first digit, i.e. its power of 10000 (int16);
+ *   -# the sign (uint16): `0x0000` - positive, `0x4000` - negative, `0xC000` -
+ *   NaN, `0xD000` - infinity, `0xF000` - negative infinity;
+ *   -# the display scale (int16);
+ *   -# the base-10000 digits (int16 each).
+ */
+struct Decimal_data_conversions final {
+  using Type = Decimal;
+
+  template<typename ... Types>
+  static Type to_type(const Data& data, Types&& ...)
+  {
+    const auto* const bytes = static_cast<const char*>(data.bytes());
+    if (data.format() == Data_format::text)
+      return Decimal_string_conversions::to_type__(bytes, data.size());
+
+    using Unscaled = Decimal::Unscaled;
+    const auto size = data.size();
+    if (size < 8)
+      throw Client_exception{"cannot convert to decimal: invalid input size"};
+    const auto digit_count = net::conv<std::int16_t>(bytes, 2);
+    const auto weight = net::conv<std::int16_t>(bytes + 2, 2);
+    const auto sign = net::conv<std::uint16_t>(bytes + 4, 2);
+    const auto scale = net::conv<std::int16_t>(bytes + 6, 2);
+    if (sign == 0xC000)
+      throw Client_exception{"cannot convert to decimal: NaN"};
+    else if (sign == 0xD000 || sign == 0xF000)
+      throw Client_exception{"cannot convert to decimal: infinity"};
+    else if (!(sign == 0x0000 || sign == 0x4000) || digit_count < 0 ||
+      size != 8 + 2 * static_cast<std::size_t>(digit_count))
+      throw Client_exception{"cannot convert to decimal: "
+        "invalid binary representation"};
+    else if (!(0 <= scale && scale <= Decimal::max_digit_count))
+      throw Client_exception{"cannot convert to decimal: too large scale"};
+
+    /*
+     * Accumulate the digits scaled to the display scale. The digits beyond the
+     * display scale (if any) are dropped.
+     */
+    Unscaled result{};
+    int unit{}; // the power of ten of the last accumulated digit
+    for (int i{}; i < digit_count; ++i) {
+      auto digit = net::conv<std::int16_t>(bytes + 8 + 2*i, 2);
+      if (!(0 <= digit && digit < 10000))
+        throw Client_exception{"cannot convert to decimal: "
+          "invalid binary representation"};
+
+      const int digit_unit{4*(weight - i) + scale};
+      if (digit_unit <= -4)
+        break;
+
+      int width{4};
+      if (digit_unit < 0) {
+        digit /= static_cast<std::int16_t>(Decimal::power_of_ten(-digit_unit));
+        width += digit_unit;
+      }
+      // Since digit < 10^width, the result fits if result < 10^(38 - width).
+      if (!(result < Decimal::power_of_ten(Decimal::max_digit_count - width)))
+        throw Client_exception{"cannot convert to decimal: too many digits"};
+      result = result*Decimal::power_of_ten(width) + digit;
+      unit = digit_unit > 0 ? digit_unit : 0;
+    }
+    if (result && unit) {
+      if (!(unit < Decimal::max_digit_count &&
+          result < Decimal::power_of_ten(Decimal::max_digit_count - unit)))
+        throw Client_exception{"cannot convert to decimal: too many digits"};
+      result *= Decimal::power_of_ten(unit);
+    }
+    return Decimal{sign == 0x4000 ? -result : result, scale};
+  }
+
+  template<typename ... Types>
+  static Type to_type(std::unique_ptr<Data>&& data, Types&& ...)
+  {
+    if (!data)
+      throw Client_exception{"cannot convert to decimal: null data given"};
+    return to_type(*data);
+  }
+
+  template<typename ... Types>
+  static std::unique_ptr<Data> to_data(const Type& value, Types&& ...)
+  {
+    return Data::make(Decimal_string_conversions::to_string(value),
+      Data_format::text);
+  }
+
+  template<typename ... Types>
+  static std::unique_ptr<Data> to_data(const Type& value,
+    const Data_format format, Types&& ...)
+  {
+    if (format == Data_format::text)
+      return to_data(value);
+
+    using Unscaled = Decimal::Unscaled;
+    const auto unscaled = value.unscaled_value();
+    const int scale{value.scale()};
+    const Unscaled divisor{Decimal::power_of_ten(scale)};
+    Unscaled integral{(unscaled < 0 ? -unscaled : unscaled) / divisor};
+    Unscaled fractional{(unscaled < 0 ? -unscaled : unscaled) % divisor};
+
+    /*
+     * Split the value into base-10000 digits aligned at the decimal point.
+     * Since at most 38 decimal digits are possible, at most 11 digits are
+     * needed for the integral part and 10 digits for the fractional part.
+     */
+    std::int16_t digits[2 + Decimal::max_digit_count / 4 * 2];
+    int fractional_count{};
+    {
+      std::int16_t reversed[1 + Decimal::max_digit_count / 4];
+      if (const int remainder{scale % 4}) {
+        // The last digit is partial, so pad it with zeros.
+        const Unscaled partial{Decimal::power_of_ten(remainder)};
+        reversed[fractional_count++] = static_cast<std::int16_t>(
+          fractional % partial * Decimal::power_of_ten(4 - remainder));
+        fractional /= partial;
+      }
+      for (int i{scale / 4}; i > 0; --i) {
+        reversed[fractional_count++] = static_cast<std::int16_t>(fractional % 10000);
+        fractional /= 10000;
+      }
+      for (int i{}; i < fractional_count; ++i)
+        digits[sizeof(digits)/sizeof(*digits) - fractional_count + i] =
+          reversed[fractional_count - 1 - i];
+    }
+    int integral_count{};
+    for (; integral; integral /= 10000)
+      digits[sizeof(digits)/sizeof(*digits) - fractional_count - ++integral_count] =
+        static_cast<std::int16_t>(integral % 10000);
+
+    // Strip the leading and trailing zero digits.
+    const std::int16_t* first{digits + sizeof(digits)/sizeof(*digits) -
+      fractional_count - integral_count};
+    const std::int16_t* last{digits + sizeof(digits)/sizeof(*digits)};
+    int weight{integral_count - 1};
+    for (; first != last && !*first; ++first)
+      --weight;
+    for (; first != last && !*(last - 1); --last);
+    if (first == last)
+      weight = 0;
+
+    std::string result;
+    result.reserve(8 + 2*(last - first));
+    append__(result, static_cast<std::int16_t>(last - first));
+    append__(result, static_cast<std::int16_t>(weight));
+    append__(result, static_cast<std::uint16_t>(unscaled < 0 ? 0x4000 : 0));
+    append__(result, static_cast<std::int16_t>(scale));
+    for (; first != last; ++first)
+      append__(result, *first);
+    return Data::make(std::move(result), Data_format::binary);
+  }
+
+private:
+  template<typename T>
+  static void append__(std::string& result, const T value)
+  {
+    char buffer[sizeof(value)];
+    net::copy(buffer, sizeof(buffer), value);
+    result.append(buffer, sizeof(buffer));
+  }
+};
+
+} // namespace detail
+
+/**
+ * @ingroup conversions
+ *
+ * @brief Full specialization of Conversions for Decimal.
+ *
+ * @details Support of the following data formats is implemented for:
+ *   - input data  - Data_format::text, Data_format::binary;
+ *   - output data - Data_format::text, Data_format::binary.
+ *
+ * @par Requires
+ * The input data must represent the finite number of at most
+ * `Decimal::max_digit_count` digits.
+ */
+template<>
+struct Conversions<Decimal> final : Basic_conversions<Decimal,
+  detail::Decimal_string_conversions, detail::Decimal_data_conversions> {
+  /// The OID of `numeric`.
+  static constexpr Oid binary_type_oid{1700};
+
+  /// `true` since the output data can be in Data_format::binary.
+  static constexpr bool is_binary_data_convertible{true};
+};
+
+} // namespace dmitigr::pgfe
+
+#endif  // __SIZEOF_INT128__
+
+#endif  // DMITIGR_PGFE_DECIMAL_HPP
@@ -0,0 +1,656 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DMITIGR_PGFE_FLAT_ARRAY_HPP
+#define DMITIGR_PGFE_FLAT_ARRAY_HPP
+
+#include "../base/assert.hpp"
+#include "../net/conversions.hpp"
+#include "../str/c_str.hpp"
+#include "array_conversions.hpp"
+#include "basics.hpp"
+#include "conversions_api.hpp"
+#include "data.hpp"
+#include "exceptions.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dmitigr::pgfe {
+
+/**
+ * @ingroup conversions
+ *
+ * @brief A multidimensional array stored in the single contiguous buffer.
+ *
+ * @details Unlike the nested containers of optionals (see Array_optional2 and
+ * friends) the elements of all the dimensions are stored in the single
+ * `std::vector<T>` in row-major order, and NULLs are denoted by the separate
+ * bitmap. Thus, the conversion of the array of `N` elements of trivial type
+ * requires just one allocation.
+ *
+ * The elements are accessed by the zero-based indexes. The lower bounds are
+ * only used to represent the array in PostgreSQL.
+ *
+ * @tparam T The type of elements.
+ */
+template<typename T>
+class Flat_array final {
+public:
+  /// The type of elements.
+  using Value_type = T;
+
+  /// The type of the buffer of elements.
+  using Values = std::vector<T>;
+
+  /// The maximum number of dimensions.
+  static constexpr int max_dimension_count{detail::max_array_dimension_count};
+
+  /// Constructs the empty array.
+  Flat_array() = default;
+
+  /// Constructs the 1-dimensional array of non-NULL `values`.
+  explicit Flat_array(Values values)
+    : Flat_array{{static_cast<int>(values.size())}, std::move(values)}
+  {}
+
+  /**
+   * @brief Constructs the array of the specified `extents` and `values`.
+   *
+   * @param extents The sizes of the dimensions.
+   * @param values The values in row-major order.
+   * @param nulls The NULL bitmap. (Empty bitmap denotes the absence of NULLs.)
+   *
+   * @par Requires
+   * `extents.size() <= max_dimension_count`, the product of `extents` must
+   * be equal to `values.size()`, `nulls.empty() || nulls.size() == values.size()`.
+   *
+   * @par Effects
+   * `lower_bound(i) == 1` for each dimension `i`.
+   */
+  Flat_array(const std::vector<int>& extents, Values values,
+    std::vector<bool> nulls = {})
+    : values_{std::move(values)}
+    , nulls_{std::move(nulls)}
+  {
+    if (!(extents.size() <= static_cast<std::size_t>(max_dimension_count)))
+      throw Client_exception{"cannot create flat array: "
+        "too many dimensions"};
+    else if (!(nulls_.empty() || nulls_.size() == values_.size()))
+      throw Client_exception{"cannot create flat array: "
+        "invalid size of NULL bitmap"};
+
+    std::size_t size{extents.empty() ? 0u : 1u};
+    for (const int extent : extents) {
+      if (extent < 0)
+        throw Client_exception{"cannot create flat array: negative extent"};
+      size *= static_cast<std::size_t>(extent);
+    }
+    if (size != values_.size())
+      throw Client_exception{"cannot create flat array: "
+        "number of values doesn't match the extents"};
+
+    dimension_count_ = static_cast<int>(extents.size());
+    for (int i{}; i < dimension_count_; ++i) {
+      extents_[i] = extents[i];
+      lower_bounds_[i] = 1;
+    }
+  }
+
+  /// @returns The number of dimensions.
+  int dimension_count() const noexcept
+  {
+    return dimension_count_;
+  }
+
+  /**
+   * @returns The number of elements in the dimension `dimension`.
+   *
+   * @par Requires
+   * `dimension < dimension_count()`.
+   */
+  int extent(const int dimension) const noexcept
+  {
+    DMITIGR_ASSERT(0 <= dimension && dimension < dimension_count_);
+    return extents_[dimension];
+  }
+
+  /**
+   * @returns The lower bound of the dimension `dimension`.
+   *
+   * @par Requires
+   * `dimension < dimension_count()`.
+   */
+  int lower_bound(const int dimension) const noexcept
+  {
+    DMITIGR_ASSERT(0 <= dimension && dimension < dimension_count_);
+    return lower_bounds_[dimension];
+  }
+
+  /**
+   * @brief Sets the lower bound of the dimension `dimension`.
+   *
+   * @par Requires
+   * `dimension < dimension_count()`.
+   */
+  void set_lower_bound(const int dimension, const int value) noexcept
+  {
+    DMITIGR_ASSERT(0 <= dimension && dimension < dimension_count_);
+    lower_bounds_[dimension] = value;
+  }
+
+  /// @returns The total number of elements.
+  std::size_t size() const noexcept
+  {
+    return values_.size();
+  }
+
+  /// @returns `!size()`.
+  bool is_empty() const noexcept
+  {
+    return values_.empty();
+  }
+
+  /// @returns The buffer of elements in row-major order.
+  const Values& values() const noexcept
+  {
+    return values_;
+  }
+
+  /// @returns The released buffer of elements.
+  Values release_values() noexcept
+  {
+    Values result;
+    values_.swap(result);
+    nulls_.clear();
+    dimension_count_ = 0;
+    return result;
+  }
+
+  /// @returns `true` if there is at least one NULL element.
+  bool has_nulls() const noexcept
+  {
+    for (const bool is_null : nulls_)
+      if (is_null)
+        return true;
+    return false;
+  }
+
+  /**
+   * @returns `true` if the element at the `index` of the buffer is NULL.
+   *
+   * @par Requires
+   * `index < size()`.
+   */
+  bool is_null(const std::size_t index) const noexcept
+  {
+    DMITIGR_ASSERT(index < size());
+    return !nulls_.empty() && nulls_[index];
+  }
+
+  /**
+   * @brief Marks the element at the `index` of the buffer as NULL or not NULL.
+   *
+   * @par Requires
+   * `index < size()`.
+   */
+  void set_null(const std::size_t index, const bool value = true)
+  {
+    DMITIGR_ASSERT(index < size());
+    if (nulls_.empty()) {
+      if (!value)
+        return;
+      nulls_.resize(values_.size());
+    }
+    nulls_[index] = value;
+  }
+
+  /**
+   * @returns The index of the element of the buffer at the specified
+   * zero-based `indexes` of each dimension.
+   *
+   * @par Requires
+   * `sizeof...(indexes) == dimension_count()` and each index must be less than
+   * the extent of the corresponding dimension.
+   */
+  template<typename ... Indexes>
+  std::size_t index(const Indexes ... indexes) const noexcept
+  {
+    static_assert(sizeof...(Indexes) > 0 &&
+      (std::is_integral_v<Indexes> && ...));
+    DMITIGR_ASSERT(sizeof...(indexes) == static_cast<std::size_t>(dimension_count_));
+    const long long idxs[]{static_cast<long long>(indexes)...};
+    std::size_t result{};
+    for (int i{}; i < dimension_count_; ++i) {
+      DMITIGR_ASSERT(0 <= idxs[i] && idxs[i] < extents_[i]);
+      result = result * static_cast<std::size_t>(extents_[i]) +
+        static_cast<std::size_t>(idxs[i]);
+    }
+    return result;
+  }
+
+  /**
+   * @returns The element at the `index` of the buffer.
+   *
+   * @par Requires
+   * `index < size()`.
+   */
+  decltype(auto) operator[](const std::size_t index) noexcept
+  {
+    DMITIGR_ASSERT(index < size());
+    return values_[index];
+  }
+
+  /// @overload
+  decltype(auto) operator[](const std::size_t index) const noexcept
+  {
+    DMITIGR_ASSERT(index < size());
+    return values_[index];
+  }
+
+  /**
+   * @returns The element at the specified zero-based `indexes` of each
+   * dimension.
+   *
+   * @par Requires
+   * See index().
+   */
+  template<typename ... Indexes>
+  decltype(auto) operator()(const Indexes ... indexes) noexcept
+  {
+    return values_[index(indexes...)];
+  }
+
+  /// @overload
+  template<typename ... Indexes>
+  decltype(auto) operator()(const Indexes ... indexes) const noexcept
+  {
+    return values_[index(indexes...)];
+  }
+
+private:
+  int dimension_count_{};
+  std::array<int, max_dimension_count> extents_{};
+  std::array<int, max_dimension_count> lower_bounds_{};
+  Values values_;
+  std::vector<bool> nulls_;
+};
+
+namespace detail {
+
+/**
+ * @brief The handler of parse_array_literal() which fills the buffer of
+ * Flat_array and infers the extents of the array.
+ */
+template<typename T>
+class Flat_array_filler final {
+public:
+  void operator()(const int dimension)
+  {
+    if (!(dimension < max_array_dimension_count))
+      throw Client_exception{Client_errc::excessive_dimensionality};
+    ++open_counts_[dimension];
+    if (count_)
+      finish_subarray__();
+  }
+
+  template<typename ... Types>
+  void operator()(const std::string_view value, const bool is_null,
+    const int dimension, Types&& ... args)
+  {
+    if (!element_dimension_)
+      element_dimension_ = dimension;
+    else if (dimension != element_dimension_)
+      throw Client_exception{Client_errc::malformed_literal};
+
+    ++count_;
+    nulls_.push_back(is_null);
+    if (is_null)
+      values_.emplace_back();
+    else
+      values_.push_back(to_array_element<T>(value,
+          std::forward<Types>(args)...));
+  }
+
+  /// @returns The array filled.
+  Flat_array<T> finish()
+  {
+    finish_subarray__();
+    std::vector<int> extents;
+    if (element_dimension_) {
+      extents.resize(static_cast<std::size_t>(element_dimension_));
+      for (int i{}; i + 1 < element_dimension_; ++i) {
+        if (open_counts_[i + 1] % open_counts_[i])
+          throw Client_exception{Client_errc::malformed_literal};
+        extents[i] = open_counts_[i + 1] / open_counts_[i];
+      }
+      extents.back() = deepest_extent_;
+    }
+    bool has_nulls{};
+    for (const bool is_null : nulls_)
+      has_nulls = has_nulls || is_null;
+    if (!has_nulls)
+      nulls_.clear();
+    return Flat_array<T>{extents, std::move(values_), std::move(nulls_)};
+  }
+
+private:
+  int element_dimension_{};
+  int open_counts_[max_array_dimension_count]{};
+  int count_{};
+  int deepest_extent_{-1};
+  std::vector<T> values_;
+  std::vector<bool> nulls_;
+
+  void finish_subarray__()
+  {
+    if (element_dimension_) {
+      if (deepest_extent_ < 0)
+        deepest_extent_ = count_;
+      else if (count_ != deepest_extent_)
+        throw Client_exception{Client_errc::malformed_literal};
+    }
+    count_ = 0;
+  }
+};
+
+/// Flat_array to/from `std::string` conversions.
+template<typename T>
+struct Flat_array_string_conversions final {
+  using Type = Flat_array<T>;
+
+  /**
+   * @returns The array converted from the PostgreSQL array `literal` with
+   * the optional dimension decoration, e.g. `[0:1]={1,2}`.
+   */
+  template<typename ... Types>
+  static Type to_type(const char* literal, Types&& ... args)
+  {
+    DMITIGR_ASSERT(literal);
+
+    // Parse the dimension decoration.
+    std::vector<std::pair<int, int>> bounds;
+    literal = str::next_non_space_pointer(literal);
+    while (*literal == '[') {
+      char* end{};
+      const long lower = std::strtol(literal + 1, &end, 10);
+      if (*end != ':')
+        throw Client_exception{Client_errc::malformed_literal};
+      const long upper = std::strtol(end + 1, &end, 10);
+      if (*end != ']')
+        throw Client_exception{Client_errc::malformed_literal};
+      bounds.emplace_back(static_cast<int>(lower), static_cast<int>(upper));
+      literal = end + 1;
+      if (*literal == '=')
+        ++literal;
+    }
+
+    Flat_array_filler<T> filler;
+    parse_array_literal(literal, literal + std::strlen(literal), ',', filler,
+      std::forward<Types>(args)...);
+    auto result = filler.finish();
+
+    if (!bounds.empty()) {
+      if (static_cast<int>(bounds.size()) != result.dimension_count())
+        throw Client_exception{Client_errc::malformed_literal};
+      for (int i{}; i < result.dimension_count(); ++i) {
+        const auto [lower, upper] = bounds[i];
+        if (upper - lower + 1 != result.extent(i))
+          throw Client_exception{Client_errc::malformed_literal};
+        result.set_lower_bound(i, lower);
+      }
+    }
+    return result;
+  }
+
+  /// @overload
+  template<typename ... Types>
+  static Type to_type(const std::string& literal, Types&& ... args)
+  {
+    return to_type(literal.c_str(), std::forward<Types>(args)...);
+  }
+
+  /// @returns The PostgreSQL array literal converted from the `value`.
+  template<typename ... Types>
+  static std::string to_string(const Type& value, Types&& ... args)
+  {
+    std::string result;
+    if (value.is_empty())
+      return result.append("{}");
+
+    // Decorate with the dimensions if the lower bounds are not default.
+    const int dimension_count{value.dimension_count()};
+    bool is_default_bounds{true};
+    for (int i{}; i < dimension_count; ++i)
+      is_default_bounds = is_default_bounds && value.lower_bound(i) == 1;
+    if (!is_default_bounds) {
+      for (int i{}; i < dimension_count; ++i) {
+        const int lower{value.lower_bound(i)};
+        result.append("[").append(std::to_string(lower)).append(":")
+          .append(std::to_string(lower + value.extent(i) - 1)).append("]");
+      }
+      result += '=';
+    }
+
+    /*
+     * Write the elements with the braces. The counters of the positions in
+     * each dimension are used to determine where to open and close the braces.
+     */
+    std::array<int, max_array_dimension_count> positions{};
+    result.append(static_cast<std::size_t>(dimension_count), '{');
+    const std::size_t size{value.size()};
+    for (std::size_t i{}; i < size; ++i) {
+      if (value.is_null(i))
+        result.append("NULL");
+      else {
+        result += '"';
+        for (const char c : Conversions<T>::to_string(value[i], args...)) {
+          if (c == '"' || c == '\\')
+            result += '\\';
+          result += c;
+        }
+        result += '"';
+      }
+
+      // Advance the positions starting from the deepest dimension.
+      int closed{};
+      for (int d{dimension_count - 1}; d >= 0; --d) {
+        if (++positions[d] < value.extent(d))
+          break;
+        positions[d] = 0;
+        ++closed;
+      }
+      result.append(static_cast<std::size_t>(closed), '}');
+      if (i + 1 < size) {
+        result += ',';
+        result.append(static_cast<std::size_t>(closed), '{');
+      }
+    }
+    return result;
+  }
+};
+
+/// Flat_array to/from Data conversions.
+template<typename T>
+struct Flat_array_data_conversions final {
+  using Type = Flat_array<T>;
+
+  /// `true` if the output data can be in Data_format::binary.
+  static constexpr bool is_binary_data_convertible{
+    Binary_type_oid<T>::value != invalid_oid};
+
+  template<typename ... Types>
+  static Type to_type(const Data& data, Types&& ... args)
+  {
+    if (data.format() == Data_format::text)
+      return Flat_array_string_conversions<T>::to_type(
+        static_cast<const char*>(data.bytes()), std::forward<Types>(args)...);
+
+    const char* bytes = static_cast<const char*>(data.bytes());
+    const char* const end = bytes + data.size();
+    const auto header = read_binary_array_header(bytes, end);
+    check_binary_array_element_type<T>(header.element_type_oid);
+    std::vector<int> extents(header.dimensions,
+      header.dimensions + header.dimension_count);
+    std::size_t size{header.dimension_count ? 1u : 0u};
+    for (const int extent : extents)
+      size *= static_cast<std::size_t>(extent);
+
+    std::vector<T> values;
+    std::vector<bool> nulls;
+    values.reserve(size);
+    if (header.has_nulls)
+      nulls.resize(size);
+    for (std::size_t i{}; i < size; ++i) {
+      const auto length = read_binary_int32(bytes, end);
+      if (length < 0) {
+        if (nulls.empty())
+          throw Client_exception{Client_errc::malformed_literal};
+        nulls[i] = true;
+        values.emplace_back();
+      } else if (end - bytes < length)
+        throw Client_exception{Client_errc::malformed_literal};
+      else {
+        const auto sz = static_cast<std::size_t>(length);
+        if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+          // Fast path without the intermediate Data_view.
+          if (sz != sizeof(T))
+            throw Client_exception{"cannot convert to numeric: "
+              "unexpected size of binary data"};
+          values.push_back(net::conv<T>(bytes, sz));
+        } else
+          values.push_back(Conversions<T>::to_type(Data_view{bytes, sz,
+            Data_format::binary}, args...));
+        bytes += length;
+      }
+    }
+    if (bytes != end)
+      throw Client_exception{Client_errc::malformed_literal};
+
+    Type result{extents, std::move(values), std::move(nulls)};
+    for (int i{}; i < header.dimension_count; ++i)
+      result.set_lower_bound(i, header.lower_bounds[i]);
+    return result;
+  }
+
+  template<typename ... Types>
+  static Type to_type(std::unique_ptr<Data>&& data, Types&& ... args)
+  {
+    if (!data)
+      throw Client_exception{"cannot convert array to native type: "
+        "null data given"};
+    return to_type(*data, std::forward<Types>(args)...);
+  }
+
+  template<typename ... Types>
+  static std::unique_ptr<Data> to_data(const Type& value, Types&& ... args)
+  {
+    return Data::make(Flat_array_string_conversions<T>::to_string(value,
+      std::forward<Types>(args)...), Data_format::text);
+  }
+
+  template<typename ... Types>
+  static std::unique_ptr<Data> to_data(const Type& value,
+    const Data_format format, Types&& ... args)
+  {
+    if (format == Data_format::text)
+      return to_data(value, std::forward<Types>(args)...);
+
+    if constexpr (is_binary_data_convertible) {
+      const bool is_empty{value.is_empty()};
+      std::string result;
+      write_binary_int32(result, is_empty ? 0 : value.dimension_count());
+      write_binary_int32(result, value.has_nulls());
+      write_binary_int32(result,
+        static_cast<std::int32_t>(Binary_type_oid<T>::value));
+      if (is_empty)
+        return Data::make(std::move(result), Data_format::binary);
+
+      for (int i{}; i < value.dimension_count(); ++i) {
+        write_binary_int32(result, value.extent(i));
+        write_binary_int32(result, value.lower_bound(i));
+      }
+      const std::size_t size{value.size()};
+      if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)
+        result.reserve(result.size() + size * (4 + sizeof(T)));
+      const auto append = [&result](const void* const bytes,
+        const std::size_t size)
+      {
+        if (size > static_cast<std::size_t>(
+            std::numeric_limits<std::int32_t>::max()))
+          throw Client_exception{"cannot convert array to binary data: "
+            "too large element"};
+        write_binary_int32(result, static_cast<std::int32_t>(size));
+        result.append(static_cast<const char*>(bytes), size);
+      };
+      for (std::size_t i{}; i < size; ++i) {
+        if (value.is_null(i))
+          write_binary_int32(result, -1);
+        else if constexpr (std::is_same_v<T, std::string>)
+          append(value[i].data(), value[i].size());
+        else if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+          char buffer[sizeof(T)];
+          net::copy(buffer, sizeof(buffer), value[i]);
+          append(buffer, sizeof(buffer));
+        } else {
+          const T& element = value[i];
+          const auto data = Conversions<T>::to_data(element,
+            Data_format::binary, args...);
+          append(data->bytes(), data->size());
+        }
+      }
+      return Data::make(std::move(result), Data_format::binary);
+    } else
+      throw Client_exception{"cannot convert array to binary data: "
+        "unsupported type of elements"};
+  }
+};
+
+} // namespace detail
+
+/**
+ * @ingroup conversions
+ *
+ * @brief The partial specialization of Conversions for Flat_array.
+ *
+ * @details The support of the following data formats is implemented for:
+ *   - input data  - Data_format::text, Data_format::binary;
+ *   - output data - Data_format::text, Data_format::binary (if there is
+ *   the PostgreSQL type of the binary representation of `T`, see
+ *   Conversions).
+ */
+template<typename T>
+struct Conversions<Flat_array<T>> final : Basic_conversions<Flat_array<T>,
+  detail::Flat_array_string_conversions<T>,
+  detail::Flat_array_data_conversions<T>> {
+  /// `true` if the output data can be in Data_format::binary.
+  static constexpr bool is_binary_data_convertible{
+    detail::Flat_array_data_conversions<T>::is_binary_data_convertible};
+};
+
+} // namespace dmitigr::pgfe
+
+#endif  // DMITIGR_PGFE_FLAT_ARRAY_HPP
@@ -0,0 +1,537 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DMITIGR_PGFE_NETWORK_ADDRESS_HPP
+#define DMITIGR_PGFE_NETWORK_ADDRESS_HPP
+
+#include "../net/address.hpp"
+#include "basic_conversions.hpp"
+#include "basics.hpp"
+#include "conversions_api.hpp"
+#include "data.hpp"
+#include "exceptions.hpp"
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace dmitigr::pgfe {
+
+/**
+ * @ingroup conversions
+ *
+ * @brief The IP host address with the optional network mask (PostgreSQL
+ * `inet` and `cidr`).
+ *
+ * @details The network mask is represented by the number of the leading bits
+ * of the address which identify the network (the prefix length). The host
+ * address has the prefix length of 32 for IPv4 and 128 for IPv6.
+ */
+class Inet final {
+public:
+  /// Constructs invalid instance.
+  Inet() noexcept = default;
+
+  /**
+   * @brief Constructs the host address.
+   *
+   * @par Requires
+   * `address.is_valid()`.
+   */
+  explicit Inet(const net::Ip_address& address)
+    : Inet{address, max_prefix_length(address)}
+  {}
+
+  /**
+   * @brief The constructor.
+   *
+   * @par Requires
+   * `address.is_valid() && (0 <= prefix_length &&
+   * prefix_length <= max_prefix_length(address))`.
+   */
+  Inet(const net::Ip_address& address, const int prefix_length)
+    : address_{address}
+    , prefix_length_{prefix_length}
+  {
+    if (!address.is_valid())
+      throw Client_exception{"cannot create inet: invalid IP address"};
+    else if (!(0 <= prefix_length &&
+        prefix_length <= max_prefix_length(address)))
+      throw Client_exception{"cannot create inet: invalid prefix length"};
+  }
+
+  /// @returns The maximum prefix length for the `address`.
+  static int max_prefix_length(const net::Ip_address& address) noexcept
+  {
+    return address.family() == net::Protocol_family::ipv4 ? 32 : 128;
+  }
+
+  /// @returns `true` if this instance is valid.
+  bool is_valid() const noexcept
+  {
+    return address_.is_valid();
+  }
+
+  /// @returns The address.
+  const net::Ip_address& address() const noexcept
+  {
+    return address_;
+  }
+
+  /// @returns The prefix length of the network mask.
+  int prefix_length() const noexcept
+  {
+    return prefix_length_;
+  }
+
+  /// @returns `true` if this instance represents the host address.
+  bool is_host() const noexcept
+  {
+    return is_valid() && prefix_length_ == max_prefix_length(address_);
+  }
+
+  /// @returns `true` if `lhs` is equals to `rhs`.
+  friend bool operator==(const Inet& lhs, const Inet& rhs) noexcept
+  {
+    return lhs.address_ == rhs.address_ &&
+      lhs.prefix_length_ == rhs.prefix_length_;
+  }
+
+  /// @returns `true` if `lhs` is not equals to `rhs`.
+  friend bool operator!=(const Inet& lhs, const Inet& rhs) noexcept
+  {
+    return !(lhs == rhs);
+  }
+
+private:
+  net::Ip_address address_;
+  int prefix_length_{};
+};
+
+/**
+ * @ingroup conversions
+ *
+ * @brief The MAC address (PostgreSQL `macaddr`).
+ */
+class Mac_address final {
+public:
+  /// The type of the binary representation.
+  using Bytes = std::array<std::uint8_t, 6>;
+
+  /// Constructs the address of all zeros.
+  constexpr Mac_address() noexcept = default;
+
+  /// Constructs the address from its binary representation.
+  constexpr explicit Mac_address(const Bytes& bytes) noexcept
+    : bytes_{bytes}
+  {}
+
+  /// @returns The binary representation.
+  constexpr const Bytes& bytes() const noexcept
+  {
+    return bytes_;
+  }
+
+  /// @returns `true` if `lhs` is equals to `rhs`.
+  friend bool operator==(const Mac_address& lhs, const Mac_address& rhs) noexcept
+  {
+    return lhs.bytes_ == rhs.bytes_;
+  }
+
+  /// @returns `true` if `lhs` is not equals to `rhs`.
+  friend bool operator!=(const Mac_address& lhs, const Mac_address& rhs) noexcept
+  {
+    return !(lhs == rhs);
+  }
+
+  /// @returns `true` if `lhs` is less than `rhs`.
+  friend bool operator<(const Mac_address& lhs, const Mac_address& rhs) noexcept
+  {
+    return lhs.bytes_ < rhs.bytes_;
+  }
+
+private:
+  Bytes bytes_{};
+};
+
+namespace detail {
+
+/// The implementation of Inet to/from `std::string` conversions.
+struct Inet_string_conversions final {
+  using Type = Inet;
+
+  template<typename ... Types>
+  static Type to_type(const std::string& text, Types&& ...)
+  {
+    return to_type__(text.data(), text.size());
+  }
+
+  /// @returns The representation like `192.168.0.1` or `10.0.0.0/8`.
+  template<typename ... Types>
+  static std::string to_string(const Type& value, Types&& ...)
+  {
+    if (!value.is_valid())
+      throw Client_exception{"cannot convert inet to string: invalid inet"};
+
+    auto result = value.address().to_string();
+    if (!value.is_host())
+      result.append(1, '/').append(std::to_string(value.prefix_length()));
+    return result;
+  }
+
+private:
+  friend struct Inet_data_conversions;
+
+  /// @returns The inet parsed from the representation `address[/prefix]`.
+  static Type to_type__(const char* const text, const std::size_t size)
+  {
+    const char* const end{text + size};
+    const char* const slash{static_cast<const char*>(
+        std::memchr(text, '/', size))};
+    const auto address = net::Ip_address::from_text(std::string{text,
+        slash ? slash : end});
+    if (!address)
+      throw Client_exception{"cannot convert to inet: "
+        "invalid text representation"};
+    else if (!slash)
+      return Inet{address};
+
+    int prefix_length{};
+    const auto [ptr, ec] = std::from_chars(slash + 1, end, prefix_length);
+    if (ec != std::errc{} || ptr != end || slash + 1 == end || !(0 <= prefix_length
+        && prefix_length <= Inet::max_prefix_length(address)))
+      throw Client_exception{"cannot convert to inet: "
+        "invalid text representation"};
+    return Inet{address, prefix_length};
+  }
+};
+
+/**
+ * @brief The implementation of Inet to/from Data conversions.
+ *
+ * @details The binary format of PostgreSQL `inet` and `cidr` is:
+ *   -# the family (uint8): `2` - IPv4, `3` - IPv6;
+ *   -# the prefix length (uint8);
+ *   -# the flag of `cidr` (uint8), which is ignored by the server;
+ *   -# the size of the address (uint8): `4` - IPv4, `16` - IPv6;
+ *   -# the address in network byte order.
+ */
+struct Inet_data_conversions final {
+  using Type = Inet;
+
+  template<typename ... Types>
+  static Type to_type(const Data& data, Types&& ...)
+  {
+    const auto* const bytes = static_cast<const char*>(data.bytes());
+    if (data.format() == Data_format::text)
+      return Inet_string_conversions::to_type__(bytes, data.size());
+
+    const auto size = data.size();
+    if (!(size == 8 || size == 20) ||
+      static_cast<std::size_t>(bytes[3]) != size - 4 ||
+      bytes[0] != (size == 8 ? ipv4_family_ : ipv6_family_))
+      throw Client_exception{"cannot convert to inet: "
+        "invalid binary representation"};
+
+    const auto address = net::Ip_address::from_binary({bytes + 4, size - 4});
+    const int prefix_length{static_cast<unsigned char>(bytes[1])};
+    if (!(prefix_length <= Inet::max_prefix_length(address)))
+      throw Client_exception{"cannot convert to inet: "
+        "invalid binary representation"};
+    return Inet{address, prefix_length};
+  }
+
+  template<typename ... Types>
+  static Type to_type(std::unique_ptr<Data>&& data, Types&& ...)
+  {
+    if (!data)
+      throw Client_exception{"cannot convert to inet: null data given"};
+    return to_type(*data);
+  }
+
+  template<typename ... Types>
+  static std::unique_ptr<Data> to_data(const Type& value, Types&& ...)
+  {
+    return Data::make(Inet_string_conversions::to_string(value),
+      Data_format::text);
+  }
+
+  template<typename ... Types>
+  static std::unique_ptr<Data> to_data(const Type& value,
+    const Data_format format, Types&& ...)
+  {
+    if (format == Data_format::text)
+      return to_data(value);
+    else if (!value.is_valid())
+      throw Client_exception{"cannot convert inet to data: invalid inet"};
+
+    const bool is_ipv4{value.address().family() == net::Protocol_family::ipv4};
+    const std::size_t address_size{is_ipv4 ? 4u : 16u};
+    char result[20];
+    result[0] = is_ipv4 ? ipv4_family_ : ipv6_family_;
+    result[1] = static_cast<char>(value.prefix_length());
+    result[2] = 0;
+    result[3] = static_cast<char>(address_size);
+    std::memcpy(result + 4, value.address().binary(), address_size);
+    return Data::make(std::string_view{result, 4 + address_size},
+      Data_format::binary);
+  }
+
+private:
+  static constexpr char ipv4_family_{2};
+  static constexpr char ipv6_family_{3};
+};
+
+/// The implementation of `net::Ip_address` to/from `std::string` conversions.
+struct Ip_address_string_conversions final {
+  using Type = net::Ip_address;
+
+  template<typename ... Types>
+  static Type to_type(const std::string& text, Types&& ...)
+  {
+    return to_address(Inet_string_conversions::to_type(text));
+  }
+
+  template<typename ... Types>
+  static std::string to_string(const Type& value, Types&& ...)
+  {
+    return Inet_string_conversions::to_string(Inet{value});
+  }
+
+  /// @returns The address of the `inet` which must be a host address.
+  static Type to_address(const Inet& inet)
+  {
+    if (!inet.is_host())
+      throw Client_exception{"cannot convert to IP address: "
+        "inet is not a host address"};
+    return inet.address();
+  }
+};
+
+/// The implementation of `net::Ip_address` to/from Data conversions.
+struct Ip_address_data_conversions final {
+  using Type = net::Ip_address;
+
+  template<typename ... Types>
+  static Type to_type(const Data& data, Types&& ...)
+  {
+    return Ip_address_string_conversions::to_address(
+      Inet_data_conversions::to_type(data));
+  }
+
+  template<typename ... Types>
+  static Type to_type(std::unique_ptr<Data>&& data, Types&& ...)
+  {
+    if (!data)
+      throw Client_exception{"cannot convert to IP address: null data given"};
+    return to_type(*data);
+  }
+
+  template<typename ... Types>
+  static std::unique_ptr<Data> to_data(const Type& value, Types&& ... args)
+  {
+    return Inet_data_conversions::to_data(Inet{value},
+      std::forward<Types>(args)...);
+  }
+};
+
+/// The implementation of Mac_address to/from `std::string` conversions.
+struct Mac_address_string_conversions final {
+  using Type = Mac_address;
+
+  template<typename ... Types>
+  static Type to_type(const std::string& text, Types&& ...)
+  {
+    return to_type__(text.data(), text.size());
+  }
+
+  /// @returns The representation like `08:00:2b:01:02:03`.
+  template<typename ... Types>
+  static std::string to_string(const Type& value, Types&& ...)
+  {
+    constexpr const char* digits{"0123456789abcdef"};
+    std::string result(17, ':');
+    auto* out = result.data();
+    for (const auto byte : value.bytes()) {
+      *out++ = digits[byte >> 4];
+      *out++ = digits[byte & 0xf];
+      ++out;
+    }
+    return result;
+  }
+
+private:
+  friend struct Mac_address_data_conversions;
+
+  /**
+   * @returns The MAC address parsed from the 12 hex digits with the optional
+   * single separator (`:`, `-` or `.`) between the pairs of digits, which
+   * covers all the formats accepted by PostgreSQL.
+   */
+  static Type to_type__(const char* const text, const std::size_t size)
+  {
+    const auto throw_invalid = []
+    {
+      throw Client_exception{"cannot convert to macaddr: "
+        "invalid text representation"};
+    };
+    const auto digit_value = [](const char c) noexcept
+    {
+      if ('0' <= c && c <= '9')
+        return c - '0';
+      else if ('a' <= (c | 0x20) && (c | 0x20) <= 'f')
+        return (c | 0x20) - 'a' + 10;
+      else
+        return -1;
+    };
+
+    Mac_address::Bytes result;
+    const char* pos{text};
+    const char* const end{text + size};
+    for (std::size_t i{}; i < result.size(); ++i) {
+      if (i && pos != end && (*pos == ':' || *pos == '-' || *pos == '.'))
+        ++pos;
+      if (end - pos < 2)
+        throw_invalid();
+      const int high{digit_value(pos[0])};
+      const int low{digit_value(pos[1])};
+      if (high < 0 || low < 0)
+        throw_invalid();
+      result[i] = static_cast<std::uint8_t>(high << 4 | low);
+      pos += 2;
+    }
+    if (pos != end)
+      throw_invalid();
+    return Mac_address{result};
+  }
+};
+
+/// The implementation of Mac_address to/from Data conversions.
+struct Mac_address_data_conversions final {
+  using Type = Mac_address;
+
+  template<typename ... Types>
+  static Type to_type(const Data& data, Types&& ...)
+  {
+    const auto* const bytes = static_cast<const char*>(data.bytes());
+    if (data.format() == Data_format::text)
+      return Mac_address_string_conversions::to_type__(bytes, data.size());
+
+    Mac_address::Bytes result;
+    if (data.size() != result.size())
+      throw Client_exception{"cannot convert to macaddr: invalid input size"};
+    std::memcpy(result.data(), bytes, result.size());
+    return Mac_address{result};
+  }
+
+  template<typename ... Types>
+  static Type to_type(std::unique_ptr<Data>&& data, Types&& ...)
+  {
+    if (!data)
+      throw Client_exception{"cannot convert to macaddr: null data given"};
+    return to_type(*data);
+  }
+
+  template<typename ... Types>
+  static std::unique_ptr<Data> to_data(const Type& value, Types&& ...)
+  {
+    return Data::make(Mac_address_string_conversions::to_string(value),
+      Data_format::text);
+  }
+
+  template<typename ... Types>
+  static std::unique_ptr<Data> to_data(const Type& value,
+    const Data_format format, Types&& ...)
+  {
+    if (format == Data_format::text)
+      return to_data(value);
+
+    return Data::make(std::string_view{
+      reinterpret_cast<const char*>(value.bytes().data()), value.bytes().size()},
+      Data_format::binary);
+  }
+};
+
+} // namespace detail
+
+/**
+ * @ingroup conversions
+ *
+ * @brief Full specialization of Conversions for Inet.
+ *
+ * @details Support of the following data formats is implemented for:
+ *   - input data  - Data_format::text, Data_format::binary (of both `inet`
+ *   and `cidr`);
+ *   - output data - Data_format::text, Data_format::binary (of `inet`, which
+ *   can be casted to `cidr` by the server).
+ */
+template<>
+struct Conversions<Inet> final : Basic_conversions<Inet,
+  detail::Inet_string_conversions, detail::Inet_data_conversions> {
+  /// The OID of `inet`.
+  static constexpr Oid binary_type_oid{869};
+
+  /// `true` since the output data can be in Data_format::binary.
+  static constexpr bool is_binary_data_convertible{true};
+};
+
+/**
+ * @ingroup conversions
+ *
+ * @brief Full specialization of Conversions for `net::Ip_address`.
+ *
+ * @details Support of the following data formats is implemented for:
+ *   - input data  - Data_format::text, Data_format::binary (of `inet` of the
+ *   host address only);
+ *   - output data - Data_format::text, Data_format::binary.
+ */
+template<>
+struct Conversions<net::Ip_address> final : Basic_conversions<net::Ip_address,
+  detail::Ip_address_string_conversions, detail::Ip_address_data_conversions> {
+  /// The OID of `inet`.
+  static constexpr Oid binary_type_oid{869};
+
+  /// `true` since the output data can be in Data_format::binary.
+  static constexpr bool is_binary_data_convertible{true};
+};
+
+/**
+ * @ingroup conversions
+ *
+ * @brief Full specialization of Conversions for Mac_address.
+ *
+ * @details Support of the following data formats is implemented for:
+ *   - input data  - Data_format::text, Data_format::binary;
+ *   - output data - Data_format::text, Data_format::binary.
+ */
+template<>
+struct Conversions<Mac_address> final : Basic_conversions<Mac_address,
+  detail::Mac_address_string_conversions, detail::Mac_address_data_conversions> {
+  /// The OID of `macaddr`.
+  static constexpr Oid binary_type_oid{829};
+
+  /// `true` since the output data can be in Data_format::binary.
+  static constexpr bool is_binary_data_convertible{true};
+};
+
+} // namespace dmitigr::pgfe
+
+#endif  // DMITIGR_PGFE_NETWORK_ADDRESS_HPP
@@ -19,41 +19,55 @@
 
 #include "array_aliases.hpp"
 #include "array_conversions.hpp"
+#include "async.hpp"
+#include "async_scheduler.hpp"
 #include "basics.hpp"
 #include "basic_conversions.hpp"
+#include "bulk_completion.hpp"
 #include "completion.hpp"
 #include "composite.hpp"
 #include "compositional.hpp"
 #include "connection.hpp"
 #include "connection_options.hpp"
 #include "connection_pool.hpp"
+#include "connection_reactor.hpp"
 #include "contract.hpp"
 #include "conversions.hpp"
 #include "conversions_api.hpp"
 #include "copier.hpp"
 #include "data.hpp"
+#include "decimal.hpp"
 #include "errc.hpp"
 #include "errctg.hpp"
 #include "error.hpp"
 #include "exceptions.hpp"
+#include "flat_array.hpp"
 #include "large_object.hpp"
 #include "message.hpp"
 #include "misc.hpp"
+#include "network_address.hpp"
 #include "notice.hpp"
 #include "notification.hpp"
 #include "parameterizable.hpp"
 #include "prepared_statement.hpp"
 #include "problem.hpp"
 #include "ready_for_query.hpp"
+#include "request_handle.hpp"
 #include "response.hpp"
+#include "result_set.hpp"
 #include "row.hpp"
+#include "row_batch.hpp"
 #include "row_info.hpp"
+#include "row_view.hpp"
+#include "sharded_connection_pool.hpp"
 #include "signal.hpp"
 #include "statement.hpp"
 #include "statement_vector.hpp"
+#include "temporal.hpp"
 #include "transaction_guard.hpp"
 #include "tuple.hpp"
 #include "types_fwd.hpp"
+#include "uuid.hpp"
 #include "version.hpp"
 #include "lib_version.hpp"
 
@@ -0,0 +1,182 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../base/assert.hpp"
+#include "exceptions.hpp"
+#include "poller.hpp"
+
+#ifdef __linux__
+#include <cerrno>
+#include <sys/epoll.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#include "../os/windows.hpp"
+#include <Winsock2.h>
+#else
+#include <cerrno>
+#include <poll.h>
+#endif
+
+namespace dmitigr::pgfe::detail {
+
+DMITIGR_PGFE_INLINE Poller::~Poller() noexcept
+{
+#ifdef __linux__
+  ::close(poller_);
+#endif
+}
+
+DMITIGR_PGFE_INLINE Poller::Poller(const bool is_oneshot)
+  : is_oneshot_{is_oneshot}
+{
+#ifdef __linux__
+  if ( (poller_ = ::epoll_create1(EPOLL_CLOEXEC)) < 0)
+    throw Client_exception{"cannot create epoll instance"};
+#endif
+}
+
+DMITIGR_PGFE_INLINE void Poller::watch(const int socket,
+  const Socket_readiness mask)
+{
+  DMITIGR_ASSERT(socket >= 0);
+  const auto [i, is_new] = masks_.try_emplace(socket); // can throw
+  if (!is_new && i->second == mask)
+    return;
+
+#ifdef __linux__
+  using Sr = Socket_readiness;
+  ::epoll_event event{};
+  if (bool(mask & Sr::read_ready))
+    event.events |= EPOLLIN;
+  if (bool(mask & Sr::write_ready))
+    event.events |= EPOLLOUT;
+  if (is_oneshot_)
+    event.events |= EPOLLONESHOT;
+  event.data.fd = socket;
+  if (::epoll_ctl(poller_, is_new ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, socket, &event)) {
+    /*
+     * The registration may be stale if the socket was closed (and thus
+     * automatically removed from the epoll set) by libpq and its descriptor
+     * was reused.
+     */
+    const int op{errno == ENOENT ? EPOLL_CTL_ADD :
+      errno == EEXIST ? EPOLL_CTL_MOD : -1};
+    if (op < 0 || ::epoll_ctl(poller_, op, socket, &event)) {
+      if (is_new)
+        masks_.erase(i);
+      throw Client_exception{"cannot watch socket"};
+    }
+  }
+#endif
+  i->second = mask;
+}
+
+DMITIGR_PGFE_INLINE void Poller::unwatch(const int socket) noexcept
+{
+  if (!masks_.erase(socket))
+    return;
+
+#ifdef __linux__
+  /*
+   * The socket may be already closed (and thus automatically removed from
+   * the epoll set) by libpq, so the error is ignored.
+   */
+  ::epoll_event event{};
+  ::epoll_ctl(poller_, EPOLL_CTL_DEL, socket, &event);
+#endif
+}
+
+DMITIGR_PGFE_INLINE auto Poller::wait(const int timeout)
+  -> const std::vector<Event>&
+{
+  using Sr = Socket_readiness;
+
+  events_.clear();
+#ifdef __linux__
+  constexpr int max_event_count{64};
+  ::epoll_event events[max_event_count];
+  const int count{::epoll_wait(poller_, events, max_event_count, timeout)};
+  if (count < 0) {
+    if (errno == EINTR)
+      return events_;
+    throw Client_exception{"cannot wait for socket readiness"};
+  }
+  events_.reserve(count);
+  for (int i{}; i < count; ++i) {
+    const auto ev = events[i].events;
+    auto readiness = Sr::unready;
+    if (ev & (EPOLLIN | EPOLLHUP | EPOLLERR))
+      readiness |= Sr::read_ready;
+    if (ev & (EPOLLOUT | EPOLLERR))
+      readiness |= Sr::write_ready;
+    events_.push_back(Event{events[i].data.fd, readiness});
+  }
+#else
+#ifdef _WIN32
+  using Pollfd = ::WSAPOLLFD;
+  using Socket = ::SOCKET;
+#else
+  using Pollfd = ::pollfd;
+  using Socket = int;
+#endif
+  std::vector<Pollfd> fds;
+  fds.reserve(masks_.size());
+  for (const auto& [socket, mask] : masks_) {
+    if (mask == Sr::unready)
+      continue; // disarmed
+    Pollfd fd{};
+    fd.fd = static_cast<Socket>(socket);
+    if (bool(mask & Sr::read_ready))
+      fd.events |= POLLIN;
+    if (bool(mask & Sr::write_ready))
+      fd.events |= POLLOUT;
+    fds.push_back(fd);
+  }
+#ifdef _WIN32
+  const int count{::WSAPoll(fds.data(), static_cast<ULONG>(fds.size()), timeout)};
+  if (count == SOCKET_ERROR)
+    throw Client_exception{"cannot wait for socket readiness"};
+#else
+  const int count{::poll(fds.data(), fds.size(), timeout)};
+  if (count < 0) {
+    if (errno == EINTR)
+      return events_;
+    throw Client_exception{"cannot wait for socket readiness"};
+  }
+#endif
+  events_.reserve(count);
+  for (const auto& fd : fds) {
+    if (!fd.revents)
+      continue;
+    auto readiness = Sr::unready;
+    if (fd.revents & (POLLIN | POLLHUP | POLLERR))
+      readiness |= Sr::read_ready;
+    if (fd.revents & (POLLOUT | POLLERR))
+      readiness |= Sr::write_ready;
+    events_.push_back(Event{static_cast<int>(fd.fd), readiness});
+  }
+#endif
+
+  if (is_oneshot_) {
+    for (const auto& event : events_) {
+      if (const auto i = masks_.find(event.socket_); i != masks_.end())
+        i->second = Sr::unready;
+    }
+  }
+  return events_;
+}
+
+} // namespace dmitigr::pgfe::detail
@@ -0,0 +1,110 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DMITIGR_PGFE_POLLER_HPP
+#define DMITIGR_PGFE_POLLER_HPP
+
+#include "basics.hpp"
+#include "dll.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+namespace dmitigr::pgfe::detail {
+
+/**
+ * @brief A set of the watched sockets.
+ *
+ * @details Implemented by epoll(7) on Linux and by poll() elsewhere. It's the
+ * backend of Connection_reactor and Default_async_scheduler.
+ *
+ * @remarks Functions of this class are not thread-safe.
+ */
+class Poller final {
+public:
+  /// The readiness of the watched socket.
+  struct Event final {
+    int socket_{-1};
+    Socket_readiness readiness_{};
+  };
+
+  /// The destructor.
+  ~Poller() noexcept;
+
+  /**
+   * @brief The constructor.
+   *
+   * @param is_oneshot If `true`, the socket is disarmed after its readiness
+   * is reported until it's watched again.
+   *
+   * @throws Client_exception if the underlying event notification facility
+   * cannot be initialized.
+   */
+  explicit Poller(bool is_oneshot);
+
+  /// Non copy-constructible.
+  Poller(const Poller&) = delete;
+
+  /// Non copy-assignable.
+  Poller& operator=(const Poller&) = delete;
+
+  /// Non move-constructible.
+  Poller(Poller&&) = delete;
+
+  /// Non move-assignable.
+  Poller& operator=(Poller&&) = delete;
+
+  /**
+   * @brief Watches the `socket` for the readiness specified by `mask`.
+   *
+   * @details The socket is registered upon the first call, only the mask is
+   * modified upon the subsequent calls.
+   *
+   * @par Requires
+   * `socket >= 0`.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   */
+  void watch(int socket, Socket_readiness mask);
+
+  /// Stops watching the `socket`.
+  void unwatch(int socket) noexcept;
+
+  /**
+   * @brief Waits for the readiness of the watched sockets.
+   *
+   * @param timeout The timeout in milliseconds, or `-1` for eternity.
+   *
+   * @returns The readiness of the sockets, which is empty if the waiting is
+   * interrupted by a signal. The result is valid until the next call.
+   */
+  const std::vector<Event>& wait(int timeout);
+
+private:
+  int poller_{-1};
+  bool is_oneshot_{};
+  std::unordered_map<int, Socket_readiness> masks_; // unready if disarmed
+  std::vector<Event> events_;
+};
+
+} // namespace dmitigr::pgfe::detail
+
+#ifndef DMITIGR_PGFE_NOT_HEADER_ONLY
+#include "poller.cpp"
+#endif
+
+#endif  // DMITIGR_PGFE_POLLER_HPP
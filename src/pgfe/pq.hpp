@@ -183,6 +183,12 @@ public:
     return PQcmdStatus(const_cast<PGresult*>(native_handle()));
   }
 
+  /// @returns The number of bytes allocated for the result.
+  std::size_t memory_size() const noexcept
+  {
+    return PQresultMemorySize(native_handle());
+  }
+
   /// @returns The number of rows affected by a SQL command.
   const char* affected_row_count() const noexcept
   {
@@ -20,6 +20,7 @@
 #include "statement.hpp"
 
 #include <algorithm>
+#include <limits>
 
 namespace dmitigr::pgfe {
 
@@ -84,8 +85,13 @@ DMITIGR_PGFE_INLINE Prepared_statement::~Prepared_statement() noexcept
     auto [p, e] = conn->registered_ps(state_->id_);
     DMITIGR_ASSERT(p != e);
 
+    /*
+     * The unreferenced named statement is kept registered until it's
+     * deallocated by Connection::reclaim_prepared_statements().
+     */
+    const bool is_unnamed = state_->id_.empty();
     state_ = nullptr;
-    if ((*p).use_count() == 1)
+    if (is_unnamed && p->second.use_count() == 1)
       conn->unregister_ps(p);
   }
 }
@@ -96,6 +102,9 @@ Prepared_statement::Prepared_statement(Prepared_statement&& rhs) noexcept
   , state_{std::move(rhs.state_)}
   , parameters_{std::move(rhs.parameters_)}
   , result_format_{std::move(rhs.result_format_)}
+  , parameter_format_{rhs.parameter_format_}
+  , row_batch_size_{rhs.row_batch_size_}
+  , result_retrieval_{rhs.result_retrieval_}
 {}
 
 DMITIGR_PGFE_INLINE Prepared_statement&
@@ -115,6 +124,9 @@ DMITIGR_PGFE_INLINE void Prepared_statement::swap(Prepared_statement& rhs) noexc
   swap(state_, rhs.state_);
   swap(parameters_, rhs.parameters_);
   swap(result_format_, rhs.result_format_);
+  swap(parameter_format_, rhs.parameter_format_);
+  swap(row_batch_size_, rhs.row_batch_size_);
+  swap(result_retrieval_, rhs.result_retrieval_);
 }
 
 DMITIGR_PGFE_INLINE bool Prepared_statement::is_valid() const noexcept
@@ -221,6 +233,47 @@ Prepared_statement::result_format() const noexcept
   return result_format_;
 }
 
+DMITIGR_PGFE_INLINE void
+Prepared_statement::set_parameter_format(const Data_format format)
+{
+  parameter_format_ = format;
+  assert(is_invariant_ok());
+}
+
+DMITIGR_PGFE_INLINE Data_format
+Prepared_statement::parameter_format() const noexcept
+{
+  return parameter_format_;
+}
+
+DMITIGR_PGFE_INLINE void
+Prepared_statement::set_row_batch_size(const std::size_t size)
+{
+  if (!size || size > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+    throw_exception("cannot set row batch size of");
+  row_batch_size_ = size;
+  assert(is_invariant_ok());
+}
+
+DMITIGR_PGFE_INLINE std::size_t
+Prepared_statement::row_batch_size() const noexcept
+{
+  return row_batch_size_;
+}
+
+DMITIGR_PGFE_INLINE void
+Prepared_statement::set_result_retrieval(const Result_retrieval retrieval)
+{
+  result_retrieval_ = retrieval;
+  assert(is_invariant_ok());
+}
+
+DMITIGR_PGFE_INLINE Result_retrieval
+Prepared_statement::result_retrieval() const noexcept
+{
+  return result_retrieval_;
+}
+
 DMITIGR_PGFE_INLINE void Prepared_statement::execute_nio()
 {
   execute_nio__(nullptr);
@@ -239,14 +292,30 @@ Prepared_statement::execute_nio__(const Statement* const statement)
   else if (!(connection().is_ready_for_nio_request()))
     throw_exception("cannot execute");
 
-  // All the values are NULLs initially. (Can throw.)
+  /*
+   * All the values are NULLs initially. (Can throw only if the capacity of
+   * the buffers of the state is not enough.)
+   */
   const int param_count{static_cast<int>(parameter_count())};
-  std::vector<const char*> values(static_cast<unsigned>(param_count), nullptr);
-  std::vector<int> lengths(static_cast<unsigned>(param_count), 0);
-  std::vector<int> formats(static_cast<unsigned>(param_count), 0);
+  auto& values = state_->values_;
+  auto& lengths = state_->lengths_;
+  auto& formats = state_->formats_;
+  values.assign(static_cast<unsigned>(param_count), nullptr);
+  lengths.assign(static_cast<unsigned>(param_count), 0);
+  formats.assign(static_cast<unsigned>(param_count), 0);
 
   auto& conn = connection();
-  conn.requests_.emplace(Connection::Request::Id::execute); // can throw
+  const bool is_adaptive = result_retrieval_ == Result_retrieval::adaptive &&
+    !name().empty();
+  const bool is_whole_result = result_retrieval_ == Result_retrieval::whole ||
+    (is_adaptive && 0 <= state_->last_row_count_ &&
+      static_cast<std::size_t>(state_->last_row_count_) <=
+      conn.adaptive_result_threshold());
+  auto& request = conn.requests_.emplace(Connection::Request::Id::execute); // can throw
+  request.row_batch_size_ = row_batch_size_;
+  request.is_whole_result_ = is_whole_result;
+  if (is_adaptive)
+    request.adaptive_ps_state_ = state_;
   try {
     // Prepare the input for libpq.
     for (unsigned i{}; i < static_cast<unsigned>(param_count); ++i) {
@@ -271,10 +340,10 @@ Prepared_statement::execute_nio__(const Statement* const statement)
     if (!send_ok)
       throw Client_exception{conn.error_message()};
 
-    if (conn.pipeline_status() == Pipeline_status::disabled)
-      conn.set_single_row_mode_enabled();
+    if (conn.pipeline_status() == Pipeline_status::disabled && !is_whole_result)
+      conn.set_single_row_mode_enabled(row_batch_size_);
   } catch (...) {
-    conn.requests_.pop(); // rollback
+    conn.requests_.pop_back(); // rollback
     throw;
   }
 
@@ -286,6 +355,44 @@ DMITIGR_PGFE_INLINE Completion Prepared_statement::execute()
   return execute([](auto&&){});
 }
 
+DMITIGR_PGFE_INLINE void
+Prepared_statement::process_many__(Bulk_completion* const result,
+  const std::size_t sync_count)
+{
+  auto& conn = connection();
+  if (!conn.has_uncompleted_request())
+    return;
+  else if (conn.requests_.back().id_ != Connection::Request::Id::sync)
+    conn.send_sync();
+
+  // Process the responses up to the `sync_count`-th synchronization point.
+  for (std::size_t i{}; i < sync_count && conn.has_uncompleted_request();) {
+    conn.wait_response();
+    if (auto err = conn.error()) {
+      if (result)
+        result->errors_.emplace_back(result->element_count_++, std::move(err));
+    } else if (conn.ready_for_query()) {
+      ++i;
+#ifdef LIBPQ_HAS_PIPELINING
+    } else if (conn.response_.status() == PGRES_PIPELINE_ABORTED) {
+      conn.release_response();
+      if (result)
+        result->aborted_.push_back(result->element_count_++);
+#endif
+    } else if (conn.row_batch()) {
+      continue;
+    } else if (auto comp = conn.completion()) {
+      if (result) {
+        ++result->element_count_;
+        ++result->completion_count_;
+        if (const auto row_count = comp.row_count())
+          result->row_count_ += *row_count;
+      }
+    } else if (conn.has_response())
+      throw Client_exception{Client_errc::invalid_response};
+  }
+}
+
 DMITIGR_PGFE_INLINE const Connection& Prepared_statement::connection() const
 {
   if (!is_valid())
@@ -389,6 +496,9 @@ Prepared_statement::init_connection__(
   DMITIGR_ASSERT(state_);
   DMITIGR_ASSERT(is_valid());
   result_format_ = connection().result_format();
+  parameter_format_ = connection().parameter_format();
+  row_batch_size_ = connection().row_batch_size();
+  result_retrieval_ = connection().result_retrieval();
 }
 
 DMITIGR_PGFE_INLINE bool Prepared_statement::is_invariant_ok() const noexcept
@@ -19,6 +19,7 @@
 
 #include "../util/memory.hpp"
 #include "basics.hpp"
+#include "bulk_completion.hpp"
 #include "conversions_api.hpp"
 #include "dll.hpp"
 #include "parameterizable.hpp"
@@ -29,15 +30,30 @@
 #include <cassert>
 #include <chrono>
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
 namespace dmitigr::pgfe {
 
+namespace detail {
+
+/// The trait to detect types which support the tuple-like protocol.
+template<typename T, typename = void>
+struct Is_tuple_like final : std::false_type {};
+
+/// The specialization for types which support the tuple-like protocol.
+template<typename T>
+struct Is_tuple_like<T, std::void_t<decltype(std::tuple_size<T>::value)>> final
+  : std::true_type {};
+
+} // namespace detail
+
 /**
  * @ingroup main
  *
@@ -257,7 +273,8 @@ public:
    *   will be owned by this instance;)
    *   - a type for which the specialization of Conversions is defined to bind
    *   the specified `value` of type `T`. (The conversion result of type Data
-   *   will be owned by this instance;)
+   *   will be owned by this instance. The result is in `parameter_format()`
+   *   if the Conversions support it, or in Data_format::text otherwise;)
    *   - a type convertible to `const Data&` to bind the specified `value`. (The
    *   `value` will not be owned by this instance;)
    *   - `std::nullptr_t` to bind the SQL NULL.
@@ -293,6 +310,8 @@ public:
       return bind(index, Data_ptr{&value, Data_deletion_required{false}});
     } else if constexpr (is_nullptr) {
       return bind(index, Data_ptr{nullptr, Data_deletion_required{false}});
+    } else if constexpr (detail::Is_binary_data_convertible<U>::value) {
+      return bind(index, to_data(std::forward<T>(value), parameter_format_));
     } else
       return bind(index, to_data(std::forward<T>(value)));
   }
@@ -358,6 +377,62 @@ public:
    */
   DMITIGR_PGFE_API Data_format result_format() const noexcept;
 
+  /**
+   * @brief Sets the data format of the parameters which will be bound to this
+   * statement afterwards.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   *
+   * @see Connection::set_parameter_format().
+   */
+  DMITIGR_PGFE_API void set_parameter_format(const Data_format format);
+
+  /**
+   * @returns The data format of the parameters bound to this statement.
+   *
+   * @see Connection::parameter_format().
+   */
+  DMITIGR_PGFE_API Data_format parameter_format() const noexcept;
+
+  /**
+   * @brief Sets the maximum number of rows in a batch of rows that will be
+   * produced during the execution of a SQL command.
+   *
+   * @par Requires
+   * `size > 0 && size <= std::numeric_limits<int>::max()`.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   *
+   * @see Connection::set_row_batch_size().
+   */
+  DMITIGR_PGFE_API void set_row_batch_size(std::size_t size);
+
+  /**
+   * @returns The maximum number of rows in a batch of response rows.
+   *
+   * @see Connection::row_batch_size().
+   */
+  DMITIGR_PGFE_API std::size_t row_batch_size() const noexcept;
+
+  /**
+   * @brief Sets the result retrieval mode of this statement execution.
+   *
+   * @par Exception safety guarantee
+   * Strong.
+   *
+   * @see Connection::set_result_retrieval().
+   */
+  DMITIGR_PGFE_API void set_result_retrieval(Result_retrieval retrieval);
+
+  /**
+   * @returns The result retrieval mode of this statement execution.
+   *
+   * @see Connection::result_retrieval().
+   */
+  DMITIGR_PGFE_API Result_retrieval result_retrieval() const noexcept;
+
   /**
    * @brief Submits a request to a PostgreSQL server to execute this prepared
    * statement.
@@ -397,6 +472,38 @@ public:
   /// @overload
   DMITIGR_PGFE_API Completion execute();
 
+  /**
+   * @brief Executes this prepared statement for each element of `range` in
+   * pipeline mode.
+   *
+   * @details Elements of tuple-like types (such as `std::tuple`, `std::pair`,
+   * `std::array`, or user-defined types which specialize `std::tuple_size` and
+   * provide `get<I>()` found by argument-dependent lookup) are unpacked and
+   * bound by using bind_many(). Any other element, including plain aggregate
+   * without such specialization, is bound as the only parameter. The
+   * synchronization point is sent after each `sync_window` elements. Thus,
+   * an error caused by an element aborts the execution of the rest elements of
+   * the same window only. The responses to the window are processed after
+   * sending the next one, so that the server doesn't idle while the client
+   * reads the responses.
+   *
+   * @param range A range of parameter tuples.
+   * @param sync_window The maximum number of elements between synchronization
+   * points.
+   *
+   * @par Requires
+   * `connection()->is_ready_for_request() && sync_window > 0`.
+   *
+   * @par Exception safety guarantee
+   * Basic.
+   *
+   * @remarks Defined in connection.hpp.
+   *
+   * @see Connection::set_pipeline_enabled(), Connection::send_sync().
+   */
+  template<class Range>
+  Bulk_completion execute_many(Range&& range, std::size_t sync_window = 256);
+
   /**
    * @returns The related Connection instance which prepared this statement.
    *
@@ -486,12 +593,30 @@ private:
     Connection* connection_{};
     bool preparsed_{};
     Row_info description_; // may be invalid, see set_description()
+    long last_row_count_{-1}; // for Result_retrieval::adaptive
+
+    // The buffers reused by execute_nio__() to avoid allocations.
+    std::vector<const char*> values_;
+    std::vector<int> lengths_;
+    std::vector<int> formats_;
+
+    // The size of description_ accounted by the connection.
+    std::size_t description_size_{};
+
+    std::size_t actual_description_size() const noexcept
+    {
+      const auto& r = description_.pq_result_;
+      return r ? r.memory_size() : 0;
+    }
   };
 
   bool is_registered_{};
   std::shared_ptr<State> state_;
   std::vector<Parameter> parameters_;
   Data_format result_format_{Data_format::text};
+  Data_format parameter_format_{Data_format::text};
+  std::size_t row_batch_size_{1};
+  Result_retrieval result_retrieval_{Result_retrieval::streaming};
 
   // ---------------------------------------------------------------------------
 
@@ -528,6 +653,27 @@ private:
       return (bind__(I, std::forward<Types>(args)), ...);
   }
 
+  template<std::size_t ... I, typename T>
+  Prepared_statement& bind_tuple__(std::index_sequence<I...>, T&& tuple)
+  {
+    using std::get;
+    return bind_many(get<I>(std::forward<T>(tuple))...);
+  }
+
+  template<typename T>
+  Prepared_statement& bind_element__(T&& element)
+  {
+    using U = std::decay_t<T>;
+    if constexpr (detail::Is_tuple_like<U>::value)
+      return bind_tuple__(std::make_index_sequence<std::tuple_size_v<U>>{},
+        std::forward<T>(element));
+    else
+      return bind_many(std::forward<T>(element));
+  }
+
+  void process_many__(Bulk_completion* result,
+    std::size_t sync_count = std::numeric_limits<std::size_t>::max());
+
   // ---------------------------------------------------------------------------
 
   void set_description(detail::pq::Result&& r);
@@ -0,0 +1,113 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "connection.hpp"
+#include "exceptions.hpp"
+#include "request_handle.hpp"
+
+namespace dmitigr::pgfe {
+
+DMITIGR_PGFE_INLINE
+Request_handle::Request_handle(std::shared_ptr<State> state) noexcept
+  : state_{std::move(state)}
+{}
+
+DMITIGR_PGFE_INLINE void Request_handle::swap(Request_handle& rhs) noexcept
+{
+  using std::swap;
+  swap(state_, rhs.state_);
+}
+
+DMITIGR_PGFE_INLINE bool Request_handle::is_valid() const noexcept
+{
+  return state_ && *state_->connection_;
+}
+
+DMITIGR_PGFE_INLINE bool Request_handle::is_ready() const noexcept
+{
+  return state_ && state_->is_ready_;
+}
+
+DMITIGR_PGFE_INLINE bool Request_handle::is_aborted() const noexcept
+{
+  return state_ && state_->is_aborted_;
+}
+
+DMITIGR_PGFE_INLINE bool Request_handle::poll()
+{
+  return poll__(false);
+}
+
+DMITIGR_PGFE_INLINE void
+Request_handle::wait(const std::optional<std::chrono::milliseconds> timeout)
+{
+  auto& conn = connection();
+  while (!state_->is_ready_) {
+    if (conn.has_response())
+      conn.route_response__();
+    else if (!conn.wait_response(timeout) && !conn.has_uncompleted_request())
+      throw Client_exception{"cannot wait response of request: "
+        "the request is lost"};
+  }
+}
+
+DMITIGR_PGFE_INLINE Row Request_handle::row() noexcept
+{
+  if (!state_ || state_->rows_.empty())
+    return Row{};
+  auto result = std::move(state_->rows_.front());
+  state_->rows_.pop_front();
+  return result;
+}
+
+DMITIGR_PGFE_INLINE Completion Request_handle::completion() noexcept
+{
+  return state_ ? std::move(state_->completion_) : Completion{};
+}
+
+DMITIGR_PGFE_INLINE Error Request_handle::error() noexcept
+{
+  return state_ ? std::move(state_->error_) : Error{};
+}
+
+DMITIGR_PGFE_INLINE Prepared_statement
+Request_handle::prepared_statement() noexcept
+{
+  return state_ ? std::move(state_->prepared_statement_) : Prepared_statement{};
+}
+
+DMITIGR_PGFE_INLINE bool Request_handle::poll__(const bool is_dismissing)
+{
+  auto& conn = connection();
+  if (!state_->is_ready_)
+    conn.read_input();
+  while (!state_->is_ready_) {
+    if (conn.has_response())
+      conn.route_response__(is_dismissing);
+    else if (conn.handle_input(false) != Response_status::ready)
+      break;
+  }
+  return state_->is_ready_;
+}
+
+DMITIGR_PGFE_INLINE Connection& Request_handle::connection() const
+{
+  if (!is_valid())
+    throw Client_exception{"cannot use invalid request handle"};
+  return **state_->connection_;
+}
+
+} // namespace dmitigr::pgfe
@@ -0,0 +1,190 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DMITIGR_PGFE_REQUEST_HANDLE_HPP
+#define DMITIGR_PGFE_REQUEST_HANDLE_HPP
+
+#include "completion.hpp"
+#include "dll.hpp"
+#include "error.hpp"
+#include "prepared_statement.hpp"
+#include "row.hpp"
+#include "types_fwd.hpp"
+
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <optional>
+
+namespace dmitigr::pgfe {
+
+/**
+ * @ingroup main
+ *
+ * @brief A handle of the request submitted to the server.
+ *
+ * @details The responses to the request are routed to its handle as they are
+ * received, so many independent logical operations can share the same
+ * (pipelined) connection without bookkeeping of the order of responses.
+ *
+ * @see Connection::last_request_handle().
+ */
+class Request_handle final {
+public:
+  /// Default-constructible. (Constructs invalid instance.)
+  Request_handle() = default;
+
+  /// Not copy-constructible.
+  Request_handle(const Request_handle&) = delete;
+
+  /// Move-constructible.
+  Request_handle(Request_handle&&) = default;
+
+  /// Not copy-assignable.
+  Request_handle& operator=(const Request_handle&) = delete;
+
+  /// Move-assignable.
+  Request_handle& operator=(Request_handle&&) = default;
+
+  /// Swaps this instance with `rhs`.
+  DMITIGR_PGFE_API void swap(Request_handle& rhs) noexcept;
+
+  /**
+   * @returns `true` if the instance is valid, i.e. refers to a request of the
+   * session of a connection which is still alive.
+   */
+  DMITIGR_PGFE_API bool is_valid() const noexcept;
+
+  /// @returns `is_valid()`.
+  explicit operator bool() const noexcept
+  {
+    return is_valid();
+  }
+
+  /**
+   * @returns `true` if the request is completed, i.e. either completion(),
+   * error(), prepared_statement() is available or the request is aborted.
+   *
+   * @remarks Rows may be still available by row() after the completion.
+   */
+  DMITIGR_PGFE_API bool is_ready() const noexcept;
+
+  /**
+   * @returns `true` if the request was not executed because of an error
+   * of a preceding request in pipeline.
+   */
+  DMITIGR_PGFE_API bool is_aborted() const noexcept;
+
+  /**
+   * @brief Routes the responses which are available without blocking.
+   *
+   * @returns is_ready().
+   *
+   * @par Requires
+   * `is_valid()`.
+   *
+   * @par Exception safety guarantee
+   * Basic. Client_exception is thrown if the response to the preceding request
+   * without handle is received. Such a response is left to be processed by
+   * using the API of Connection (e.g. Connection::process_responses()), after
+   * which the polling can be resumed.
+   *
+   * @see wait().
+   */
+  DMITIGR_PGFE_API bool poll();
+
+  /**
+   * @brief Routes the responses until this request is completed.
+   *
+   * @param timeout The value of `-1` means `Connection::options().wait_response_timeout()`,
+   * the value of `std::nullopt` means *eternity*. The timeout is applied to
+   * each of responses awaited.
+   *
+   * @par Requires
+   * `is_valid()`.
+   *
+   * @par Effects
+   * `is_ready()`.
+   *
+   * @par Exception safety guarantee
+   * Basic. The responses to the preceding requests without handles are
+   * treated the same way as by poll().
+   *
+   * @see Connection::wait_response().
+   */
+  DMITIGR_PGFE_API void wait(std::optional<std::chrono::milliseconds> timeout =
+    std::chrono::milliseconds{-1});
+
+  /**
+   * @returns The next received row, or invalid instance if none.
+   *
+   * @remarks The rows are accumulated by the handle until retrieved by this
+   * method, and the number of such rows is not limited. Thus, the large
+   * results should be retrieved as they arrive, i.e. by calling this method
+   * after each poll() or wait() rather than after the completion.
+   */
+  DMITIGR_PGFE_API Row row() noexcept;
+
+  /// @returns The released completion, or invalid instance if none.
+  DMITIGR_PGFE_API Completion completion() noexcept;
+
+  /// @returns The released error, or invalid instance if none.
+  DMITIGR_PGFE_API Error error() noexcept;
+
+  /**
+   * @returns The released prepared statement of the prepare or describe
+   * request, or invalid instance if none.
+   */
+  DMITIGR_PGFE_API Prepared_statement prepared_statement() noexcept;
+
+private:
+  friend Connection;
+  friend Connection_reactor;
+
+  struct State final {
+    explicit State(std::shared_ptr<Connection*> connection) noexcept
+      : connection_{std::move(connection)}
+    {}
+
+    std::shared_ptr<Connection*> connection_;
+    std::deque<Row> rows_;
+    Completion completion_;
+    Error error_;
+    Prepared_statement prepared_statement_;
+    bool is_ready_{};
+    bool is_aborted_{};
+  };
+
+  std::shared_ptr<State> state_;
+
+  explicit Request_handle(std::shared_ptr<State> state) noexcept;
+  Connection& connection() const;
+  bool poll__(bool is_dismissing);
+};
+
+/**
+ * @ingroup main
+ *
+ * @brief Request_handle is swappable.
+ */
+inline void swap(Request_handle& lhs, Request_handle& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace dmitigr::pgfe
+
+#endif  // DMITIGR_PGFE_REQUEST_HANDLE_HPP
@@ -36,7 +36,9 @@ private:
   friend Error;
   friend Prepared_statement;
   friend Ready_for_query;
+  friend Result_set;
   friend Row;
+  friend Row_batch;
 
   Response() = default;
 };
@@ -57,6 +59,7 @@ template<typename F>
 struct Response_callback_traits<F,
   std::enable_if_t<std::is_invocable_v<F, Row&&>>> final {
   using Result = std::invoke_result_t<F, Row&&>;
+  using Argument = Row;
   constexpr static bool is_result_row_processing =
     std::is_same_v<Result, Row_processing>;
   constexpr static bool is_result_void =
@@ -70,6 +73,45 @@ template<typename F>
 struct Response_callback_traits<F,
   std::enable_if_t<std::is_invocable_v<F, Row&&, Error&&>>> final {
   using Result = std::invoke_result_t<F, Row&&, Error&&>;
+  using Argument = Row;
+  constexpr static bool is_result_row_processing =
+    std::is_same_v<Result, Row_processing>;
+  constexpr static bool is_result_void = std::is_same_v<Result, void>;
+  constexpr static bool is_valid = is_result_row_processing || is_result_void;
+  constexpr static bool has_error_parameter = true;
+};
+
+/*
+ * The generic callbacks (such as `[](auto&& row){...}`) are treated as the
+ * row callbacks. Thus, the callbacks invocable with Row are never checked for
+ * invocability with Row_batch, which would require instantiation of their
+ * bodies otherwise.
+ */
+
+/// Response callback traits partial specialization.
+template<typename F>
+struct Response_callback_traits<F,
+  std::enable_if_t<std::conjunction_v<
+    std::negation<std::is_invocable<F, Row&&>>,
+    std::is_invocable<F, Row_batch&&>>>> final {
+  using Result = std::invoke_result_t<F, Row_batch&&>;
+  using Argument = Row_batch;
+  constexpr static bool is_result_row_processing =
+    std::is_same_v<Result, Row_processing>;
+  constexpr static bool is_result_void =
+    std::is_same_v<Result, void>;
+  constexpr static bool is_valid = is_result_row_processing || is_result_void;
+  constexpr static bool has_error_parameter = false;
+};
+
+/// Response callback traits partial specialization.
+template<typename F>
+struct Response_callback_traits<F,
+  std::enable_if_t<std::conjunction_v<
+    std::negation<std::is_invocable<F, Row&&, Error&&>>,
+    std::is_invocable<F, Row_batch&&, Error&&>>>> final {
+  using Result = std::invoke_result_t<F, Row_batch&&, Error&&>;
+  using Argument = Row_batch;
   constexpr static bool is_result_row_processing =
     std::is_same_v<Result, Row_processing>;
   constexpr static bool is_result_void = std::is_same_v<Result, void>;
@@ -0,0 +1,132 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exceptions.hpp"
+#include "result_set.hpp"
+
+#include <cassert>
+
+namespace dmitigr::pgfe {
+
+DMITIGR_PGFE_INLINE Result_set::Result_set(detail::pq::Result&& pq_result) noexcept
+  : info_{std::move(pq_result)}
+{
+  assert(is_invariant_ok());
+}
+
+DMITIGR_PGFE_INLINE void Result_set::swap(Result_set& rhs) noexcept
+{
+  using std::swap;
+  swap(info_, rhs.info_);
+}
+
+DMITIGR_PGFE_INLINE bool Result_set::is_valid() const noexcept
+{
+  return static_cast<bool>(info_.pq_result_);
+}
+
+DMITIGR_PGFE_INLINE const Row_info& Result_set::info() const noexcept
+{
+  return info_;
+}
+
+DMITIGR_PGFE_INLINE std::size_t Result_set::row_count() const noexcept
+{
+  return static_cast<std::size_t>(info_.pq_result_.row_count());
+}
+
+DMITIGR_PGFE_INLINE bool Result_set::is_empty() const noexcept
+{
+  return !row_count();
+}
+
+DMITIGR_PGFE_INLINE Row_view Result_set::row(const std::size_t row) const
+{
+  if (!(row < row_count()))
+    throw Client_exception{"cannot get row of result set"};
+  return Row_view{&info_, static_cast<int>(row)};
+}
+
+DMITIGR_PGFE_INLINE Data_view
+Result_set::data(const std::size_t row, const std::size_t field) const
+{
+  if (!(row < row_count() && field < info_.field_count()))
+    throw Client_exception{"cannot get field data of result set"};
+
+  const auto rw = static_cast<int>(row);
+  const auto fld = static_cast<int>(field);
+  const auto& r = info_.pq_result_;
+  return !r.is_data_null(rw, fld) ?
+    Data_view{r.data_value(rw, fld),
+    static_cast<std::size_t>(r.data_size(rw, fld)), r.field_format(fld)} :
+    Data_view{};
+}
+
+DMITIGR_PGFE_INLINE Data_view Result_set::data(const std::size_t row,
+  const std::string_view name, const std::size_t offset) const
+{
+  return data(row, info_.field_index(name, offset));
+}
+
+DMITIGR_PGFE_INLINE auto
+Result_set::column(const std::size_t index) const -> Column_view
+{
+  if (!(index < info_.field_count()))
+    throw Client_exception{"cannot get column of result set"};
+  return Column_view{info_.pq_result_.native_handle(), static_cast<int>(index)};
+}
+
+DMITIGR_PGFE_INLINE auto Result_set::column(const std::string_view name,
+  const std::size_t offset) const -> Column_view
+{
+  return column(info_.field_index(name, offset));
+}
+
+// -----------------------------------------------------------------------------
+// Result_set::Column_view
+// -----------------------------------------------------------------------------
+
+DMITIGR_PGFE_INLINE std::string_view
+Result_set::Column_view::name() const noexcept
+{
+  return PQfname(result_, index_);
+}
+
+DMITIGR_PGFE_INLINE std::size_t Result_set::Column_view::size() const noexcept
+{
+  return static_cast<std::size_t>(PQntuples(result_));
+}
+
+DMITIGR_PGFE_INLINE Data_view
+Result_set::Column_view::operator[](const std::size_t row) const
+{
+  if (!(row < size()))
+    throw Client_exception{"cannot get data of result set column"};
+
+  const auto rw = static_cast<int>(row);
+  return !PQgetisnull(result_, rw, index_) ?
+    Data_view{PQgetvalue(result_, rw, index_),
+    static_cast<std::size_t>(PQgetlength(result_, rw, index_)),
+    detail::pq::to_data_format(PQfformat(result_, index_))} :
+    Data_view{};
+}
+
+DMITIGR_PGFE_INLINE bool Result_set::is_invariant_ok() const noexcept
+{
+  return info_.pq_result_.status() == PGRES_TUPLES_OK;
+}
+
+} // namespace dmitigr::pgfe
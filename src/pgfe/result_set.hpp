@@ -0,0 +1,279 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DMITIGR_PGFE_RESULT_SET_HPP
+#define DMITIGR_PGFE_RESULT_SET_HPP
+
+#include "data.hpp"
+#include "dll.hpp"
+#include "response.hpp"
+#include "row_info.hpp"
+#include "row_view.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+
+namespace dmitigr::pgfe {
+
+namespace detail {
+/// An iterator over the elements of `C` accessed by index.
+template<class C, typename V, V (C::*Get)(std::size_t) const>
+class Indexed_iterator final {
+public:
+  using iterator_category = std::input_iterator_tag;
+  using value_type = V;
+  using difference_type = std::ptrdiff_t;
+  using reference = V;
+  using pointer = void;
+
+  /// Constructs an invalid iterator.
+  Indexed_iterator() = default;
+
+  /// The constructor.
+  Indexed_iterator(const C* const container, const std::size_t index) noexcept
+    : container_{container}
+    , index_{index}
+  {}
+
+  /// Dereferences the iterator.
+  V operator*() const
+  {
+    return (container_->*Get)(index_);
+  }
+
+  /// Prefix increment.
+  Indexed_iterator& operator++() noexcept
+  {
+    ++index_;
+    return *this;
+  }
+
+  /// Postfix increment.
+  Indexed_iterator operator++(int) noexcept
+  {
+    auto tmp{*this};
+    ++index_;
+    return tmp;
+  }
+
+  /// @returns `true` if `*this == rhs`.
+  bool operator==(const Indexed_iterator& rhs) const noexcept
+  {
+    return (container_ == rhs.container_) && (index_ == rhs.index_);
+  }
+
+  /// @returns `true` if `*this != rhs`.
+  bool operator!=(const Indexed_iterator& rhs) const noexcept
+  {
+    return !(*this == rhs);
+  }
+
+private:
+  const C* container_{};
+  std::size_t index_{};
+};
+} // namespace detail
+
+/**
+ * @ingroup main
+ *
+ * @brief A whole result of a statement execution.
+ *
+ * @details Unlike rows retrieved one by one (or by batches), all the rows of
+ * the result set are stored in a single result object of libpq, which is
+ * preferred for the queries that produce a few rows.
+ *
+ * @see Connection::result_set(), Result_retrieval.
+ */
+class Result_set final : public Response {
+public:
+  /**
+   * @brief A column of a result set.
+   *
+   * @remarks The instance refers to the result object of libpq rather than to
+   * the Result_set, so it remains valid after the Result_set is moved.
+   */
+  class Column_view final {
+  public:
+    /// Default-constructible. (Constructs invalid instance.)
+    Column_view() = default;
+
+    /// @returns `true` if the instance is valid.
+    explicit operator bool() const noexcept
+    {
+      return static_cast<bool>(result_);
+    }
+
+    /// @returns The field index of the column.
+    std::size_t index() const noexcept
+    {
+      return static_cast<std::size_t>(index_);
+    }
+
+    /// @returns The field name of the column.
+    DMITIGR_PGFE_API std::string_view name() const noexcept;
+
+    /// @returns The number of values in the column.
+    DMITIGR_PGFE_API std::size_t size() const noexcept;
+
+    /**
+     * @returns The data of the column at row `row`, or invalid instance
+     * if SQL NULL.
+     *
+     * @par Requires
+     * `row < size()`.
+     */
+    DMITIGR_PGFE_API Data_view operator[](std::size_t row) const;
+
+    /// Constant iterator.
+    using Const_iterator = detail::Indexed_iterator<Column_view, Data_view,
+      &Column_view::operator[]>;
+
+    /// @returns Constant iterator that points to the value of zero row.
+    Const_iterator begin() const noexcept
+    {
+      return Const_iterator{this, 0};
+    }
+
+    /// @returns Constant iterator that points to the one-past-the-last value.
+    Const_iterator end() const noexcept
+    {
+      return Const_iterator{this, size()};
+    }
+
+  private:
+    friend Result_set;
+
+    const PGresult* result_{};
+    int index_{};
+
+    Column_view(const PGresult* const result, const int index) noexcept
+      : result_{result}
+      , index_{index}
+    {}
+  };
+
+  /// Default-constructible. (Constructs invalid instance.)
+  Result_set() = default;
+
+  /// Swaps this with `rhs`.
+  DMITIGR_PGFE_API void swap(Result_set& rhs) noexcept;
+
+  /// @see Message::is_valid().
+  DMITIGR_PGFE_API bool is_valid() const noexcept override;
+
+  /// @returns The information about the rows of this result set.
+  DMITIGR_PGFE_API const Row_info& info() const noexcept;
+
+  /// @returns The number of rows in this result set.
+  DMITIGR_PGFE_API std::size_t row_count() const noexcept;
+
+  /// @returns `!row_count()`.
+  DMITIGR_PGFE_API bool is_empty() const noexcept;
+
+  /**
+   * @returns The view of the row `row` of this result set.
+   *
+   * @par Requires
+   * `row < row_count()`.
+   */
+  DMITIGR_PGFE_API Row_view row(std::size_t row) const;
+
+  /// @returns `row(row)`.
+  Row_view operator[](const std::size_t row) const
+  {
+    return this->row(row);
+  }
+
+  /**
+   * @returns The field data of the specified row, or invalid instance if
+   * SQL NULL.
+   *
+   * @par Requires
+   * `(row < row_count()) && (field < info().field_count())`.
+   */
+  DMITIGR_PGFE_API Data_view data(std::size_t row, std::size_t field = 0) const;
+
+  /**
+   * @overload
+   *
+   * @par Requires
+   * `(row < row_count()) && (info().field_index(name, offset) < info().field_count())`.
+   */
+  DMITIGR_PGFE_API Data_view data(std::size_t row, std::string_view name,
+    std::size_t offset = 0) const;
+
+  /**
+   * @returns The view of the column `index` of this result set.
+   *
+   * @par Requires
+   * `index < info().field_count()`.
+   */
+  DMITIGR_PGFE_API Column_view column(std::size_t index) const;
+
+  /**
+   * @overload
+   *
+   * @par Requires
+   * `info().field_index(name, offset) < info().field_count()`.
+   */
+  DMITIGR_PGFE_API Column_view column(std::string_view name,
+    std::size_t offset = 0) const;
+
+  /// Constant iterator over the rows.
+  using Const_iterator = detail::Indexed_iterator<Result_set, Row_view,
+    &Result_set::row>;
+
+  /// @returns Constant iterator that points to a zero row.
+  Const_iterator begin() const noexcept
+  {
+    return Const_iterator{this, 0};
+  }
+
+  /// @returns Constant iterator that points to an one-past-the-last row.
+  Const_iterator end() const noexcept
+  {
+    return Const_iterator{this, row_count()};
+  }
+
+private:
+  friend Connection;
+
+  Row_info info_; // has pq_result_
+
+  explicit Result_set(detail::pq::Result&& pq_result) noexcept;
+
+  bool is_invariant_ok() const noexcept;
+};
+
+/**
+ * @ingroup main
+ *
+ * @brief Result_set is swappable.
+ */
+inline void swap(Result_set& lhs, Result_set& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace dmitigr::pgfe
+
+#ifndef DMITIGR_PGFE_NOT_HEADER_ONLY
+#include "result_set.cpp"
+#endif
+
+#endif  // DMITIGR_PGFE_RESULT_SET_HPP
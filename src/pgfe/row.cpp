@@ -21,43 +21,53 @@
 
 namespace dmitigr::pgfe {
 
+DMITIGR_PGFE_INLINE Row::Row(std::shared_ptr<const Row_info> batch_info,
+  const int row) noexcept
+  : batch_info_{std::move(batch_info)}
+  , row_{row}
+{
+  assert(is_invariant_ok());
+}
+
 DMITIGR_PGFE_INLINE void Row::swap(Row& rhs) noexcept
 {
   using std::swap;
   swap(info_, rhs.info_);
+  swap(batch_info_, rhs.batch_info_);
+  swap(row_, rhs.row_);
 }
 
 DMITIGR_PGFE_INLINE bool Row::is_valid() const noexcept
 {
-  return static_cast<bool>(info_.pq_result_);
+  return static_cast<bool>(info__().pq_result_);
 }
 
 DMITIGR_PGFE_INLINE std::size_t Row::field_count() const noexcept
 {
-  return info_.field_count();
+  return info__().field_count();
 }
 
 DMITIGR_PGFE_INLINE bool Row::is_empty() const noexcept
 {
-  return info_.is_empty();
+  return info__().is_empty();
 }
 
 DMITIGR_PGFE_INLINE std::string_view
 Row::field_name(const std::size_t index) const
 {
-  return info_.field_name(index);
+  return info__().field_name(index);
 }
 
 DMITIGR_PGFE_INLINE std::size_t
 Row::field_index(const std::string_view name,
   const std::size_t offset) const noexcept
 {
-  return info_.field_index(name, offset);
+  return info__().field_index(name, offset);
 }
 
 DMITIGR_PGFE_INLINE const Row_info& Row::info() const noexcept
 {
-  return info_;
+  return info__();
 }
 
 DMITIGR_PGFE_INLINE Data_view Row::data(const std::size_t index) const
@@ -65,12 +75,11 @@ DMITIGR_PGFE_INLINE Data_view Row::data(const std::size_t index) const
   if (!(index < field_count()))
     throw Client_exception{"cannot get field data of row"};
 
-  constexpr int row{};
   const auto fld = static_cast<int>(index);
-  const auto& r = info_.pq_result_;
-  return !r.is_data_null(row, fld) ?
-    Data_view{r.data_value(row, fld),
-    static_cast<std::size_t>(r.data_size(row, fld)), r.field_format(fld)} :
+  const auto& r = info__().pq_result_;
+  return !r.is_data_null(row_, fld) ?
+    Data_view{r.data_value(row_, fld),
+    static_cast<std::size_t>(r.data_size(row_, fld)), r.field_format(fld)} :
     Data_view{};
 }
 
@@ -82,7 +91,10 @@ DMITIGR_PGFE_INLINE Data_view Row::data(const std::string_view name,
 
 DMITIGR_PGFE_INLINE bool Row::is_invariant_ok() const noexcept
 {
-  const bool info_ok = info_.pq_result_.status() == PGRES_SINGLE_TUPLE;
+  const bool info_ok = batch_info_ ?
+    !info_ && batch_info_->pq_result_ &&
+    0 <= row_ && row_ < batch_info_->pq_result_.row_count() :
+    !row_ && info_.pq_result_.status() == PGRES_SINGLE_TUPLE;
   return info_ok && Composite::is_invariant_ok();
 }
 
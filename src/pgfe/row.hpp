@@ -25,6 +25,7 @@
 
 #include <cassert>
 #include <iterator>
+#include <memory>
 #include <type_traits>
 
 namespace dmitigr::pgfe {
@@ -232,7 +233,20 @@ public:
   /// @}
 
 private:
-  Row_info info_; // has pq_result_
+  friend Connection;
+  friend Row_batch;
+
+  Row_info info_; // has pq_result_ of the single row
+  std::shared_ptr<const Row_info> batch_info_; // has pq_result_ of the batch
+  int row_{}; // of the batch
+
+  const Row_info& info__() const noexcept
+  {
+    return batch_info_ ? *batch_info_ : info_;
+  }
+
+  /// Constructs the row which refers to the row `row` of the batch.
+  Row(std::shared_ptr<const Row_info> batch_info, int row) noexcept;
 
   bool is_invariant_ok() const noexcept override;
 };
@@ -0,0 +1,95 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exceptions.hpp"
+#include "row_batch.hpp"
+
+namespace dmitigr::pgfe {
+
+DMITIGR_PGFE_INLINE Row_batch::Row_batch(std::shared_ptr<const Row_info> info,
+  const int offset) noexcept
+  : info_{std::move(info)}
+  , offset_{offset}
+{
+  assert(is_invariant_ok());
+}
+
+DMITIGR_PGFE_INLINE void Row_batch::swap(Row_batch& rhs) noexcept
+{
+  using std::swap;
+  swap(info_, rhs.info_);
+  swap(offset_, rhs.offset_);
+}
+
+DMITIGR_PGFE_INLINE bool Row_batch::is_valid() const noexcept
+{
+  return info_ && info_->pq_result_;
+}
+
+DMITIGR_PGFE_INLINE const Row_info& Row_batch::info() const noexcept
+{
+  return *info_;
+}
+
+DMITIGR_PGFE_INLINE std::size_t Row_batch::row_count() const noexcept
+{
+  return static_cast<std::size_t>(info_->pq_result_.row_count() - offset_);
+}
+
+DMITIGR_PGFE_INLINE Data_view
+Row_batch::data(const std::size_t row, const std::size_t field) const
+{
+  if (!(row < row_count() && field < info_->field_count()))
+    throw Client_exception{"cannot get field data of row batch"};
+
+  const int rw{static_cast<int>(row) + offset_};
+  const auto fld = static_cast<int>(field);
+  const auto& r = info_->pq_result_;
+  return !r.is_data_null(rw, fld) ?
+    Data_view{r.data_value(rw, fld),
+    static_cast<std::size_t>(r.data_size(rw, fld)), r.field_format(fld)} :
+    Data_view{};
+}
+
+DMITIGR_PGFE_INLINE Data_view Row_batch::data(const std::size_t row,
+  const std::string_view name, const std::size_t offset) const
+{
+  return data(row, info_->field_index(name, offset));
+}
+
+DMITIGR_PGFE_INLINE Row Row_batch::row(const std::size_t row) const
+{
+  if (!(row < row_count()))
+    throw Client_exception{"cannot get row of row batch"};
+
+  return Row{info_, static_cast<int>(row) + offset_};
+}
+
+DMITIGR_PGFE_INLINE bool Row_batch::is_invariant_ok() const noexcept
+{
+  const auto status = info_->pq_result_.status();
+  const bool status_ok = status == PGRES_SINGLE_TUPLE ||
+    status == PGRES_TUPLES_OK
+#ifdef LIBPQ_HAS_CHUNK_MODE
+    || status == PGRES_TUPLES_CHUNK
+#endif
+    ;
+  const bool offset_ok = 0 <= offset_ &&
+    offset_ < info_->pq_result_.row_count();
+  return status_ok && offset_ok;
+}
+
+} // namespace dmitigr::pgfe
@@ -0,0 +1,117 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DMITIGR_PGFE_ROW_BATCH_HPP
+#define DMITIGR_PGFE_ROW_BATCH_HPP
+
+#include "data.hpp"
+#include "dll.hpp"
+#include "response.hpp"
+#include "row.hpp"
+#include "row_info.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+namespace dmitigr::pgfe {
+
+/**
+ * @ingroup main
+ *
+ * @brief A batch of rows produced by a PostgreSQL server.
+ *
+ * @details The rows of a batch share a single result object of libpq, so the
+ * row descriptors are allocated once per batch instead of once per row. The
+ * batches of more than one row are produced only if the chunked rows mode is
+ * supported by the libpq in use (PostgreSQL 17+), or if the whole result is
+ * retrieved. Otherwise, each batch contains exactly one row.
+ *
+ * @see Connection::set_row_batch_size(), Connection::row_batch().
+ */
+class Row_batch final : public Response {
+public:
+  /// Default-constructible. (Constructs invalid instance.)
+  Row_batch() = default;
+
+  /// Swaps this with `rhs`.
+  DMITIGR_PGFE_API void swap(Row_batch& rhs) noexcept;
+
+  /// @see Message::is_valid().
+  DMITIGR_PGFE_API bool is_valid() const noexcept override;
+
+  /// @returns The information about the rows of this batch.
+  DMITIGR_PGFE_API const Row_info& info() const noexcept;
+
+  /// @returns The number of rows in this batch.
+  DMITIGR_PGFE_API std::size_t row_count() const noexcept;
+
+  /**
+   * @returns The field data of the specified row of this batch, or invalid
+   * instance if SQL NULL.
+   *
+   * @par Requires
+   * `(row < row_count()) && (field < info().field_count())`.
+   */
+  DMITIGR_PGFE_API Data_view data(std::size_t row, std::size_t field = 0) const;
+
+  /**
+   * @overload
+   *
+   * @par Requires
+   * `(row < row_count()) && (info().field_index(name, offset) < info().field_count())`.
+   */
+  DMITIGR_PGFE_API Data_view data(std::size_t row, std::string_view name,
+    std::size_t offset = 0) const;
+
+  /**
+   * @returns The specified row of this batch.
+   *
+   * @par Requires
+   * `row < row_count()`.
+   *
+   * @remarks The row shares the data with this batch without copying.
+   */
+  DMITIGR_PGFE_API Row row(std::size_t row) const;
+
+private:
+  friend Connection;
+
+  std::shared_ptr<const Row_info> info_; // has pq_result_
+  int offset_{};
+
+  Row_batch(std::shared_ptr<const Row_info> info, int offset) noexcept;
+
+  bool is_invariant_ok() const noexcept;
+};
+
+/**
+ * @ingroup main
+ *
+ * @brief Row_batch is swappable.
+ */
+inline void swap(Row_batch& lhs, Row_batch& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace dmitigr::pgfe
+
+#ifndef DMITIGR_PGFE_NOT_HEADER_ONLY
+#include "row_batch.cpp"
+#endif
+
+#endif  // DMITIGR_PGFE_ROW_BATCH_HPP
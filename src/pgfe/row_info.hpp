@@ -207,7 +207,10 @@ public:
 private:
   friend Connection;
   friend Prepared_statement;
+  friend Result_set;
   friend Row;
+  friend Row_batch;
+  friend Row_view;
 
   detail::pq::Result pq_result_;
 
@@ -0,0 +1,89 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../base/assert.hpp"
+#include "exceptions.hpp"
+#include "row_view.hpp"
+
+namespace dmitigr::pgfe {
+
+DMITIGR_PGFE_INLINE Row_view::Row_view(const Row_info* const info,
+  const int row) noexcept
+  : info_{info}
+  , row_{row}
+{
+  DMITIGR_ASSERT(info_ && info_->is_valid());
+  DMITIGR_ASSERT(0 <= row_ && row_ < info_->pq_result_.row_count());
+}
+
+DMITIGR_PGFE_INLINE bool Row_view::is_valid() const noexcept
+{
+  return static_cast<bool>(info_);
+}
+
+DMITIGR_PGFE_INLINE std::size_t Row_view::field_count() const noexcept
+{
+  return info_->field_count();
+}
+
+DMITIGR_PGFE_INLINE bool Row_view::is_empty() const noexcept
+{
+  return info_->is_empty();
+}
+
+DMITIGR_PGFE_INLINE std::string_view
+Row_view::field_name(const std::size_t index) const
+{
+  return info_->field_name(index);
+}
+
+DMITIGR_PGFE_INLINE std::size_t
+Row_view::field_index(const std::string_view name,
+  const std::size_t offset) const noexcept
+{
+  return info_->field_index(name, offset);
+}
+
+DMITIGR_PGFE_INLINE const Row_info& Row_view::info() const noexcept
+{
+  return *info_;
+}
+
+DMITIGR_PGFE_INLINE std::size_t Row_view::row_number() const noexcept
+{
+  return static_cast<std::size_t>(row_);
+}
+
+DMITIGR_PGFE_INLINE Data_view Row_view::data(const std::size_t index) const
+{
+  if (!(index < field_count()))
+    throw Client_exception{"cannot get field data of row view"};
+
+  const auto fld = static_cast<int>(index);
+  const auto& r = info_->pq_result_;
+  return !r.is_data_null(row_, fld) ?
+    Data_view{r.data_value(row_, fld),
+    static_cast<std::size_t>(r.data_size(row_, fld)), r.field_format(fld)} :
+    Data_view{};
+}
+
+DMITIGR_PGFE_INLINE Data_view Row_view::data(const std::string_view name,
+  const std::size_t offset) const
+{
+  return data(field_index(name, offset));
+}
+
+} // namespace dmitigr::pgfe
@@ -0,0 +1,113 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DMITIGR_PGFE_ROW_VIEW_HPP
+#define DMITIGR_PGFE_ROW_VIEW_HPP
+
+#include "composite.hpp"
+#include "data.hpp"
+#include "dll.hpp"
+#include "row_info.hpp"
+
+#include <cstddef>
+#include <string_view>
+
+namespace dmitigr::pgfe {
+
+/**
+ * @ingroup main
+ *
+ * @brief A non-owning view of a row of a result which contains multiple rows.
+ *
+ * @warning The behavior is undefined if any method other than is_valid() is
+ * called on an instance after destruction or moving of the object it was
+ * obtained from.
+ *
+ * @see Result_set.
+ */
+class Row_view final : public Composite {
+public:
+  /// Default-constructible. (Constructs invalid instance.)
+  Row_view() = default;
+
+  /// @returns `true` if the instance is valid.
+  DMITIGR_PGFE_API bool is_valid() const noexcept;
+
+  /// @returns `true` if the instance is valid.
+  explicit operator bool() const noexcept
+  {
+    return is_valid();
+  }
+
+  /// @name Compositional overridings
+  /// @{
+
+  /// @see Compositional::field_count().
+  DMITIGR_PGFE_API std::size_t field_count() const noexcept override;
+
+  /// @see Compositional::is_empty().
+  DMITIGR_PGFE_API bool is_empty() const noexcept override;
+
+  /// @see Compositional::field_name().
+  DMITIGR_PGFE_API std::string_view
+  field_name(const std::size_t index) const override;
+
+  /// @see Compositional::field_index().
+  DMITIGR_PGFE_API std::size_t
+  field_index(const std::string_view name,
+    const std::size_t offset = 0) const noexcept override;
+
+  /// @}
+
+  /// @returns The information about the row.
+  DMITIGR_PGFE_API const Row_info& info() const noexcept;
+
+  /// @returns The row number of the viewed row.
+  DMITIGR_PGFE_API std::size_t row_number() const noexcept;
+
+  /**
+   * @returns The field data of the row, or invalid instance if SQL NULL.
+   *
+   * @par Requires
+   * `index < field_count()`.
+   */
+  DMITIGR_PGFE_API Data_view data(const std::size_t index = 0) const override;
+
+  /**
+   * @overload
+   *
+   * @par Requires
+   * `field_index(name, offset) < field_count()`.
+   */
+  DMITIGR_PGFE_API Data_view data(const std::string_view name,
+    std::size_t offset = 0) const override;
+
+private:
+  friend Result_set;
+
+  const Row_info* info_{};
+  int row_{};
+
+  Row_view(const Row_info* info, int row) noexcept;
+};
+
+} // namespace dmitigr::pgfe
+
+#ifndef DMITIGR_PGFE_NOT_HEADER_ONLY
+#include "row_view.cpp"
+#endif
+
+#endif  // DMITIGR_PGFE_ROW_VIEW_HPP
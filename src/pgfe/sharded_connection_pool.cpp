@@ -0,0 +1,227 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../base/assert.hpp"
+#include "sharded_connection_pool.hpp"
+
+#include <algorithm>
+
+namespace dmitigr::pgfe {
+
+DMITIGR_PGFE_INLINE
+Sharded_connection_pool::Sharded_connection_pool(const std::size_t shard_count,
+  const std::size_t shard_size, const Connection_options& options)
+{
+  if (!shard_count)
+    throw Client_exception{"cannot create sharded connection pool: "
+      "invalid shard count specified"};
+
+  shards_.reserve(shard_count);
+  for (std::size_t i{}; i < shard_count; ++i) {
+    shards_.push_back(std::make_unique<Connection_pool>(shard_size, options));
+    shards_.back()->free_handler_ = [this]
+    {
+      // Attention! The mutex of the shard is locked here!
+      ++free_count_;
+      if (waiter_count_) {
+        /*
+         * Locking the mutex guarantees that the waiter either sees the
+         * incremented free_count_ or is already waiting to be notified.
+         */
+        { const std::lock_guard lg{free_mutex_}; }
+        free_cv_.notify_one();
+      }
+    };
+  }
+}
+
+DMITIGR_PGFE_INLINE bool Sharded_connection_pool::is_valid() const noexcept
+{
+  return !shards_.empty();
+}
+
+DMITIGR_PGFE_INLINE void Sharded_connection_pool::set_connect_handler(
+  std::function<void(Connection&)> handler)
+{
+  for (auto& shard : shards_)
+    shard->set_connect_handler(handler);
+}
+
+DMITIGR_PGFE_INLINE void Sharded_connection_pool::set_release_handler(
+  std::function<void(Connection&)> handler)
+{
+  for (auto& shard : shards_)
+    shard->set_release_handler(handler);
+}
+
+DMITIGR_PGFE_INLINE void Sharded_connection_pool::connect()
+{
+  try {
+    for (auto& shard : shards_)
+      shard->connect();
+  } catch (...) {
+    disconnect();
+    throw;
+  }
+}
+
+DMITIGR_PGFE_INLINE void Sharded_connection_pool::disconnect() noexcept
+{
+  for (auto& shard : shards_)
+    shard->disconnect();
+}
+
+DMITIGR_PGFE_INLINE bool Sharded_connection_pool::is_connected() const noexcept
+{
+  return is_valid() && std::all_of(shards_.cbegin(), shards_.cend(),
+    [](const auto& shard){return shard->is_connected();});
+}
+
+DMITIGR_PGFE_INLINE auto Sharded_connection_pool::connection() -> Handle
+{
+  if (!is_valid())
+    throw Client_exception{"cannot obtain connection from invalid "
+      "sharded connection pool"};
+
+  const auto index = local_shard_index();
+  if (auto result = shards_[index]->connection())
+    return result;
+  return steal__(index);
+}
+
+DMITIGR_PGFE_INLINE auto Sharded_connection_pool::connection(
+  const std::optional<std::chrono::milliseconds> timeout) -> Handle
+{
+  if (!is_valid())
+    throw Client_exception{"cannot obtain connection from invalid "
+      "sharded connection pool"};
+
+  using std::chrono::milliseconds;
+
+  if (!(!timeout || timeout >= milliseconds::zero()))
+    throw Client_exception{"cannot obtain connection from sharded connection "
+      "pool: invalid timeout specified"};
+
+  const auto deadline = timeout ? Clock::now() + *timeout : Clock::time_point{};
+  const auto index = local_shard_index();
+  auto& local = *shards_[index];
+  while (true) {
+    /*
+     * The count of releases is taken before trying the shards in order to
+     * not miss the release happened meanwhile.
+     */
+    const auto free_count = free_count_.load();
+    if (auto result = local.connection())
+      return result;
+    else if (auto result = steal__(index))
+      return result;
+
+    const auto is_freed = [this, free_count]
+    {
+      return free_count_.load() != free_count;
+    };
+    std::unique_lock lk{free_mutex_};
+    ++waiter_count_; // before checking is_freed() by the waiting below
+    bool is_timed_out{};
+    if (timeout)
+      is_timed_out = !free_cv_.wait_until(lk, deadline, is_freed);
+    else
+      free_cv_.wait(lk, is_freed);
+    --waiter_count_;
+    if (is_timed_out)
+      throw Client_exception{Client_errc::timed_out,
+        "cannot obtain connection from sharded connection pool: "
+        "timeout expired"};
+  }
+}
+
+DMITIGR_PGFE_INLINE std::size_t
+Sharded_connection_pool::shard_count() const noexcept
+{
+  return shards_.size();
+}
+
+DMITIGR_PGFE_INLINE Connection_pool&
+Sharded_connection_pool::shard(const std::size_t index)
+{
+  return const_cast<Connection_pool&>(
+    static_cast<const Sharded_connection_pool*>(this)->shard(index));
+}
+
+DMITIGR_PGFE_INLINE const Connection_pool&
+Sharded_connection_pool::shard(const std::size_t index) const
+{
+  if (!(index < shard_count()))
+    throw Client_exception{"cannot get shard of sharded connection pool: "
+      "invalid index specified"};
+  return *shards_[index];
+}
+
+DMITIGR_PGFE_INLINE std::size_t
+Sharded_connection_pool::local_shard_index() const
+{
+  if (!is_valid())
+    throw Client_exception{"cannot get local shard index of invalid "
+      "sharded connection pool"};
+
+  static std::atomic<std::size_t> thread_count;
+  thread_local const std::size_t thread_number{
+    thread_count.fetch_add(1, std::memory_order_relaxed)};
+  return thread_number % shards_.size();
+}
+
+DMITIGR_PGFE_INLINE std::size_t Sharded_connection_pool::size() const noexcept
+{
+  std::size_t result{};
+  for (const auto& shard : shards_)
+    result += shard->size();
+  return result;
+}
+
+DMITIGR_PGFE_INLINE std::size_t
+Sharded_connection_pool::free_count() const noexcept
+{
+  std::size_t result{};
+  for (const auto& shard : shards_)
+    result += shard->free_count();
+  return result;
+}
+
+DMITIGR_PGFE_INLINE std::size_t
+Sharded_connection_pool::steal_count() const noexcept
+{
+  return steal_count_.load(std::memory_order_relaxed);
+}
+
+DMITIGR_PGFE_INLINE auto
+Sharded_connection_pool::steal__(const std::size_t local_index) -> Handle
+{
+  DMITIGR_ASSERT(local_index < shards_.size());
+  const auto count = shards_.size();
+  for (std::size_t i{1}; i < count; ++i) {
+    auto& victim = *shards_[(local_index + i) % count];
+    if (!victim.free_count())
+      continue; // don't reopen the closed connections of the other shard
+
+    if (auto result = victim.connection()) {
+      steal_count_.fetch_add(1, std::memory_order_relaxed);
+      return result;
+    }
+  }
+  return Handle{};
+}
+
+} // namespace dmitigr::pgfe
@@ -0,0 +1,187 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DMITIGR_PGFE_SHARDED_CONNECTION_POOL_HPP
+#define DMITIGR_PGFE_SHARDED_CONNECTION_POOL_HPP
+
+#include "connection_pool.hpp"
+#include "dll.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace dmitigr::pgfe {
+
+/**
+ * @ingroup utilities
+ *
+ * @brief A thread-safe pool of connections split into the shards.
+ *
+ * @details Each shard is a Connection_pool with its own lock. Each thread is
+ * bound to the local shard (the threads are distributed among the shards in
+ * round-robin order upon the first use), so the threads bound to the
+ * different shards don't contend for the lock upon acquiring and releasing
+ * the connections. If the local shard is exhausted, a free connection is
+ * stolen from the other shards. The connection is always returned to the
+ * shard it's acquired from.
+ *
+ * @remarks It's recommended to use as many shards as there are hardware
+ * threads.
+ */
+class Sharded_connection_pool final {
+public:
+  /// The alias of Connection_pool::Handle.
+  using Handle = Connection_pool::Handle;
+
+  /// Default-constructible. (Constructs invalid instance.)
+  Sharded_connection_pool() = default;
+
+  /// Not copy-constructible.
+  Sharded_connection_pool(const Sharded_connection_pool&) = delete;
+
+  /// Not move-constructible.
+  Sharded_connection_pool(Sharded_connection_pool&&) = delete;
+
+  /// Not copy-assignable.
+  Sharded_connection_pool& operator=(const Sharded_connection_pool&) = delete;
+
+  /// Not move-assignable.
+  Sharded_connection_pool& operator=(Sharded_connection_pool&&) = delete;
+
+  /**
+   * @brief The constructor.
+   *
+   * @param shard_count A number of shards.
+   * @param shard_size A number of connections in each shard.
+   * @param options A connection options to be used for connections of pool.
+   *
+   * @par Requires
+   * `shard_count > 0`.
+   */
+  DMITIGR_PGFE_API Sharded_connection_pool(std::size_t shard_count,
+    std::size_t shard_size, const Connection_options& options = {});
+
+  /// @returns `true` if this instance is valid.
+  DMITIGR_PGFE_API bool is_valid() const noexcept;
+
+  /// @returns `is_valid()`.
+  explicit operator bool() const noexcept
+  {
+    return is_valid();
+  }
+
+  /// Sets the connect handler of each shard.
+  DMITIGR_PGFE_API void set_connect_handler(std::function<void(Connection&)> handler);
+
+  /// Sets the release handler of each shard.
+  DMITIGR_PGFE_API void
+  set_release_handler(std::function<void(Connection&)> handler);
+
+  /**
+   * @brief Opens the connections of each shard.
+   *
+   * @details If any shard cannot be connected, all the shards are disconnected.
+   *
+   * @par Effects
+   * `is_connected() == is_valid()` on success.
+   */
+  DMITIGR_PGFE_API void connect();
+
+  /// Closes the connections of each shard.
+  DMITIGR_PGFE_API void disconnect() noexcept;
+
+  /// @returns `true` if the pool is connected.
+  DMITIGR_PGFE_API bool is_connected() const noexcept;
+
+  /**
+   * @returns The valid connection handle if there is a free connection in the
+   * local shard or in any other shard, or invalid handle otherwise.
+   *
+   * @throws Client_exception as Connection_pool::connection().
+   */
+  DMITIGR_PGFE_API Handle connection();
+
+  /**
+   * @brief Waits for a free connection in any shard if there are no free
+   * connections in all the shards.
+   *
+   * @details Upon the release of a connection to any shard the local shard
+   * is tried first, and then the other shards are tried to steal from. The
+   * threads waiting by Connection_pool::connection(timeout) of the shard
+   * take precedence.
+   *
+   * @throws Client_exception as Connection_pool::connection(timeout).
+   */
+  DMITIGR_PGFE_API Handle connection(std::optional<std::chrono::milliseconds> timeout);
+
+  /// @returns The number of shards.
+  DMITIGR_PGFE_API std::size_t shard_count() const noexcept;
+
+  /**
+   * @returns The shard at `index`.
+   *
+   * @par Requires
+   * `index < shard_count()`.
+   */
+  DMITIGR_PGFE_API Connection_pool& shard(std::size_t index);
+
+  /// @overload
+  DMITIGR_PGFE_API const Connection_pool& shard(std::size_t index) const;
+
+  /**
+   * @returns The index of the shard which is local to the calling thread.
+   *
+   * @par Requires
+   * `is_valid()`.
+   */
+  DMITIGR_PGFE_API std::size_t local_shard_index() const;
+
+  /// @returns The total number of connections in all the shards.
+  DMITIGR_PGFE_API std::size_t size() const noexcept;
+
+  /// @returns The total number of free connections in all the shards.
+  DMITIGR_PGFE_API std::size_t free_count() const noexcept;
+
+  /// @returns The number of connections stolen from the non-local shards.
+  DMITIGR_PGFE_API std::size_t steal_count() const noexcept;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  std::vector<std::unique_ptr<Connection_pool>> shards_;
+  std::atomic<std::size_t> steal_count_{};
+  std::mutex free_mutex_; // locked only if there are waiters
+  std::condition_variable free_cv_; // notified upon release to any shard
+  std::atomic<std::uint_fast64_t> free_count_{}; // of releases
+  std::atomic<std::size_t> waiter_count_{}; // of free_cv_
+
+  Handle steal__(std::size_t local_index);
+};
+
+} // namespace dmitigr::pgfe
+
+#ifndef DMITIGR_PGFE_NOT_HEADER_ONLY
+#include "sharded_connection_pool.cpp"
+#endif
+
+#endif  // DMITIGR_PGFE_SHARDED_CONNECTION_POOL_HPP
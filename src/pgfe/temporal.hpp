@@ -0,0 +1,970 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DMITIGR_PGFE_TEMPORAL_HPP
+#define DMITIGR_PGFE_TEMPORAL_HPP
+
+#include "../base/assert.hpp"
+#include "../net/conversions.hpp"
+#include "basic_conversions.hpp"
+#include "basics.hpp"
+#include "conversions_api.hpp"
+#include "data.hpp"
+#include "exceptions.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <ratio>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace dmitigr::pgfe {
+
+/**
+ * @ingroup conversions
+ *
+ * @brief The pseudo-clock of the local time of unspecified time zone.
+ *
+ * @details Denotes the PostgreSQL `timestamp` (without time zone), like
+ * `std::chrono::local_t` of C++20.
+ *
+ * @see Local_time.
+ */
+struct Local_t final {};
+
+/**
+ * @ingroup conversions
+ *
+ * @brief The local time (PostgreSQL `timestamp`).
+ *
+ * @details The PostgreSQL `timestamptz` is represented by
+ * `std::chrono::time_point<std::chrono::system_clock, Duration>`.
+ */
+template<class Duration>
+using Local_time = std::chrono::time_point<Local_t, Duration>;
+
+/**
+ * @ingroup conversions
+ *
+ * @brief The date of proleptic Gregorian calendar (PostgreSQL `date`).
+ *
+ * @details Like `std::chrono::year_month_day` of C++20. The year `0` denotes
+ * 1 BC, the year `-1` denotes 2 BC and so on.
+ */
+struct Date final {
+  /// The year.
+  int year{1970};
+
+  /// The month in range [1, 12].
+  unsigned month{1};
+
+  /// The day in range [1, 31].
+  unsigned day{1};
+
+  /// @returns The date which is `days` after 1970-01-01.
+  static constexpr Date from_days(std::int64_t days) noexcept
+  {
+    // See http://howardhinnant.github.io/date_algorithms.html
+    days += 719468;
+    const std::int64_t era{(days >= 0 ? days : days - 146096) / 146097};
+    const auto doe = static_cast<unsigned>(days - era * 146097);
+    const unsigned yoe{(doe - doe/1460 + doe/36524 - doe/146096) / 365};
+    const unsigned doy{doe - (365*yoe + yoe/4 - yoe/100)};
+    const unsigned mp{(5*doy + 2) / 153};
+    const unsigned month{mp < 10 ? mp + 3 : mp - 9};
+    return Date{static_cast<int>(yoe + era * 400 + (month <= 2)), month,
+      doy - (153*mp + 2)/5 + 1};
+  }
+
+  /// @returns The number of days since 1970-01-01.
+  constexpr std::int64_t to_days() const noexcept
+  {
+    const std::int64_t y{static_cast<std::int64_t>(year) - (month <= 2)};
+    const std::int64_t era{(y >= 0 ? y : y - 399) / 400};
+    const auto yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy{(153*(month > 2 ? month - 3 : month + 9) + 2)/5 + day - 1};
+    const unsigned doe{yoe * 365 + yoe/4 - yoe/100 + doy};
+    return era * 146097 + static_cast<std::int64_t>(doe) - 719468;
+  }
+
+  /// @returns `true` if this instance represents the existing date.
+  constexpr bool is_valid() const noexcept
+  {
+    if (!(1 <= month && month <= 12 && 1 <= day))
+      return false;
+
+    constexpr unsigned char last_days[]{31,28,31,30,31,30,31,31,30,31,30,31};
+    const bool is_leap{year % 4 == 0 && (year % 100 != 0 || year % 400 == 0)};
+    return day <= last_days[month - 1] + unsigned{month == 2 && is_leap};
+  }
+};
+
+/// @returns `true` if `lhs` is equal to `rhs`.
+constexpr bool operator==(const Date& lhs, const Date& rhs) noexcept
+{
+  return lhs.year == rhs.year && lhs.month == rhs.month && lhs.day == rhs.day;
+}
+
+/// @returns `true` if `lhs` is not equal to `rhs`.
+constexpr bool operator!=(const Date& lhs, const Date& rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+
+/// @returns `true` if `lhs` is less than `rhs`.
+constexpr bool operator<(const Date& lhs, const Date& rhs) noexcept
+{
+  return lhs.to_days() < rhs.to_days();
+}
+
+/**
+ * @ingroup conversions
+ *
+ * @brief The time of day (PostgreSQL `time`).
+ *
+ * @details Like `std::chrono::hh_mm_ss<std::chrono::microseconds>` of C++20.
+ */
+class Time_of_day final {
+public:
+  /// Constructs the midnight.
+  constexpr Time_of_day() noexcept = default;
+
+  /**
+   * @brief The constructor.
+   *
+   * @par Requires
+   * `0 <= since_midnight <= 24h`.
+   */
+  constexpr explicit Time_of_day(
+    const std::chrono::microseconds since_midnight) noexcept
+    : since_midnight_{since_midnight}
+  {}
+
+  /// @returns The hours since midnight.
+  constexpr std::chrono::hours hours() const noexcept
+  {
+    return std::chrono::duration_cast<std::chrono::hours>(since_midnight_);
+  }
+
+  /// @returns The minutes since the start of hour.
+  constexpr std::chrono::minutes minutes() const noexcept
+  {
+    return std::chrono::duration_cast<std::chrono::minutes>(
+      since_midnight_ - hours());
+  }
+
+  /// @returns The seconds since the start of minute.
+  constexpr std::chrono::seconds seconds() const noexcept
+  {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+      since_midnight_ - hours() - minutes());
+  }
+
+  /// @returns The fractional part of seconds.
+  constexpr std::chrono::microseconds subseconds() const noexcept
+  {
+    return since_midnight_ - hours() - minutes() - seconds();
+  }
+
+  /// @returns The time since midnight.
+  constexpr std::chrono::microseconds to_duration() const noexcept
+  {
+    return since_midnight_;
+  }
+
+private:
+  std::chrono::microseconds since_midnight_{};
+};
+
+/// @returns `true` if `lhs` is equal to `rhs`.
+constexpr bool operator==(const Time_of_day& lhs, const Time_of_day& rhs) noexcept
+{
+  return lhs.to_duration() == rhs.to_duration();
+}
+
+/// @returns `true` if `lhs` is not equal to `rhs`.
+constexpr bool operator!=(const Time_of_day& lhs, const Time_of_day& rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+
+/// @returns `true` if `lhs` is less than `rhs`.
+constexpr bool operator<(const Time_of_day& lhs, const Time_of_day& rhs) noexcept
+{
+  return lhs.to_duration() < rhs.to_duration();
+}
+
+/**
+ * @ingroup conversions
+ *
+ * @brief The time interval (PostgreSQL `interval`).
+ *
+ * @details The months, days and time are stored separately, since the number
+ * of days in month and the number of hours in day vary.
+ */
+struct Interval final {
+  /// The number of months.
+  std::int32_t months{};
+
+  /// The number of days.
+  std::int32_t days{};
+
+  /// The time.
+  std::chrono::microseconds time{};
+};
+
+/// @returns `true` if `lhs` is equal to `rhs`.
+constexpr bool operator==(const Interval& lhs, const Interval& rhs) noexcept
+{
+  return lhs.months == rhs.months && lhs.days == rhs.days &&
+    lhs.time == rhs.time;
+}
+
+/// @returns `true` if `lhs` is not equal to `rhs`.
+constexpr bool operator!=(const Interval& lhs, const Interval& rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+
+namespace detail {
+
+/// The number of days between 1970-01-01 and 2000-01-01 (PostgreSQL epoch).
+constexpr std::int64_t postgres_epoch_days{10957};
+
+/// The number of microseconds per day.
+constexpr std::int64_t microseconds_per_day{86400000000};
+
+/// The number of microseconds between 1970-01-01 and 2000-01-01.
+constexpr std::int64_t postgres_epoch_microseconds{
+  postgres_epoch_days * microseconds_per_day};
+
+/// The cursor over the text representation of temporal value.
+class Temporal_text final {
+public:
+  /// The constructor.
+  Temporal_text(const char* const text, const std::size_t size,
+    const char* const type_name) noexcept
+    : pos_{text}
+    , end_{text + size}
+    , type_name_{type_name}
+  {}
+
+  /// @returns `true` if the whole text is consumed.
+  bool is_end() const noexcept
+  {
+    return pos_ == end_;
+  }
+
+  /// @returns The next character, or `0` if `is_end()`.
+  char peek() const noexcept
+  {
+    return !is_end() ? *pos_ : '\0';
+  }
+
+  /// @returns `true` if the next character is `c` which is consumed.
+  bool skip(const char c) noexcept
+  {
+    if (peek() != c || is_end())
+      return false;
+    ++pos_;
+    return true;
+  }
+
+  /// @returns `true` if the text continues with `word` which is consumed.
+  bool skip(const std::string_view word) noexcept
+  {
+    if (static_cast<std::size_t>(end_ - pos_) < word.size() ||
+      std::string_view{pos_, word.size()} != word)
+      return false;
+    pos_ += word.size();
+    return true;
+  }
+
+  /// Consumes the spaces.
+  void skip_spaces() noexcept
+  {
+    while (skip(' '));
+  }
+
+  /// Consumes `c` or throws.
+  void expect(const char c)
+  {
+    if (!skip(c))
+      fail();
+  }
+
+  /// Throws if the text is not consumed completely.
+  void finish() const
+  {
+    if (!is_end())
+      fail();
+  }
+
+  /// @returns The unsigned number of at most 18 digits.
+  std::int64_t number()
+  {
+    const char* const first{pos_};
+    std::int64_t result{};
+    for (; !is_end() && is_digit(*pos_) && pos_ - first < 18; ++pos_)
+      result = result*10 + (*pos_ - '0');
+    if (pos_ == first)
+      fail();
+    return result;
+  }
+
+  /// @returns The microseconds of the fraction of second after the point.
+  std::int64_t fraction()
+  {
+    std::int64_t result{};
+    int digits{};
+    for (; !is_end() && is_digit(*pos_); ++pos_, ++digits) {
+      if (digits < 6)
+        result = result*10 + (*pos_ - '0');
+    }
+    if (!digits)
+      fail();
+    for (; digits < 6; ++digits)
+      result *= 10;
+    return result;
+  }
+
+  /**
+   * @returns The date in format `Y-MM-DD` with the year not yet converted by
+   * era(), and thus not yet validated.
+   */
+  Date date()
+  {
+    const auto year = number();
+    expect('-');
+    const auto month = number();
+    expect('-');
+    const auto day = number();
+    if (!(1 <= year && year <= 5874897 && month <= 12 && day <= 31))
+      fail();
+
+    return Date{static_cast<int>(year), static_cast<unsigned>(month),
+      static_cast<unsigned>(day)};
+  }
+
+  /**
+   * @brief Consumes the era suffix ` BC` if any, converts the year of `date`
+   * returned by date() to the astronomical one accordingly and validates it.
+   */
+  void era(Date& date)
+  {
+    if (bc())
+      date.year = 1 - date.year;
+    if (!date.is_valid())
+      fail();
+  }
+
+  /// @returns The microseconds since midnight in format `HH:MM[:SS[.F]]`.
+  std::int64_t time_of_day()
+  {
+    const auto result = time();
+    if (!(result <= microseconds_per_day))
+      fail();
+    return result;
+  }
+
+  /// @returns The microseconds in format `H:MM[:SS[.F]]`.
+  std::int64_t time()
+  {
+    const auto hours = number();
+    expect(':');
+    return time(hours);
+  }
+
+  /// @overload
+  std::int64_t time(const std::int64_t hours)
+  {
+    const auto minutes = number();
+    const auto seconds = skip(':') ? number() : 0;
+    const auto subseconds = skip('.') ? fraction() : 0;
+    if (!(hours < 2562047787 && minutes < 60 && seconds <= 60))
+      fail();
+    return ((hours*60 + minutes)*60 + seconds)*1000000 + subseconds;
+  }
+
+  /// @returns The seconds of time zone offset in format `{+|-}HH[:MM[:SS]]`.
+  std::int64_t zone_offset()
+  {
+    const int sign{skip('-') ? -1 : (expect('+'), 1)};
+    const auto hours = number();
+    const auto minutes = skip(':') ? number() : 0;
+    const auto seconds = skip(':') ? number() : 0;
+    if (!(hours < 24 && minutes < 60 && seconds < 60))
+      fail();
+    return sign * ((hours*60 + minutes)*60 + seconds);
+  }
+
+  /// @returns `true` if the era suffix ` BC` is consumed.
+  bool bc() noexcept
+  {
+    return skip(std::string_view{" BC"});
+  }
+
+  /// Throws the exception on invalid text representation.
+  [[noreturn]] void fail() const
+  {
+    throw Client_exception{std::string{"cannot convert to "}.append(type_name_)
+      .append(": invalid text representation")};
+  }
+
+private:
+  const char* pos_{};
+  const char* end_{};
+  const char* type_name_{};
+
+  static bool is_digit(const char c) noexcept
+  {
+    return '0' <= c && c <= '9';
+  }
+};
+
+/// Appends `value` padded with zeros to at least `width` digits to `result`.
+inline void append_temporal_digits(std::string& result, std::int64_t value,
+  int width)
+{
+  char buffer[20];
+  char* pos{buffer + sizeof(buffer)};
+  do {
+    *--pos = static_cast<char>('0' + value % 10);
+    value /= 10;
+    --width;
+  } while (value || width > 0);
+  result.append(pos, buffer + sizeof(buffer) - pos);
+}
+
+/// Appends the date in format `YYYY-MM-DD` without the era to `result`.
+inline void append_temporal_date(std::string& result, const Date value)
+{
+  append_temporal_digits(result, value.year > 0 ? value.year : 1 - value.year, 4);
+  result += '-';
+  append_temporal_digits(result, value.month, 2);
+  result += '-';
+  append_temporal_digits(result, value.day, 2);
+}
+
+/// Appends the time in format `HH:MM:SS[.FFFFFF]` to `result`.
+inline void append_temporal_time(std::string& result, const std::int64_t value)
+{
+  DMITIGR_ASSERT(value >= 0);
+  append_temporal_digits(result, value / 3600000000, 2);
+  result += ':';
+  append_temporal_digits(result, value / 60000000 % 60, 2);
+  result += ':';
+  append_temporal_digits(result, value / 1000000 % 60, 2);
+  if (const auto subseconds = value % 1000000) {
+    result += '.';
+    append_temporal_digits(result, subseconds, 6);
+  }
+}
+
+/// @returns The 8-byte integer read from the data in binary format.
+inline std::int64_t read_temporal_int64(const char* const bytes,
+  const std::size_t size, const char* const type_name)
+{
+  if (size != 8)
+    throw Client_exception{std::string{"cannot convert to "}.append(type_name)
+      .append(": invalid input size")};
+  return net::conv<std::int64_t>(bytes, size);
+}
+
+/// Appends the integer `value` to the `result` in network byte order.
+template<typename T>
+void append_temporal_int(std::string& result, const T value)
+{
+  char buffer[sizeof(value)];
+  net::copy(buffer, sizeof(buffer), value);
+  result.append(buffer, sizeof(buffer));
+}
+
+/// Throws the exception on out of range value.
+[[noreturn]] inline void throw_temporal_out_of_range(const char* const type_name)
+{
+  throw Client_exception{std::string{"cannot convert to "}.append(type_name)
+    .append(": value out of range")};
+}
+
+/**
+ * @brief The codec of PostgreSQL `timestamp` and `timestamptz`.
+ *
+ * @details Infinite timestamps are represented by `Type::max()` and
+ * `Type::min()`.
+ */
+template<class Clock, class Duration>
+struct Timestamp_codec final {
+  using Type = std::chrono::time_point<Clock, Duration>;
+  static constexpr bool with_time_zone{
+    std::is_same_v<Clock, std::chrono::system_clock>};
+  static constexpr const char* name{with_time_zone ? "timestamptz" : "timestamp"};
+  static constexpr Oid binary_type_oid{with_time_zone ? 1184u : 1114u};
+
+  /// @returns The time point of microseconds since PostgreSQL epoch.
+  static Type from_postgres(const std::int64_t value)
+  {
+    using std::chrono::microseconds;
+    constexpr auto max = std::numeric_limits<std::int64_t>::max();
+    constexpr auto min = std::numeric_limits<std::int64_t>::min();
+    if (value == max)
+      return Type::max();
+    else if (value == min)
+      return Type::min();
+    else if (value > max - postgres_epoch_microseconds)
+      throw_temporal_out_of_range(name);
+
+    const microseconds since_epoch{value + postgres_epoch_microseconds};
+    if constexpr (std::ratio_less_v<typename Duration::period, std::micro>) {
+      constexpr auto max_duration =
+        std::chrono::duration_cast<microseconds>(Duration::max());
+      constexpr auto min_duration =
+        std::chrono::duration_cast<microseconds>(Duration::min());
+      if (!(min_duration <= since_epoch && since_epoch <= max_duration))
+        throw_temporal_out_of_range(name);
+      return Type{std::chrono::duration_cast<Duration>(since_epoch)};
+    } else
+      return Type{std::chrono::floor<Duration>(since_epoch)};
+  }
+
+  /// @returns The microseconds since PostgreSQL epoch.
+  static std::int64_t to_postgres(const Type& value)
+  {
+    constexpr auto max = std::numeric_limits<std::int64_t>::max();
+    constexpr auto min = std::numeric_limits<std::int64_t>::min();
+    if (value == Type::max())
+      return max;
+    else if (value == Type::min())
+      return min;
+
+    const auto since_epoch = std::chrono::floor<std::chrono::microseconds>(
+      value.time_since_epoch()).count();
+    if (since_epoch < min + postgres_epoch_microseconds)
+      throw_temporal_out_of_range(name);
+    return since_epoch - postgres_epoch_microseconds;
+  }
+
+  static Type from_binary(const char* const bytes, const std::size_t size)
+  {
+    return from_postgres(read_temporal_int64(bytes, size, name));
+  }
+
+  static std::string to_binary(const Type& value)
+  {
+    std::string result;
+    append_temporal_int(result, to_postgres(value));
+    return result;
+  }
+
+  /**
+   * @returns The time point parsed from the ISO 8601 representation, i.e.
+   * `YYYY-MM-DD{ |T}HH:MM:SS[.FFFFFF][{+|-}HH[:MM[:SS]]][ BC]`, or
+   * `[-]infinity`. The time zone offset is optional and allowed only for
+   * `timestamptz`.
+   */
+  static Type from_text(const char* const text, const std::size_t size)
+  {
+    Temporal_text input{text, size, name};
+    if (input.skip(std::string_view{"infinity"}))
+      return input.finish(), Type::max();
+    else if (input.skip(std::string_view{"-infinity"}))
+      return input.finish(), Type::min();
+
+    auto date = input.date();
+    if (!input.skip(' '))
+      input.expect('T');
+    const auto time = input.time_of_day();
+    std::int64_t offset{};
+    if constexpr (with_time_zone) {
+      if (input.peek() == '+' || input.peek() == '-')
+        offset = input.zone_offset();
+    }
+    input.era(date);
+    input.finish();
+
+    const auto days = date.to_days() - postgres_epoch_days;
+    constexpr auto max_days =
+      std::numeric_limits<std::int64_t>::max() / microseconds_per_day - 1;
+    if (!(-max_days <= days && days <= max_days))
+      throw_temporal_out_of_range(name);
+    return from_postgres(days*microseconds_per_day + time - offset*1000000);
+  }
+
+  /**
+   * @returns The ISO 8601 representation. The time zone offset of `timestamptz`
+   * is always `+00`.
+   */
+  static std::string to_text(const Type& value)
+  {
+    const auto since_epoch = to_postgres(value);
+    if (since_epoch == std::numeric_limits<std::int64_t>::max())
+      return "infinity";
+    else if (since_epoch == std::numeric_limits<std::int64_t>::min())
+      return "-infinity";
+
+    auto days = since_epoch / microseconds_per_day;
+    auto time = since_epoch % microseconds_per_day;
+    if (time < 0) {
+      --days;
+      time += microseconds_per_day;
+    }
+    const auto date = Date::from_days(days + postgres_epoch_days);
+    std::string result;
+    append_temporal_date(result, date);
+    result += ' ';
+    append_temporal_time(result, time);
+    if constexpr (with_time_zone)
+      result.append("+00");
+    if (date.year <= 0)
+      result.append(" BC");
+    return result;
+  }
+};
+
+/// The codec of PostgreSQL `date`.
+struct Date_codec final {
+  using Type = Date;
+  static constexpr const char* name{"date"};
+  static constexpr Oid binary_type_oid{1082};
+
+  static Type from_binary(const char* const bytes, const std::size_t size)
+  {
+    if (size != 4)
+      throw Client_exception{"cannot convert to date: invalid input size"};
+    const auto days = net::conv<std::int32_t>(bytes, size);
+    if (days == std::numeric_limits<std::int32_t>::max() ||
+      days == std::numeric_limits<std::int32_t>::min())
+      throw_temporal_out_of_range(name);
+    return Date::from_days(days + postgres_epoch_days);
+  }
+
+  static std::string to_binary(const Type& value)
+  {
+    const auto days = value.to_days() - postgres_epoch_days;
+    if (!(std::numeric_limits<std::int32_t>::min() < days &&
+        days < std::numeric_limits<std::int32_t>::max()))
+      throw_temporal_out_of_range(name);
+    std::string result;
+    append_temporal_int(result, static_cast<std::int32_t>(days));
+    return result;
+  }
+
+  /// @returns The date parsed from the representation `YYYY-MM-DD[ BC]`.
+  static Type from_text(const char* const text, const std::size_t size)
+  {
+    Temporal_text input{text, size, name};
+    auto result = input.date();
+    input.era(result);
+    input.finish();
+    return result;
+  }
+
+  static std::string to_text(const Type& value)
+  {
+    std::string result;
+    append_temporal_date(result, value);
+    if (value.year <= 0)
+      result.append(" BC");
+    return result;
+  }
+};
+
+/// The codec of PostgreSQL `time`.
+struct Time_of_day_codec final {
+  using Type = Time_of_day;
+  static constexpr const char* name{"time"};
+  static constexpr Oid binary_type_oid{1083};
+
+  static Type from_binary(const char* const bytes, const std::size_t size)
+  {
+    const auto result = read_temporal_int64(bytes, size, name);
+    if (!(0 <= result && result <= microseconds_per_day))
+      throw_temporal_out_of_range(name);
+    return Type{std::chrono::microseconds{result}};
+  }
+
+  static std::string to_binary(const Type& value)
+  {
+    std::string result;
+    append_temporal_int(result, to_postgres(value));
+    return result;
+  }
+
+  /// @returns The time parsed from the representation `HH:MM[:SS[.FFFFFF]]`.
+  static Type from_text(const char* const text, const std::size_t size)
+  {
+    Temporal_text input{text, size, name};
+    const auto result = input.time_of_day();
+    input.finish();
+    return Type{std::chrono::microseconds{result}};
+  }
+
+  static std::string to_text(const Type& value)
+  {
+    std::string result;
+    append_temporal_time(result, to_postgres(value));
+    return result;
+  }
+
+private:
+  static std::int64_t to_postgres(const Type& value)
+  {
+    const auto result = value.to_duration().count();
+    if (!(0 <= result && result <= microseconds_per_day))
+      throw_temporal_out_of_range(name);
+    return result;
+  }
+};
+
+/// The codec of PostgreSQL `interval`.
+struct Interval_codec final {
+  using Type = Interval;
+  static constexpr const char* name{"interval"};
+  static constexpr Oid binary_type_oid{1186};
+
+  static Type from_binary(const char* const bytes, const std::size_t size)
+  {
+    if (size != 16)
+      throw Client_exception{"cannot convert to interval: invalid input size"};
+    Type result;
+    result.time = std::chrono::microseconds{net::conv<std::int64_t>(bytes, 8)};
+    result.days = net::conv<std::int32_t>(bytes + 8, 4);
+    result.months = net::conv<std::int32_t>(bytes + 12, 4);
+    return result;
+  }
+
+  static std::string to_binary(const Type& value)
+  {
+    std::string result;
+    append_temporal_int(result, static_cast<std::int64_t>(value.time.count()));
+    append_temporal_int(result, value.days);
+    append_temporal_int(result, value.months);
+    return result;
+  }
+
+  /**
+   * @returns The interval parsed from the representation of the `postgres`
+   * interval style (which is the default), e.g.
+   * `1 year -2 mons +3 days -04:05:06.789`.
+   */
+  static Type from_text(const char* const text, const std::size_t size)
+  {
+    Temporal_text input{text, size, name};
+    std::int64_t months{}, days{}, time{};
+    bool is_empty{true};
+    for (input.skip_spaces(); !input.is_end(); input.skip_spaces()) {
+      const int sign{input.skip('-') ? -1 : (input.skip('+'), 1)};
+      const auto number = input.number();
+      if (input.skip(':'))
+        time += sign * input.time(number);
+      else {
+        input.skip_spaces();
+        if (input.skip(std::string_view{"year"}))
+          months += sign * number * 12;
+        else if (input.skip(std::string_view{"mon"}))
+          months += sign * number;
+        else if (input.skip(std::string_view{"day"}))
+          days += sign * number;
+        else
+          input.fail();
+        input.skip('s');
+      }
+      if (!(-max_component <= months && months <= max_component &&
+          -max_component <= days && days <= max_component))
+        throw_temporal_out_of_range(name);
+      is_empty = false;
+    }
+    if (is_empty)
+      input.fail();
+    return Type{static_cast<std::int32_t>(months),
+      static_cast<std::int32_t>(days), std::chrono::microseconds{time}};
+  }
+
+  /// @returns The representation of the `postgres` interval style.
+  static std::string to_text(const Type& value)
+  {
+    std::string result;
+    result.append(std::to_string(value.months)).append(" mons ")
+      .append(std::to_string(value.days)).append(" days ");
+    const auto time = value.time.count();
+    if (time < 0) {
+      if (time == std::numeric_limits<std::int64_t>::min())
+        throw_temporal_out_of_range(name);
+      result += '-';
+    }
+    append_temporal_time(result, time < 0 ? -time : time);
+    return result;
+  }
+
+private:
+  static constexpr std::int64_t max_component{
+    std::numeric_limits<std::int32_t>::max()};
+};
+
+/// Temporal to/from `std::string` conversions.
+template<class Codec>
+struct Temporal_string_conversions final {
+  using Type = typename Codec::Type;
+
+  template<typename ... Types>
+  static Type to_type(const std::string& text, Types&& ...)
+  {
+    return Codec::from_text(text.data(), text.size());
+  }
+
+  template<typename ... Types>
+  static std::string to_string(const Type& value, Types&& ...)
+  {
+    return Codec::to_text(value);
+  }
+};
+
+/// Temporal to/from Data conversions.
+template<class Codec>
+struct Temporal_data_conversions final {
+  using Type = typename Codec::Type;
+
+  template<typename ... Types>
+  static Type to_type(const Data& data, Types&& ...)
+  {
+    const auto* const bytes = static_cast<const char*>(data.bytes());
+    if (data.format() == Data_format::binary)
+      return Codec::from_binary(bytes, data.size());
+    else
+      return Codec::from_text(bytes, data.size());
+  }
+
+  template<typename ... Types>
+  static Type to_type(std::unique_ptr<Data>&& data, Types&& ...)
+  {
+    if (!data)
+      throw Client_exception{std::string{"cannot convert to "}
+        .append(Codec::name).append(": null data given")};
+    return to_type(*data);
+  }
+
+  template<typename ... Types>
+  static std::unique_ptr<Data> to_data(const Type& value, Types&& ...)
+  {
+    return Data::make(Codec::to_text(value), Data_format::text);
+  }
+
+  template<typename ... Types>
+  static std::unique_ptr<Data> to_data(const Type& value,
+    const Data_format format, Types&& ...)
+  {
+    if (format == Data_format::text)
+      return to_data(value);
+
+    return Data::make(Codec::to_binary(value), Data_format::binary);
+  }
+};
+
+/// The base of temporal conversions.
+template<class Codec>
+struct Temporal_conversions : Basic_conversions<typename Codec::Type,
+  Temporal_string_conversions<Codec>, Temporal_data_conversions<Codec>> {
+  /// The OID of the PostgreSQL type of the binary format.
+  static constexpr Oid binary_type_oid{Codec::binary_type_oid};
+
+  /// `true` since the output data can be in Data_format::binary.
+  static constexpr bool is_binary_data_convertible{true};
+};
+
+} // namespace detail
+
+/**
+ * @ingroup conversions
+ *
+ * @brief The partial specialization of Conversions for the time points of
+ * `std::chrono::system_clock` (PostgreSQL `timestamptz`).
+ *
+ * @details The support of the following data formats is implemented for:
+ *   - input data  - Data_format::text (ISO 8601 as of `DateStyle` of `ISO`),
+ *   Data_format::binary;
+ *   - output data - Data_format::text, Data_format::binary.
+ *
+ * The values are transferred with precision of microseconds. Infinite values
+ * are represented by `max()` and `min()` of time point.
+ */
+template<class Duration>
+struct Conversions<std::chrono::time_point<std::chrono::system_clock, Duration>>
+  final : detail::Temporal_conversions<
+    detail::Timestamp_codec<std::chrono::system_clock, Duration>> {};
+
+/**
+ * @ingroup conversions
+ *
+ * @brief The partial specialization of Conversions for Local_time (PostgreSQL
+ * `timestamp`).
+ *
+ * @details As for `std::chrono::time_point<std::chrono::system_clock, Duration>`.
+ */
+template<class Duration>
+struct Conversions<Local_time<Duration>> final : detail::Temporal_conversions<
+  detail::Timestamp_codec<Local_t, Duration>> {};
+
+/**
+ * @ingroup conversions
+ *
+ * @brief The full specialization of Conversions for Date (PostgreSQL `date`).
+ *
+ * @details The support of the following data formats is implemented for:
+ *   - input data  - Data_format::text (as of `DateStyle` of `ISO`),
+ *   Data_format::binary;
+ *   - output data - Data_format::text, Data_format::binary.
+ *
+ * Infinite dates cannot be converted.
+ */
+template<>
+struct Conversions<Date> final
+  : detail::Temporal_conversions<detail::Date_codec> {};
+
+/**
+ * @ingroup conversions
+ *
+ * @brief The full specialization of Conversions for Time_of_day (PostgreSQL
+ * `time`).
+ *
+ * @details The support of the following data formats is implemented for:
+ *   - input data  - Data_format::text, Data_format::binary;
+ *   - output data - Data_format::text, Data_format::binary.
+ */
+template<>
+struct Conversions<Time_of_day> final
+  : detail::Temporal_conversions<detail::Time_of_day_codec> {};
+
+/**
+ * @ingroup conversions
+ *
+ * @brief The full specialization of Conversions for Interval (PostgreSQL
+ * `interval`).
+ *
+ * @details The support of the following data formats is implemented for:
+ *   - input data  - Data_format::text (as of `IntervalStyle` of `postgres`),
+ *   Data_format::binary;
+ *   - output data - Data_format::text, Data_format::binary.
+ */
+template<>
+struct Conversions<Interval> final
+  : detail::Temporal_conversions<detail::Interval_codec> {};
+
+} // namespace dmitigr::pgfe
+
+#endif  // DMITIGR_PGFE_TEMPORAL_HPP
@@ -33,7 +33,8 @@ DMITIGR_PGFE_INLINE Tuple::Tuple(const Tuple& rhs)
   transform(rhs.elements_.cbegin(), rhs.elements_.cend(), elements_.begin(),
     [](const auto& pair)
     {
-      return std::make_pair(pair.first, pair.second->to_data());
+      return std::make_pair(pair.first,
+        pair.second ? pair.second->to_data() : nullptr);
     });
   assert(is_invariant_ok());
 }
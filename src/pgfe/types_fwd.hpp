@@ -41,10 +41,12 @@ enum class Password_encryption;
 enum class Pipeline_status;
 enum class Problem_severity;
 enum class Response_status;
+enum class Result_retrieval;
 enum class Row_processing;
 enum class Socket_readiness;
 enum class Server_status;
 enum class Session_mode;
+enum class Session_state;
 enum class Ssl_certificate_authority_policy;
 enum class Ssl_mode;
 enum class Ssl_protocol_version;
@@ -60,17 +62,26 @@ enum class Large_object_seek_whence;
 // Classes
 // -----------------------------------------------------------------------------
 
+class Async_connection;
+class Async_scheduler;
+class Bulk_completion;
+class Bytea_view;
 class Completion;
 class Composite;
 class Compositional;
 class Connection;
+class Connection_reactor;
 class Connection_options;
 class Connection_pool;
 class Copier;
 class Data;
 class Data_view;
+class Decimal;
+class Default_async_scheduler;
 class Error;
+class Inet;
 class Large_object;
+class Mac_address;
 class Message;
 class Notice;
 class Notification;
@@ -79,14 +90,21 @@ class Prepared_statement;
 class Named_argument;
 class Problem;
 class Ready_for_query;
+class Request_handle;
 class Response;
+class Result_set;
 class Row;
+class Row_batch;
 class Row_info;
+class Row_view;
+class Sharded_connection_pool;
 class Signal;
 class Statement;
 class Statement_vector;
+class Time_of_day;
 class Transaction_guard;
 class Tuple;
+class Uuid;
 
 class Exception;
 class Client_exception;
@@ -94,6 +112,11 @@ class Client_error_category;
 class Server_exception;
 class Server_error_category;
 
+struct Date;
+struct Interval;
+struct Local_t;
+
+template<typename> class Flat_array;
 template<typename> struct Conversions;
 
 /// The implementation details.
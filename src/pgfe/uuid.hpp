@@ -0,0 +1,260 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DMITIGR_PGFE_UUID_HPP
+#define DMITIGR_PGFE_UUID_HPP
+
+#include "basic_conversions.hpp"
+#include "basics.hpp"
+#include "conversions_api.hpp"
+#include "data.hpp"
+#include "exceptions.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace dmitigr::pgfe {
+
+/**
+ * @ingroup conversions
+ *
+ * @brief The universally unique identifier (PostgreSQL `uuid`).
+ */
+class Uuid final {
+public:
+  /// The type of the binary representation.
+  using Bytes = std::array<std::uint8_t, 16>;
+
+  /// Constructs the nil UUID.
+  constexpr Uuid() noexcept = default;
+
+  /// Constructs the UUID from its binary representation.
+  constexpr explicit Uuid(const Bytes& bytes) noexcept
+    : bytes_{bytes}
+  {}
+
+  /// @returns The binary representation.
+  constexpr const Bytes& bytes() const noexcept
+  {
+    return bytes_;
+  }
+
+  /// @returns `true` if this instance is the nil UUID.
+  bool is_nil() const noexcept
+  {
+    return *this == Uuid{};
+  }
+
+  /// @returns The value which is less than, equal to or greater than zero.
+  friend int compare(const Uuid& lhs, const Uuid& rhs) noexcept
+  {
+    return std::memcmp(lhs.bytes_.data(), rhs.bytes_.data(), lhs.bytes_.size());
+  }
+
+  /// @returns `true` if `lhs` is equals to `rhs`.
+  friend bool operator==(const Uuid& lhs, const Uuid& rhs) noexcept
+  {
+    return !compare(lhs, rhs);
+  }
+
+  /// @returns `true` if `lhs` is not equals to `rhs`.
+  friend bool operator!=(const Uuid& lhs, const Uuid& rhs) noexcept
+  {
+    return !(lhs == rhs);
+  }
+
+  /// @returns `true` if `lhs` is less than `rhs` in the PostgreSQL's order.
+  friend bool operator<(const Uuid& lhs, const Uuid& rhs) noexcept
+  {
+    return compare(lhs, rhs) < 0;
+  }
+
+private:
+  Bytes bytes_{};
+};
+
+namespace detail {
+
+/// The implementation of Uuid to/from `std::string` conversions.
+struct Uuid_string_conversions final {
+  using Type = Uuid;
+
+  template<typename ... Types>
+  static Type to_type(const std::string& text, Types&& ...)
+  {
+    return to_type__(text.data(), text.size());
+  }
+
+  /// @returns The representation like `a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11`.
+  template<typename ... Types>
+  static std::string to_string(const Type& value, Types&& ...)
+  {
+    constexpr const char* digits{"0123456789abcdef"};
+    std::string result(36, '-');
+    auto* out = result.data();
+    for (std::size_t i{}; i < value.bytes().size(); ++i) {
+      if (i == 4 || i == 6 || i == 8 || i == 10)
+        ++out;
+      *out++ = digits[value.bytes()[i] >> 4];
+      *out++ = digits[value.bytes()[i] & 0xf];
+    }
+    return result;
+  }
+
+private:
+  friend struct Uuid_data_conversions;
+
+  /**
+   * @returns The UUID parsed from the 32 hex digits optionally enclosed in
+   * braces, with optional hyphens after any group of four digits (as does
+   * PostgreSQL).
+   */
+  static Type to_type__(const char* text, std::size_t size)
+  {
+    const auto throw_invalid = []
+    {
+      throw Client_exception{"cannot convert to uuid: "
+        "invalid text representation"};
+    };
+    const auto digit_value = [](const char c) noexcept
+    {
+      if ('0' <= c && c <= '9')
+        return c - '0';
+      else if ('a' <= (c | 0x20) && (c | 0x20) <= 'f')
+        return (c | 0x20) - 'a' + 10;
+      else
+        return -1;
+    };
+
+    if (size >= 2 && text[0] == '{' && text[size - 1] == '}') {
+      ++text;
+      size -= 2;
+    }
+
+    Uuid::Bytes result;
+    const char* pos{text};
+    const char* const end{text + size};
+    for (std::size_t i{}; i < result.size(); ++i) {
+      if (end - pos < 2)
+        throw_invalid();
+      const int high{digit_value(pos[0])};
+      const int low{digit_value(pos[1])};
+      if (high < 0 || low < 0)
+        throw_invalid();
+      result[i] = static_cast<std::uint8_t>(high << 4 | low);
+      pos += 2;
+      if (i % 2 && i + 1 < result.size() && pos != end && *pos == '-')
+        ++pos;
+    }
+    if (pos != end)
+      throw_invalid();
+    return Uuid{result};
+  }
+};
+
+/// The implementation of Uuid to/from Data conversions.
+struct Uuid_data_conversions final {
+  using Type = Uuid;
+
+  template<typename ... Types>
+  static Type to_type(const Data& data, Types&& ...)
+  {
+    const auto* const bytes = static_cast<const char*>(data.bytes());
+    if (data.format() == Data_format::text)
+      return Uuid_string_conversions::to_type__(bytes, data.size());
+
+    Uuid::Bytes result;
+    if (data.size() != result.size())
+      throw Client_exception{"cannot convert to uuid: invalid input size"};
+    std::memcpy(result.data(), bytes, result.size());
+    return Uuid{result};
+  }
+
+  template<typename ... Types>
+  static Type to_type(std::unique_ptr<Data>&& data, Types&& ...)
+  {
+    if (!data)
+      throw Client_exception{"cannot convert to uuid: null data given"};
+    return to_type(*data);
+  }
+
+  template<typename ... Types>
+  static std::unique_ptr<Data> to_data(const Type& value, Types&& ...)
+  {
+    return Data::make(Uuid_string_conversions::to_string(value),
+      Data_format::text);
+  }
+
+  template<typename ... Types>
+  static std::unique_ptr<Data> to_data(const Type& value,
+    const Data_format format, Types&& ...)
+  {
+    if (format == Data_format::text)
+      return to_data(value);
+
+    return Data::make(std::string_view{
+      reinterpret_cast<const char*>(value.bytes().data()), value.bytes().size()},
+      Data_format::binary);
+  }
+};
+
+} // namespace detail
+
+/**
+ * @ingroup conversions
+ *
+ * @brief Full specialization of Conversions for Uuid.
+ *
+ * @details Support of the following data formats is implemented for:
+ *   - input data  - Data_format::text, Data_format::binary;
+ *   - output data - Data_format::text, Data_format::binary.
+ */
+template<>
+struct Conversions<Uuid> final : Basic_conversions<Uuid,
+  detail::Uuid_string_conversions, detail::Uuid_data_conversions> {
+  /// The OID of `uuid`.
+  static constexpr Oid binary_type_oid{2950};
+
+  /// `true` since the output data can be in Data_format::binary.
+  static constexpr bool is_binary_data_convertible{true};
+};
+
+} // namespace dmitigr::pgfe
+
+namespace std {
+
+/// The specialization of `std::hash` for Uuid.
+template<>
+struct hash<dmitigr::pgfe::Uuid> final {
+  std::size_t operator()(const dmitigr::pgfe::Uuid& value) const noexcept
+  {
+    // Both halves are mixed since time-based UUIDs differ mostly at the end.
+    std::uint64_t high, low;
+    std::memcpy(&high, value.bytes().data(), sizeof(high));
+    std::memcpy(&low, value.bytes().data() + sizeof(high), sizeof(low));
+    return static_cast<std::size_t>(high ^ (low * 0x9e3779b97f4a7c15));
+  }
+};
+
+} // namespace std
+
+#endif  // DMITIGR_PGFE_UUID_HPP
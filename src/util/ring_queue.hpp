@@ -0,0 +1,218 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DMITIGR_UTIL_RING_QUEUE_HPP
+#define DMITIGR_UTIL_RING_QUEUE_HPP
+
+#include "../base/assert.hpp"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace dmitigr::util {
+
+/**
+ * @brief A FIFO queue based on the ring buffer.
+ *
+ * @details Unlike `std::queue<T, std::deque<T>>`, this queue doesn't allocate
+ * memory on push and pop until the number of elements exceeds the capacity,
+ * in which case the capacity is doubled.
+ *
+ * @remarks The popped elements are replaced with `T{}` in order to release
+ * the resources they hold.
+ */
+template<typename T>
+class Ring_queue final {
+public:
+  /// An alias of `T`.
+  using value_type = T;
+
+  /// An alias of size type.
+  using size_type = std::size_t;
+
+  /**
+   * @brief The constructor.
+   *
+   * @par Requires
+   * `capacity > 0`.
+   */
+  explicit Ring_queue(const size_type capacity = 16)
+    : elements_(capacity)
+  {
+    DMITIGR_ASSERT(capacity > 0);
+  }
+
+  /// @returns `true` if this queue is empty.
+  bool empty() const noexcept
+  {
+    return !size_;
+  }
+
+  /// @returns The number of elements in this queue.
+  size_type size() const noexcept
+  {
+    return size_;
+  }
+
+  /// @returns The number of elements this queue can hold without allocation.
+  size_type capacity() const noexcept
+  {
+    return elements_.size();
+  }
+
+  /**
+   * @returns The first (oldest) element.
+   *
+   * @par Requires
+   * `!empty()`.
+   */
+  T& front() noexcept
+  {
+    DMITIGR_ASSERT(!empty());
+    return elements_[head_];
+  }
+
+  /// @overload
+  const T& front() const noexcept
+  {
+    DMITIGR_ASSERT(!empty());
+    return elements_[head_];
+  }
+
+  /**
+   * @returns The last (newest) element.
+   *
+   * @par Requires
+   * `!empty()`.
+   */
+  T& back() noexcept
+  {
+    DMITIGR_ASSERT(!empty());
+    return elements_[index(size_ - 1)];
+  }
+
+  /// @overload
+  const T& back() const noexcept
+  {
+    DMITIGR_ASSERT(!empty());
+    return elements_[index(size_ - 1)];
+  }
+
+  /**
+   * @brief Appends the element constructed from `args` to the end.
+   *
+   * @returns The reference to the appended element.
+   *
+   * @par Exception safety guarantee
+   * Strong if `T` is nothrow move-assignable, basic otherwise. (The element
+   * is constructed and then move-assigned to the slot of the ring buffer.)
+   */
+  template<typename ... Types>
+  T& emplace(Types&& ... args)
+  {
+    if (size_ == capacity())
+      reserve(2 * capacity()); // can throw
+    auto& result = elements_[index(size_)];
+    result = T{std::forward<Types>(args)...}; // can throw
+    ++size_;
+    return result;
+  }
+
+  /**
+   * @brief Removes the first (oldest) element.
+   *
+   * @par Requires
+   * `!empty()`.
+   */
+  void pop() noexcept
+  {
+    DMITIGR_ASSERT(!empty());
+    elements_[head_] = T{};
+    head_ = index(1);
+    --size_;
+  }
+
+  /**
+   * @brief Removes the last (newest) element.
+   *
+   * @par Requires
+   * `!empty()`.
+   */
+  void pop_back() noexcept
+  {
+    DMITIGR_ASSERT(!empty());
+    elements_[index(size_ - 1)] = T{};
+    --size_;
+  }
+
+  /// Removes all the elements without changing the capacity.
+  void clear() noexcept
+  {
+    while (!empty())
+      pop();
+    head_ = 0;
+  }
+
+  /**
+   * @brief Increases the capacity to `capacity` if it's greater than the
+   * current capacity.
+   *
+   * @par Exception safety guarantee
+   * Strong if `T` is nothrow move-assignable.
+   */
+  void reserve(const size_type capacity)
+  {
+    if (capacity <= this->capacity())
+      return;
+
+    std::vector<T> elements(capacity); // can throw
+    for (size_type i{}; i < size_; ++i)
+      elements[i] = std::move(elements_[index(i)]);
+    elements_.swap(elements);
+    head_ = 0;
+  }
+
+  /// Swaps this instance with `rhs`.
+  void swap(Ring_queue& rhs) noexcept
+  {
+    using std::swap;
+    swap(elements_, rhs.elements_);
+    swap(head_, rhs.head_);
+    swap(size_, rhs.size_);
+  }
+
+private:
+  std::vector<T> elements_;
+  size_type head_{};
+  size_type size_{};
+
+  size_type index(const size_type offset) const noexcept
+  {
+    return (head_ + offset) % elements_.size();
+  }
+};
+
+/// Ring_queue is swappable.
+template<typename T>
+inline void swap(Ring_queue<T>& lhs, Ring_queue<T>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace dmitigr::util
+
+#endif  // DMITIGR_UTIL_RING_QUEUE_HPP
@@ -21,5 +21,6 @@
 #include "contract.hpp"
 #include "diagnostic.hpp"
 #include "memory.hpp"
+#include "ring_queue.hpp"
 
 #endif  // DMITIGR_UTIL_UTIL_HPP
@@ -82,18 +82,36 @@ void test_pq()
   PQfinish(conn);
 }
 
-void test_pgfe()
+auto pgfe_connection()
 {
   namespace pgfe = dmitigr::pgfe;
-  pgfe::Connection conn{pgfe::Connection_options{}
+  auto conn = std::make_unique<pgfe::Connection>(pgfe::Connection_options{}
     .set(pgfe::Communication_mode::net)
     .set_address("127.0.0.1")
     .set_username("pgfe_test")
     .set_password("pgfe_test")
     .set_database("pgfe_test")
-    .set_connect_timeout(std::chrono::seconds{7})};
-  conn.connect();
-  conn.execute([](auto&& r) { auto d = r.data(); }, query);
+    .set_connect_timeout(std::chrono::seconds{7}));
+  conn->connect();
+  return conn;
+}
+
+void test_pgfe()
+{
+  auto conn = pgfe_connection();
+  conn->execute([](auto&& r) { auto d = r.data(); }, query);
+}
+
+void test_pgfe_row_batch()
+{
+  namespace pgfe = dmitigr::pgfe;
+  auto conn = pgfe_connection();
+  conn->set_row_batch_size(1000);
+  conn->execute([](pgfe::Row_batch&& b)
+  {
+    for (std::size_t i{}; i < b.row_count(); ++i)
+      auto d = b.data(i);
+  }, query);
 }
 
 int main()
@@ -105,4 +123,7 @@ int main()
   std::cout << "Pgfe: ";
   const auto elapsed_pgfe = with_measure(test_pgfe);
   std::cout << elapsed_pgfe.count() << std::endl;
+  std::cout << "Pgfe (batches of rows): ";
+  const auto elapsed_pgfe_row_batch = with_measure(test_pgfe_row_batch);
+  std::cout << elapsed_pgfe_row_batch.count() << std::endl;
 }
@@ -0,0 +1,168 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pgfe-unit.hpp"
+
+#include <vector>
+
+#define ASSERT DMITIGR_ASSERT
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+namespace pgfe = dmitigr::pgfe;
+using pgfe::to;
+
+pgfe::Task<int> query(pgfe::Async_connection& conn)
+{
+  co_await conn.async_connect();
+  ASSERT(conn.connection().is_connected());
+
+  // Execute.
+  int sum{};
+  auto comp = co_await conn.async_execute([&sum](pgfe::Row&& row)
+  {
+    sum += to<int>(row[0]);
+  }, "select generate_series(1, $1::int)", 3);
+  ASSERT(comp.tag() == "SELECT 3");
+  ASSERT(sum == 6);
+
+  // Rows.
+  auto rows = conn.async_rows("select generate_series(1, 3)");
+  while (auto row = co_await rows.next())
+    sum += to<int>((*row)[0]);
+  ASSERT(sum == 12);
+  ASSERT(conn.connection().completion().tag() == "SELECT 3");
+
+  // Whole result and chunks of many rows.
+  for (const auto retrieval : {pgfe::Result_retrieval::whole,
+      pgfe::Result_retrieval::streaming}) {
+    conn.connection().set_result_retrieval(retrieval);
+    conn.connection().set_row_batch_size(100);
+    int count{};
+    comp = co_await conn.async_execute([&count](pgfe::Row&& row)
+    {
+      ASSERT(to<int>(row[0]) == ++count);
+    }, "select generate_series(1, 1000)");
+    ASSERT(comp.tag() == "SELECT 1000");
+    ASSERT(count == 1000);
+
+    count = 0;
+    auto all = conn.async_rows("select generate_series(1, 1000)");
+    while (auto row = co_await all.next())
+      ASSERT(to<int>((*row)[0]) == ++count);
+    ASSERT(count == 1000);
+    ASSERT(conn.connection().completion().tag() == "SELECT 1000");
+  }
+  conn.connection().set_result_retrieval(pgfe::Result_retrieval::streaming);
+  conn.connection().set_row_batch_size(1);
+
+  // Prepare.
+  auto ps = co_await conn.async_prepare("select $1::int", "ps");
+  ASSERT(ps && ps.name() == "ps");
+
+  // Errors.
+  try {
+    co_await conn.async_execute("select 1/0");
+    ASSERT(false);
+  } catch (const pgfe::Server_exception& e) {
+    ASSERT(e.error().condition() == pgfe::Server_errc::c22_division_by_zero);
+  }
+
+  // Copy.
+  co_await conn.async_execute("create temp table num(n integer)");
+  conn.connection().execute_nio("copy num from stdin");
+  co_await conn.async_wait_response_throw();
+  {
+    auto copier = conn.connection().copier();
+    ASSERT(copier);
+    co_await conn.async_send(copier, "1\n2\n");
+    co_await conn.async_end(copier);
+  }
+  co_await conn.async_wait_response_throw();
+  ASSERT(conn.connection().completion().tag() == "COPY 2");
+
+  conn.connection().execute_nio("copy num to stdout");
+  co_await conn.async_wait_response_throw();
+  {
+    auto copier = conn.connection().copier();
+    ASSERT(copier);
+    while (auto data = co_await conn.async_receive(copier))
+      sum += std::stoi(std::string{static_cast<const char*>(data.bytes()), data.size()});
+  }
+  co_await conn.async_wait_response_throw();
+  ASSERT(conn.connection().completion().tag() == "COPY 2");
+
+  co_return sum;
+}
+#endif
+
+int main()
+try {
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+  using std::chrono::milliseconds;
+
+  pgfe::Default_async_scheduler scheduler;
+  ASSERT(!scheduler.waiter_count());
+  ASSERT(!scheduler.run_once(milliseconds{}));
+
+  // Many queries driven from the single thread.
+  {
+    constexpr std::size_t conn_count{8};
+    std::vector<std::unique_ptr<pgfe::Connection>> conns;
+    std::vector<pgfe::Async_connection> aconns;
+    std::vector<pgfe::Task<int>> tasks;
+    conns.reserve(conn_count);
+    aconns.reserve(conn_count);
+    tasks.reserve(conn_count);
+    for (std::size_t i{}; i < conn_count; ++i) {
+      conns.push_back(pgfe::test::make_connection());
+      aconns.emplace_back(*conns.back(), scheduler);
+      tasks.push_back(query(aconns.back()));
+      tasks.back().start();
+    }
+    ASSERT(scheduler.waiter_count() == conn_count);
+    scheduler.run();
+    for (auto& task : tasks) {
+      ASSERT(task.is_done());
+      ASSERT(task.result() == 15);
+    }
+  }
+
+  // Timeouts.
+  {
+    auto conn = pgfe::test::make_connection();
+    conn->connect();
+    pgfe::Async_connection aconn{*conn, scheduler};
+    ASSERT(conn->is_nio_output_enabled());
+    conn->execute_nio("select pg_sleep(5)");
+    auto task = aconn.async_wait_response(milliseconds{50});
+    task.start();
+    scheduler.run();
+    ASSERT(task.is_done());
+    try {
+      task.result();
+      ASSERT(false);
+    } catch (const pgfe::Client_exception& e) {
+      ASSERT(e.condition() == pgfe::Client_errc::timed_out);
+    }
+  }
+#endif
+} catch (const std::exception& e) {
+  std::cerr << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "unknown error" << std::endl;
+  return 2;
+}
@@ -19,7 +19,9 @@
 
 #include "pgfe-unit.hpp"
 
+#include <chrono>
 #include <fstream>
+#include <iostream>
 #include <tuple>
 #include <string>
 #include <utility>
@@ -54,6 +56,22 @@ inline std::tuple<std::ofstream, std::unique_ptr<dmitigr::pgfe::Connection>> pre
   return std::make_tuple(std::move(output_file), std::move(conn));
 }
 
+/// Calls `f(format)` for each data format and prints the time elapsed.
+template<typename F>
+void for_each_format(F&& f)
+{
+  namespace chrono = std::chrono;
+  using pgfe::Data_format;
+  for (const auto format : {Data_format::text, Data_format::binary}) {
+    const auto started = chrono::steady_clock::now();
+    f(format);
+    const auto elapsed = chrono::duration_cast<chrono::milliseconds>(
+      chrono::steady_clock::now() - started).count();
+    std::cout << (format == Data_format::text ? "text" : "binary")
+              << ": " << elapsed << " ms" << std::endl;
+  }
+}
+
 } // namespace dmitigr::pgfe::test::arraybench
 
 #endif // DMITIGR_LIBS_TESTS_PGFE_UNIT_BENCHMARK_ARRAY_HPP
@@ -21,15 +21,20 @@ try {
   namespace pgfe = dmitigr::pgfe;
 
   auto [output_file, conn] = pgfe::test::arraybench::prepare(argc, argv);
-  conn->execute([output_file = std::move(output_file)](auto&& row)mutable
+  pgfe::test::arraybench::for_each_format([&output_file = output_file,
+    &conn = conn](const pgfe::Data_format format)
   {
-    using Array = pgfe::Array_optional1<std::string>;
-    for (const auto& elem : pgfe::to<Array>(row[0])) {
-      if (elem)
-        output_file << *elem;
-    }
-    output_file << "\n";
-  }, "select dat from benchmark_test_array");
+    conn->set_result_format(format);
+    conn->execute([&output_file](auto&& row)
+    {
+      using Array = pgfe::Array_optional1<std::string>;
+      for (const auto& elem : pgfe::to<Array>(row[0])) {
+        if (elem)
+          output_file << *elem;
+      }
+      output_file << "\n";
+    }, "select dat from benchmark_test_array");
+  });
 } catch (const std::exception& e) {
   std::cerr << e.what() << std::endl;
   return 1;
@@ -0,0 +1,84 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pgfe-unit.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+int main(const int argc, char* const argv[])
+try {
+  namespace pgfe = dmitigr::pgfe;
+  namespace chrono = std::chrono;
+  using Clock = chrono::steady_clock;
+
+  const std::size_t thread_count{(argc >= 2) ? std::stoul(argv[1]) : 64};
+  const std::size_t iteration_count{(argc >= 3) ? std::stoul(argv[2]) : 10000};
+  const std::size_t shard_count{std::max(1u, std::thread::hardware_concurrency())};
+  const std::size_t shard_size{(thread_count + shard_count - 1) / shard_count};
+
+  // Acquires and releases the connection by each of thread_count threads.
+  const auto run = [thread_count, iteration_count](const char* const name,
+    auto& pool)
+  {
+    pool.set_release_handler({}); // measure the pool itself, not the server
+    pool.connect();
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count);
+    const auto started = Clock::now();
+    for (std::size_t i{}; i < thread_count; ++i) {
+      threads.emplace_back([&pool, iteration_count]
+      {
+        for (std::size_t j{}; j < iteration_count; ++j) {
+          auto conn = pool.connection(std::nullopt);
+          DMITIGR_ASSERT(conn);
+        }
+      });
+    }
+    for (auto& thread : threads)
+      thread.join();
+    const auto elapsed = chrono::duration_cast<chrono::nanoseconds>(
+      Clock::now() - started).count();
+    const auto op_count = thread_count * iteration_count;
+    std::cout << name << ": " << thread_count << " threads, "
+              << op_count << " acquire/release pairs: "
+              << elapsed / 1000000 << " ms ("
+              << elapsed / static_cast<long long>(op_count) << " ns/pair)"
+              << std::endl;
+  };
+
+  {
+    pgfe::Connection_pool pool{thread_count, pgfe::test::connection_options()};
+    run("single-lock pool", pool);
+  }
+
+  {
+    pgfe::Sharded_connection_pool pool{shard_count, shard_size,
+      pgfe::test::connection_options()};
+    run("sharded pool", pool);
+    std::cout << "sharded pool: " << shard_count << " shards, "
+              << pool.steal_count() << " steals" << std::endl;
+  }
+} catch (const std::exception& e) {
+  std::cerr << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "unknown error" << std::endl;
+  return 2;
+}
@@ -0,0 +1,63 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pgfe-unit.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+int main(const int argc, char* const argv[])
+try {
+  namespace pgfe = dmitigr::pgfe;
+  namespace chrono = std::chrono;
+  using Clock = chrono::steady_clock;
+
+  const std::size_t pool_size{(argc >= 2) ? std::stoul(argv[1]) : 64};
+  const auto to_ms = [](const Clock::duration d)
+  {
+    return chrono::duration_cast<chrono::milliseconds>(d).count();
+  };
+
+  // Serial establishment (as Connection_pool::connect() did before).
+  {
+    std::vector<std::unique_ptr<pgfe::Connection>> conns;
+    for (std::size_t i{}; i < pool_size; ++i)
+      conns.push_back(pgfe::test::make_connection());
+    const auto started = Clock::now();
+    for (auto& conn : conns)
+      conn->connect();
+    std::cout << "serial warm-up of " << pool_size << " connections: "
+              << to_ms(Clock::now() - started) << " ms" << std::endl;
+  }
+
+  // Concurrent establishment by the pool.
+  {
+    pgfe::Connection_pool pool{pool_size, pgfe::test::connection_options()};
+    const auto started = Clock::now();
+    pool.connect();
+    std::cout << "pool warm-up of " << pool_size << " connections: "
+              << to_ms(Clock::now() - started) << " ms" << std::endl;
+    DMITIGR_ASSERT(pool.is_connected());
+    DMITIGR_ASSERT(pool.free_count() == pool_size);
+  }
+} catch (const std::exception& e) {
+  std::cerr << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "unknown error" << std::endl;
+  return 2;
+}
@@ -0,0 +1,221 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../../src/pgfe/array_aliases.hpp"
+#include "../../src/pgfe/conversions.hpp"
+#include "../../src/pgfe/decimal.hpp"
+#include "../../src/pgfe/flat_array.hpp"
+#include "../../src/pgfe/pq.hpp"
+#include "../../src/pgfe/uuid.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+int main(const int argc, char* const argv[])
+try {
+  namespace pgfe = dmitigr::pgfe;
+  namespace chrono = std::chrono;
+  using Clock = chrono::steady_clock;
+
+  const unsigned long iteration_count{(argc >= 2) ? std::stoul(argv[1]) : 10000000};
+
+  // Converts the numerics of type T to Data and back.
+  const auto run = [iteration_count](const char* const name, auto make_value)
+  {
+    using T = decltype(make_value(0ul));
+    const auto started = Clock::now();
+    T sum{};
+    for (unsigned long i{}; i < iteration_count; ++i) {
+      const auto data = pgfe::to_data(make_value(i));
+      sum += pgfe::to<T>(*data);
+    }
+    const auto elapsed = chrono::duration_cast<chrono::milliseconds>(
+      Clock::now() - started).count();
+    std::cout << name << ": " << iteration_count << " round trips: "
+              << elapsed << " ms (sum " << sum << ")" << std::endl;
+  };
+
+  run("long long", [](const unsigned long i)
+  {
+    return static_cast<long long>(i) * 7919 - 1000000;
+  });
+  run("double", [](const unsigned long i)
+  {
+    return static_cast<double>(i) / 7.0 - 1000.5;
+  });
+
+  // Decodes the 1000x1000 matrix of floats in binary format.
+  {
+    constexpr int extent{1000};
+    std::vector<float> values(extent*extent);
+    for (std::size_t i{}; i < values.size(); ++i)
+      values[i] = static_cast<float>(i);
+    const auto data = pgfe::to_data(pgfe::Flat_array<float>{{extent, extent},
+      std::move(values)}, pgfe::Data_format::binary);
+
+    const auto decode = [&data](const char* const name, auto type)
+    {
+      using T = typename decltype(type)::type;
+      const auto started = Clock::now();
+      std::size_t size{};
+      for (int i{}; i < 10; ++i)
+        size += pgfe::to<T>(*data).size();
+      const auto elapsed = chrono::duration_cast<chrono::milliseconds>(
+        Clock::now() - started).count();
+      std::cout << name << ": 10 decodings of 1000x1000 matrix: "
+                << elapsed << " ms (size " << size << ")" << std::endl;
+    };
+    decode("Array_optional2<float>",
+      std::common_type<pgfe::Array_optional2<float>>{});
+    decode("Flat_array<float>", std::common_type<pgfe::Flat_array<float>>{});
+  }
+
+  // Parses the text representation of varchar[] like the array benchmarks do.
+  {
+    std::string literal{"{"};
+    for (int i{1}; i <= 100000; ++i) {
+      if (i > 1)
+        literal += ',';
+      literal.append("\"Column ").append(std::to_string(i % 5 + 1))
+        .append(", Row ").append(std::to_string(i)).append("\"");
+    }
+    literal += '}';
+    const auto data = pgfe::Data::make_no_copy(literal);
+    const auto started = Clock::now();
+    std::size_t size{};
+    for (int i{}; i < 10; ++i)
+      size += pgfe::to<pgfe::Array_optional1<std::string>>(*data).size();
+    const auto elapsed = chrono::duration_cast<chrono::milliseconds>(
+      Clock::now() - started).count();
+    std::cout << "varchar[]: 10 parsings of " << literal.size()
+              << " bytes literal: " << elapsed << " ms (size " << size << ")"
+              << std::endl;
+  }
+
+  // Converts the UUIDs to Data and back in both formats.
+  {
+    const auto make_uuid = [](const unsigned long i)
+    {
+      pgfe::Uuid::Bytes bytes{};
+      for (std::size_t j{}; j < bytes.size(); ++j)
+        bytes[j] = static_cast<std::uint8_t>((i + j) * 131);
+      return pgfe::Uuid{bytes};
+    };
+    for (const auto format : {pgfe::Data_format::text, pgfe::Data_format::binary}) {
+      const auto started = Clock::now();
+      std::size_t count{};
+      for (unsigned long i{}; i < iteration_count; ++i) {
+        const auto data = pgfe::to_data(make_uuid(i), format);
+        count += !pgfe::to<pgfe::Uuid>(*data).is_nil();
+      }
+      const auto elapsed = chrono::duration_cast<chrono::milliseconds>(
+        Clock::now() - started).count();
+      std::cout << "Uuid (" << (format == pgfe::Data_format::text ? "text" :
+        "binary") << "): " << iteration_count << " round trips: " << elapsed
+                << " ms (count " << count << ")" << std::endl;
+    }
+  }
+
+  // Decodes the 100KB bytea in hex format.
+  {
+    std::vector<std::byte> blob(100000);
+    for (std::size_t i{}; i < blob.size(); ++i)
+      blob[i] = static_cast<std::byte>(i * 7919);
+    const auto text = pgfe::to_data(blob);
+    const auto binary = pgfe::to_data(blob, pgfe::Data_format::binary);
+    std::vector<std::byte> buffer(blob.size());
+
+    const auto decode = [](const char* const name, const auto& decode_one)
+    {
+      const auto started = Clock::now();
+      std::size_t size{};
+      for (int i{}; i < 1000; ++i)
+        size += decode_one();
+      const auto elapsed = chrono::duration_cast<chrono::milliseconds>(
+        Clock::now() - started).count();
+      std::cout << name << ": 1000 decodings of 100KB bytea: "
+                << elapsed << " ms (size " << size << ")" << std::endl;
+    };
+    decode("PQunescapeBytea()", [&text]
+    {
+      std::size_t size{};
+      auto* const bytes = PQunescapeBytea(
+        static_cast<const unsigned char*>(text->bytes()), &size);
+      PQfreemem(bytes);
+      return size;
+    });
+    decode("Data::to_bytea()", [&text]
+    {
+      return text->to_bytea()->size();
+    });
+    decode("Data::decode_bytea()", [&text, &buffer]
+    {
+      return pgfe::Data::decode_bytea(pgfe::to<std::string_view>(*text),
+        buffer.data(), buffer.size());
+    });
+    decode("Bytea_view (binary)", [&binary]
+    {
+      return pgfe::to<pgfe::Bytea_view>(*binary).size();
+    });
+  }
+
+#ifdef __SIZEOF_INT128__
+  // Decodes the values of numeric(18,4) as long double and as Decimal.
+  {
+    std::vector<std::unique_ptr<pgfe::Data>> texts;
+    std::vector<std::unique_ptr<pgfe::Data>> binaries;
+    for (long long i{}; i < 100000; ++i) {
+      const pgfe::Decimal value{i * 7919131 - 123456789012345678, 4};
+      texts.push_back(pgfe::to_data(value));
+      binaries.push_back(pgfe::to_data(value, pgfe::Data_format::binary));
+    }
+
+    const auto decode = [](const char* const name, const auto& datas,
+      auto type)
+    {
+      using T = typename decltype(type)::type;
+      const auto started = Clock::now();
+      long double sum{};
+      for (int i{}; i < 10; ++i) {
+        for (const auto& data : datas) {
+          if constexpr (std::is_same_v<T, pgfe::Decimal>)
+            sum += pgfe::to<T>(*data).to_long_double();
+          else
+            sum += pgfe::to<T>(*data);
+        }
+      }
+      const auto elapsed = chrono::duration_cast<chrono::milliseconds>(
+        Clock::now() - started).count();
+      std::cout << name << ": 10 decodings of " << datas.size()
+                << " numeric(18,4): " << elapsed << " ms (sum " << sum << ")"
+                << std::endl;
+    };
+    decode("long double (text)", texts, std::common_type<long double>{});
+    decode("Decimal (text)", texts, std::common_type<pgfe::Decimal>{});
+    decode("Decimal (binary)", binaries, std::common_type<pgfe::Decimal>{});
+  }
+#endif
+} catch (const std::exception& e) {
+  std::cerr << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "unknown error" << std::endl;
+  return 2;
+}
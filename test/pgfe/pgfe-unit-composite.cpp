@@ -17,7 +17,13 @@
 #include "../../src/base/assert.hpp"
 #include "../../src/pgfe/conversions.hpp"
 #include "../../src/pgfe/data.hpp"
+#include "../../src/pgfe/array_aliases.hpp"
 #include "../../src/pgfe/tuple.hpp"
+#include "../../src/util/diagnostic.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
 
 int main()
 {
@@ -129,6 +135,125 @@ int main()
       ASSERTMENTS;
 #undef ASSERTMENTS
     }
+
+    // -------------------------------------------------------------------------
+    // Records
+    // -------------------------------------------------------------------------
+
+    using pgfe::Data;
+    using pgfe::Data_format;
+    using pgfe::Oid;
+    using pgfe::Tuple;
+    using pgfe::to;
+    using pgfe::to_data;
+    using dmitigr::util::with_catch;
+
+    // Text format
+    {
+      const auto record = to<Tuple>(Data::make(R"( (1,"a ""b""\\c",) )"));
+      DMITIGR_ASSERT(record.field_count() == 3);
+      DMITIGR_ASSERT(to<std::string_view>(record[0]) == "1");
+      DMITIGR_ASSERT(to<std::string_view>(record[1]) == R"(a "b"\c)");
+      DMITIGR_ASSERT(!record[2]);
+      const Tuple copy{record};
+      DMITIGR_ASSERT(!copy[2]);
+      DMITIGR_ASSERT(to<std::string>(*to_data(record)) ==
+        R"(("1","a ""b""\\c",))");
+      DMITIGR_ASSERT(to<Tuple>(Data::make("()")).field_count() == 1);
+      DMITIGR_ASSERT(to<std::string_view>(to<Tuple>(Data::make("(,\"\")"))[1])
+        .empty());
+      for (const auto* const literal : {"", "(", "(1", "(1,2)x", "(\"a)", "1,2"}) {
+        DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([&]
+        {
+          to<Tuple>(Data::make(literal));
+        }));
+      }
+    }
+
+    // Binary format
+    {
+      Tuple record;
+      record.append("id", to_data(42, Data_format::binary));
+      record.append("parent", nullptr);
+      record.append("name", Data::make(std::string_view{"ab"}, Data_format::binary));
+      const std::vector<Oid> field_types{23, 23, 25};
+      const auto data = to_data(record, Data_format::binary, field_types);
+      DMITIGR_ASSERT(data->size() == 4 + 12 + 8 + 10);
+
+      const auto decoded = to<Tuple>(*data);
+      DMITIGR_ASSERT(decoded.field_count() == 3);
+      DMITIGR_ASSERT(to<int>(decoded[0]) == 42);
+      DMITIGR_ASSERT(!decoded[1]);
+      DMITIGR_ASSERT(to<std::string_view>(decoded[2]) == "ab");
+      // The fields refer to the bytes of the data.
+      const auto* const bytes = static_cast<const char*>(data->bytes());
+      DMITIGR_ASSERT(decoded[2].bytes() == bytes + data->size() - 2);
+      // The fields of the tuple converted from the temporary data are copied.
+      const auto owned = to<Tuple>(to_data(record, Data_format::binary,
+          field_types));
+      DMITIGR_ASSERT(to<int>(owned[0]) == 42);
+      DMITIGR_ASSERT(to<std::string_view>(owned[2]) == "ab");
+
+      DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([&]
+      {
+        to_data(record, Data_format::binary);
+      }));
+      DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([&]
+      {
+        to_data(record, Data_format::binary, std::vector<Oid>{23});
+      }));
+      DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([&]
+      {
+        Tuple text_record;
+        text_record.append("id", 42);
+        to_data(text_record, Data_format::binary, std::vector<Oid>{23});
+      }));
+      DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([&]
+      {
+        const std::string_view truncated{bytes, data->size() - 1};
+        to<Tuple>(Data::make(truncated, Data_format::binary));
+      }));
+    }
+
+    // Arrays of records
+    {
+      using Records = pgfe::Array_optional1<Tuple>;
+      Tuple record;
+      record.append("", 1);
+      record.append("", "a,\"b\\");
+      record.append("", nullptr);
+      Records records;
+      records.emplace_back(record);
+      records.emplace_back(std::nullopt);
+      const auto decoded = to<Records>(*to_data(records));
+      DMITIGR_ASSERT(decoded.size() == 2 && decoded[0] && !decoded[1]);
+      DMITIGR_ASSERT(*decoded[0] == record);
+
+      // The array of records in binary format like `array_agg(row(...))`.
+      Tuple binary_record;
+      binary_record.append("", to_data(7, Data_format::binary));
+      const auto element = to_data(binary_record, Data_format::binary,
+        std::vector<Oid>{23});
+      std::string array;
+      const auto append = [&array](const std::int32_t value)
+      {
+        char buffer[sizeof(value)];
+        dmitigr::net::copy(buffer, sizeof(buffer), value);
+        array.append(buffer, sizeof(buffer));
+      };
+      for (const std::int32_t value : {1, 0, 2249, 2, 1})
+        append(value);
+      for (int i{}; i < 2; ++i) {
+        append(static_cast<std::int32_t>(element->size()));
+        array.append(static_cast<const char*>(element->bytes()), element->size());
+      }
+      const auto array_data = Data::make(array, Data_format::binary);
+      const auto binary_records = to<std::vector<Tuple>>(*array_data);
+      DMITIGR_ASSERT(binary_records.size() == 2);
+      DMITIGR_ASSERT(to<int>(binary_records[1][0]) == 7);
+      DMITIGR_ASSERT(binary_records[1][0].bytes() ==
+        static_cast<const char*>(array_data->bytes()) + array_data->size() - 4);
+    }
   } catch (const std::exception& e) {
     std::cerr << e.what() << std::endl;
     return 1;
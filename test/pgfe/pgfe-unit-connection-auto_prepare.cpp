@@ -0,0 +1,109 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pgfe-unit.hpp"
+
+int main()
+try {
+  namespace pgfe = dmitigr::pgfe;
+  using pgfe::to;
+
+  auto conn = pgfe::test::make_connection();
+  conn->connect();
+  DMITIGR_ASSERT(!conn->auto_prepare_threshold());
+  DMITIGR_ASSERT(conn->auto_prepare_capacity() == 64);
+
+  // Auto-prepare is disabled by default.
+  conn->execute("select 1");
+  DMITIGR_ASSERT(!conn->auto_prepare_hit_count());
+  DMITIGR_ASSERT(!conn->auto_prepare_miss_count());
+
+  conn->set_auto_prepare_threshold(2);
+  conn->set_auto_prepare_capacity(2);
+  DMITIGR_ASSERT(conn->auto_prepare_threshold() == 2);
+  DMITIGR_ASSERT(conn->auto_prepare_capacity() == 2);
+  try {
+    conn->set_auto_prepare_capacity(0);
+    DMITIGR_ASSERT(false);
+  } catch (const pgfe::Client_exception&) {}
+
+  const auto is_prepared = [&conn](const std::string& name)
+  {
+    const auto threshold = conn->auto_prepare_threshold();
+    conn->set_auto_prepare_threshold(0);
+    bool result{};
+    conn->execute([&result](auto&& row)
+    {
+      result = to<bool>(row[0]);
+    }, "select exists(select from pg_prepared_statements where name = $1)", name);
+    conn->set_auto_prepare_threshold(threshold);
+    return result;
+  };
+
+  // Promotion.
+  const pgfe::Statement statement{"select :num::integer"};
+  const auto execute = [&conn, &statement](const int num)
+  {
+    int result{};
+    conn->execute([&result](auto&& row)
+    {
+      result = to<int>(row[0]);
+    }, statement, pgfe::a{"num", num});
+    DMITIGR_ASSERT(result == num);
+  };
+  execute(1);
+  DMITIGR_ASSERT(!is_prepared("dmitigr_pgfe_auto_1"));
+  execute(2);
+  DMITIGR_ASSERT(is_prepared("dmitigr_pgfe_auto_1"));
+  execute(3);
+  DMITIGR_ASSERT(conn->auto_prepare_hit_count() == 1);
+  DMITIGR_ASSERT(conn->auto_prepare_miss_count() == 2);
+  // Auto-prepared statements don't make the session state dirty.
+  DMITIGR_ASSERT(!bool(conn->session_state() &
+      pgfe::Session_state::prepared_statements));
+  conn->prepare("select 1", "ps");
+  DMITIGR_ASSERT(bool(conn->session_state() &
+      pgfe::Session_state::prepared_statements));
+  conn->unprepare("ps");
+
+  // Eviction.
+  conn->execute("select 2");
+  conn->execute("select 3");
+  conn->execute("select 3");
+  DMITIGR_ASSERT(!is_prepared("dmitigr_pgfe_auto_1"));
+  DMITIGR_ASSERT(is_prepared("dmitigr_pgfe_auto_2"));
+  DMITIGR_ASSERT(conn->auto_prepare_miss_count() == 5);
+
+  // Unprepared by the user.
+  conn->unprepare("dmitigr_pgfe_auto_2");
+  conn->execute("select 3");
+  DMITIGR_ASSERT(conn->auto_prepare_hit_count() == 1);
+  conn->execute("select 3");
+  DMITIGR_ASSERT(is_prepared("dmitigr_pgfe_auto_3"));
+
+  // Invalidation on reset of session.
+  conn->disconnect();
+  conn->connect();
+  execute(4);
+  DMITIGR_ASSERT(conn->auto_prepare_hit_count() == 1);
+  DMITIGR_ASSERT(!is_prepared("dmitigr_pgfe_auto_3"));
+} catch (const std::exception& e) {
+  std::cerr << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "unknown error" << std::endl;
+  return 2;
+}
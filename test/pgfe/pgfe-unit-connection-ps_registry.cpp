@@ -0,0 +1,107 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pgfe-unit.hpp"
+
+int main()
+try {
+  namespace pgfe = dmitigr::pgfe;
+  using pgfe::to;
+
+  auto conn = pgfe::test::make_connection();
+  conn->connect();
+  DMITIGR_ASSERT(!conn->prepared_statement_count_limit());
+  DMITIGR_ASSERT(!conn->prepared_statement_memory_limit());
+  DMITIGR_ASSERT(!conn->prepared_statement_count());
+  DMITIGR_ASSERT(!conn->prepared_statement_memory_size());
+
+  const auto server_count = [&conn]
+  {
+    long result{};
+    conn->execute([&result](auto&& row)
+    {
+      result = to<long>(row[0]);
+    }, "select count(*) from pg_prepared_statements");
+    return result;
+  };
+
+  // Reclaiming of unreferenced statements.
+  {
+    auto ps1 = conn->prepare("select 1", "ps1");
+    conn->prepare("select 2", "ps2");
+    conn->prepare("select 3", "ps3");
+    DMITIGR_ASSERT(conn->prepared_statement_count() == 3);
+    DMITIGR_ASSERT(server_count() == 3);
+    conn->reclaim_prepared_statements();
+    DMITIGR_ASSERT(conn->prepared_statement_count() == 1);
+    DMITIGR_ASSERT(server_count() == 1);
+    DMITIGR_ASSERT(ps1.execute());
+  }
+  conn->reclaim_prepared_statements();
+  DMITIGR_ASSERT(!conn->prepared_statement_count());
+  DMITIGR_ASSERT(!server_count());
+
+  // Count limit.
+  conn->set_prepared_statement_count_limit(2);
+  DMITIGR_ASSERT(conn->prepared_statement_count_limit() == 2);
+  {
+    auto ps1 = conn->prepare("select 1", "ps1");
+    auto ps2 = conn->prepare("select 2", "ps2");
+    try {
+      conn->prepare("select 3", "ps3");
+      DMITIGR_ASSERT(false);
+    } catch (const pgfe::Client_exception&) {}
+    // Re-preparing and the unnamed statement are not subject to the limit.
+    ps1 = conn->prepare("select 1", "ps1");
+    conn->prepare("select 3");
+    DMITIGR_ASSERT(conn->prepared_statement_count() == 3);
+    // The statements named by the user are never reclaimed implicitly.
+    ps2 = {};
+    try {
+      conn->prepare("select 3", "ps3");
+      DMITIGR_ASSERT(false);
+    } catch (const pgfe::Client_exception&) {}
+    conn->reclaim_prepared_statements();
+    auto ps3 = conn->prepare("select 3", "ps3");
+    DMITIGR_ASSERT(conn->prepared_statement_count() == 3);
+    DMITIGR_ASSERT(server_count() == 2);
+  }
+  conn->set_prepared_statement_count_limit(0);
+  conn->reclaim_prepared_statements();
+
+  // Memory limit.
+  conn->set_prepared_statement_memory_limit(1);
+  DMITIGR_ASSERT(conn->prepared_statement_memory_limit() == 1);
+  {
+    auto ps1 = conn->prepare("select 1 one, 2 two", "ps1");
+    DMITIGR_ASSERT(!conn->prepared_statement_memory_size());
+    ps1.describe();
+    DMITIGR_ASSERT(conn->prepared_statement_memory_size());
+    try {
+      conn->prepare("select 2", "ps2");
+      DMITIGR_ASSERT(false);
+    } catch (const pgfe::Client_exception&) {}
+  }
+  conn->reclaim_prepared_statements();
+  conn->prepare("select 2", "ps2");
+  DMITIGR_ASSERT(!conn->prepared_statement_memory_size());
+} catch (const std::exception& e) {
+  std::cerr << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "unknown error" << std::endl;
+  return 2;
+}
@@ -526,6 +526,41 @@ try {
         DMITIGR_ASSERT(!std::memcmp(data->bytes(), data2->bytes(), data->size()));
         DMITIGR_ASSERT(to<std::string_view>(*hex_data) == conn->to_hex_string(*data));
       }
+
+      // session_state(), reset_session_state()
+      {
+        using Ss = pgfe::Session_state;
+        DMITIGR_ASSERT(!conn->is_session_state_dirty());
+        conn->execute("select 1");
+        DMITIGR_ASSERT(conn->session_state() == Ss::clean);
+
+        conn->execute("begin");
+        DMITIGR_ASSERT(conn->session_state() == Ss::transaction);
+        conn->execute("declare c cursor with hold for select 1");
+        conn->execute("set application_name to 'pgfe-unit-connection'");
+        conn->execute("create temp table session_state_tmp(i integer)");
+        conn->execute("listen session_state_channel");
+        conn->execute("prepare session_state_ps as select 1");
+        auto ps = conn->prepare("select 2", "session_state_ps2");
+        DMITIGR_ASSERT(ps);
+        DMITIGR_ASSERT(conn->session_state() == (Ss::transaction | Ss::cursors |
+            Ss::settings | Ss::temporary_objects | Ss::listening |
+            Ss::prepared_statements));
+
+        conn->reset_session_state(Ss::transaction | Ss::settings);
+        DMITIGR_ASSERT(conn->session_state() == (Ss::cursors |
+            Ss::temporary_objects | Ss::listening | Ss::prepared_statements));
+        DMITIGR_ASSERT(conn->transaction_status() == Transaction_status::unstarted);
+        DMITIGR_ASSERT(ps);
+
+        conn->reset_session_state(conn->session_state());
+        DMITIGR_ASSERT(!conn->is_session_state_dirty());
+        DMITIGR_ASSERT(!ps); // deallocated
+        conn->execute("prepare session_state_ps as select 1"); // no conflict
+
+        conn->execute("discard all");
+        DMITIGR_ASSERT(!conn->is_session_state_dirty());
+      }
     }
 } catch (const std::exception& e) {
   std::cerr << e.what() << std::endl;
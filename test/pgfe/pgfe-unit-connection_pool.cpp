@@ -16,6 +16,9 @@
 
 #include "pgfe-unit.hpp"
 
+#include <thread>
+#include <vector>
+
 namespace pgfe = dmitigr::pgfe;
 
 int main()
@@ -24,8 +27,15 @@ try {
   pgfe::Connection_pool pool{pool_size, pgfe::test::connection_options()};
   DMITIGR_ASSERT(pool.size() == pool_size);
   DMITIGR_ASSERT(!pool.is_connected());
+  std::size_t connect_count{};
+  pool.set_connect_handler([&connect_count](pgfe::Connection& conn)
+  {
+    DMITIGR_ASSERT(conn.is_connected());
+    ++connect_count;
+  });
   pool.connect();
   DMITIGR_ASSERT(pool.is_connected());
+  DMITIGR_ASSERT(connect_count == pool_size);
 
   pgfe::Connection* conn1p{};
   pgfe::Connection* conn2p{};
@@ -71,6 +81,164 @@ try {
   DMITIGR_ASSERT(!conn1p->is_connected());
   DMITIGR_ASSERT(!conn2p->is_connected());
   DMITIGR_ASSERT(!conn3p->is_connected());
+
+  // Waiting for a free connection.
+  {
+    using std::chrono::milliseconds;
+    pool.connect();
+    DMITIGR_ASSERT(pool.free_count() == pool_size);
+    std::vector<pgfe::Connection_pool::Handle> handles;
+    for (std::size_t i{}; i < pool_size; ++i)
+      handles.push_back(pool.connection(std::nullopt));
+    DMITIGR_ASSERT(!pool.free_count());
+    DMITIGR_ASSERT(!pool.wait_count());
+
+    try {
+      pool.connection(milliseconds{10});
+      DMITIGR_ASSERT(false);
+    } catch (const pgfe::Client_exception& e) {
+      DMITIGR_ASSERT(e.condition() == pgfe::Client_errc::timed_out);
+    }
+    DMITIGR_ASSERT(pool.wait_count() == 1);
+    DMITIGR_ASSERT(pool.wait_timeout_count() == 1);
+    DMITIGR_ASSERT(pool.wait_time() >= milliseconds{10});
+    DMITIGR_ASSERT(!pool.wait_queue_size());
+
+    std::thread waiter{[&pool]
+    {
+      auto conn = pool.connection(std::nullopt);
+      DMITIGR_ASSERT(conn);
+      conn->execute("select 1");
+    }};
+    while (!pool.wait_queue_size())
+      std::this_thread::yield();
+    handles.pop_back(); // handed off to the waiter
+    waiter.join();
+    DMITIGR_ASSERT(pool.wait_count() == 2);
+    DMITIGR_ASSERT(pool.wait_timeout_count() == 1);
+    DMITIGR_ASSERT(pool.free_count() == 1);
+  }
+
+  // Elastic pool.
+  {
+    using std::chrono::milliseconds;
+    pgfe::Connection_pool pool{1, pool_size, pgfe::test::connection_options()};
+    DMITIGR_ASSERT(pool.min_size() == 1);
+    DMITIGR_ASSERT(pool.size() == pool_size);
+    DMITIGR_ASSERT(!pool.open_count());
+    pool.connect();
+    DMITIGR_ASSERT(pool.open_count() == 1);
+    DMITIGR_ASSERT(pool.free_count() == 1);
+
+    // Growth on demand.
+    {
+      std::vector<pgfe::Connection_pool::Handle> handles;
+      for (std::size_t i{}; i < pool_size; ++i) {
+        handles.push_back(pool.connection());
+        DMITIGR_ASSERT(handles.back());
+        DMITIGR_ASSERT(handles.back()->is_connected());
+      }
+      DMITIGR_ASSERT(pool.open_count() == pool_size);
+      DMITIGR_ASSERT(!pool.connection());
+    }
+    DMITIGR_ASSERT(pool.free_count() == pool_size);
+
+    // Validation by batches.
+    DMITIGR_ASSERT(pool.validation_batch_size() == 8);
+    pool.set_validation_batch_size(2);
+    DMITIGR_ASSERT(pool.validation_batch_size() == 2);
+    pool.set_validation_idle_threshold(milliseconds{});
+    DMITIGR_ASSERT(pool.validation_idle_threshold() == milliseconds{});
+    pool.maintain();
+    DMITIGR_ASSERT(pool.free_count() == pool_size);
+    DMITIGR_ASSERT(!pool.broken_count());
+
+    // Shrinking down to the minimum.
+    pool.maintain();
+    DMITIGR_ASSERT(pool.open_count() == pool_size);
+    pool.set_idle_timeout(milliseconds{});
+    pool.maintain();
+    DMITIGR_ASSERT(pool.open_count() == 1);
+    DMITIGR_ASSERT(pool.free_count() == 1);
+    DMITIGR_ASSERT(pool.idle_close_count() == pool_size - 1);
+    DMITIGR_ASSERT(!pool.broken_count());
+
+    // Reopening the broken connections.
+    {
+      auto conn = pool.connection();
+      DMITIGR_ASSERT(conn);
+      conn->disconnect();
+    }
+    DMITIGR_ASSERT(!pool.open_count());
+    pool.maintain();
+    DMITIGR_ASSERT(pool.open_count() == 1);
+
+    // Background maintenance.
+    pool.set_maintenance_interval(milliseconds{10});
+    DMITIGR_ASSERT(pool.maintenance_interval() == milliseconds{10});
+    pool.disconnect();
+    DMITIGR_ASSERT(!pool.open_count());
+  }
+
+  // Catalog of prepared statements.
+  {
+    pgfe::Connection_pool pool{1, 2, pgfe::test::connection_options()};
+    pool.add_prepared_statement("plus_one", pgfe::Statement{"select :n::int + 1"});
+    DMITIGR_ASSERT(pool.prepared_statement_count() == 1);
+    pool.connect();
+    {
+      auto conn = pool.connection();
+      DMITIGR_ASSERT(conn);
+      DMITIGR_ASSERT(conn->prepared_statement_count() == 1); // replayed
+      auto ps = conn.prepared_statement("plus_one");
+      DMITIGR_ASSERT(ps && ps.name() == "plus_one");
+      ps.bind("n", 1).execute([](auto&& row)
+      {
+        DMITIGR_ASSERT(pgfe::to<int>(row[0]) == 2);
+      });
+    }
+
+    // Added after connecting, so prepared upon the first use.
+    pool.add_prepared_statement("plus_two", pgfe::Statement{"select $1::int + 2"});
+    {
+      auto conn = pool.connection();
+      DMITIGR_ASSERT(conn);
+      DMITIGR_ASSERT(conn->prepared_statement_count() == 1); // kept by release
+      auto ps = conn.prepared_statement("plus_two");
+      DMITIGR_ASSERT(ps);
+      DMITIGR_ASSERT(conn->prepared_statement_count() == 2);
+
+      // Restored after reconnect.
+      conn->disconnect();
+    }
+    {
+      auto conn = pool.connection();
+      DMITIGR_ASSERT(conn);
+      DMITIGR_ASSERT(conn->prepared_statement_count() == 2);
+    }
+
+    // Replaced and removed ones are reprepared and deallocated upon use.
+    pool.add_prepared_statement("plus_one", pgfe::Statement{"select $1::int + 10"});
+    pool.remove_prepared_statement("plus_two");
+    DMITIGR_ASSERT(pool.prepared_statement_count() == 1);
+    {
+      auto conn = pool.connection();
+      DMITIGR_ASSERT(conn);
+      auto ps = conn.prepared_statement("plus_one");
+      DMITIGR_ASSERT(ps);
+      DMITIGR_ASSERT(conn->prepared_statement_count() == 1);
+      ps.bind(0, 1).execute([](auto&& row)
+      {
+        DMITIGR_ASSERT(pgfe::to<int>(row[0]) == 11);
+      });
+    }
+
+    try {
+      auto conn = pool.connection();
+      conn.prepared_statement("unknown");
+      DMITIGR_ASSERT(false);
+    } catch (const pgfe::Client_exception&) {}
+  }
 } catch (const std::exception& e) {
   std::cerr << e.what() << std::endl;
   return 1;
@@ -0,0 +1,136 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pgfe-unit.hpp"
+
+#include <vector>
+
+#define ASSERT DMITIGR_ASSERT
+
+int main()
+try {
+  namespace pgfe = dmitigr::pgfe;
+  using pgfe::to;
+  using std::chrono::milliseconds;
+
+  pgfe::Connection_reactor reactor;
+  ASSERT(!reactor.connection_count());
+  ASSERT(!reactor.pending_count());
+  ASSERT(!reactor.run_once(milliseconds{}));
+
+  // Connection failures.
+  {
+    pgfe::Connection conn{pgfe::test::connection_options().set_port(1)};
+    bool is_failed{};
+    reactor.add_connection(conn,
+      [&](pgfe::Connection& conn, const std::error_code errc)
+      {
+        ASSERT(errc == std::errc::not_connected);
+        ASSERT(conn.status() == pgfe::Connection_status::failure);
+        is_failed = true;
+      });
+    reactor.run();
+    ASSERT(is_failed);
+    ASSERT(!reactor.pending_count());
+    reactor.remove_connection(conn);
+  }
+
+  // Connecting and querying of many connections from the single thread.
+  {
+    constexpr std::size_t conn_count{8};
+    std::vector<std::unique_ptr<pgfe::Connection>> conns;
+    std::size_t connected_count{};
+    int row_sum{};
+    std::size_t done_count{};
+    for (std::size_t i{}; i < conn_count; ++i) {
+      conns.push_back(pgfe::test::make_connection());
+      reactor.add_connection(*conns.back(),
+        [&](pgfe::Connection& conn, const std::error_code errc)
+        {
+          ASSERT(!errc);
+          ASSERT(conn.is_connected());
+          ++connected_count;
+          conn.execute_nio("select generate_series(1, 3)");
+          reactor.add_request(conn,
+            [&](pgfe::Row&& row)
+            {
+              row_sum += to<int>(row[0]);
+            },
+            [&](pgfe::Request_handle&& handle, const std::error_code errc)
+            {
+              ASSERT(!errc);
+              ASSERT(handle.is_ready());
+              ASSERT(handle.completion().row_count() == 3);
+              ++done_count;
+            });
+        });
+    }
+    ASSERT(reactor.connection_count() == conn_count);
+    ASSERT(reactor.pending_count() == conn_count);
+
+    ASSERT(reactor.run() == 2*conn_count);
+    ASSERT(!reactor.pending_count());
+    ASSERT(connected_count == conn_count);
+    ASSERT(done_count == conn_count);
+    ASSERT(row_sum == 6*static_cast<int>(conn_count));
+
+    // Errors.
+    auto& conn = *conns.front();
+    conn.execute_nio("select 1/0");
+    bool is_error{};
+    reactor.add_request(conn, {},
+      [&](pgfe::Request_handle&& handle, const std::error_code errc)
+      {
+        ASSERT(!errc);
+        ASSERT(handle.error().condition() == pgfe::Server_errc::c22_division_by_zero);
+        is_error = true;
+      });
+    reactor.run();
+    ASSERT(is_error);
+
+    for (const auto& c : conns)
+      reactor.remove_connection(*c);
+    ASSERT(!reactor.connection_count());
+  }
+
+  // Timeouts.
+  {
+    auto conn = pgfe::test::make_connection();
+    conn->connect();
+    reactor.add_connection(*conn);
+    ASSERT(reactor.has_connection(*conn));
+    ASSERT(!reactor.pending_count());
+    conn->execute_nio("select pg_sleep(5)");
+    bool is_timed_out{};
+    reactor.add_request(*conn, {},
+      [&](pgfe::Request_handle&& handle, const std::error_code errc)
+      {
+        ASSERT(errc == pgfe::Client_errc::timed_out);
+        ASSERT(!handle.is_ready());
+        is_timed_out = true;
+      }, milliseconds{50});
+    ASSERT(reactor.run() == 1);
+    ASSERT(is_timed_out);
+    reactor.remove_connection(*conn);
+    ASSERT(!reactor.has_connection(*conn));
+  }
+} catch (const std::exception& e) {
+  std::cerr << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "unknown error" << std::endl;
+  return 2;
+}
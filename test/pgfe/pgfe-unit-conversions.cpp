@@ -20,6 +20,7 @@
 #include "../../src/pgfe/exceptions.hpp"
 #include "../../src/util/diagnostic.hpp"
 
+#include <cmath>
 #include <limits>
 #include <optional>
 #include <string>
@@ -135,6 +136,148 @@ int main()
       DMITIGR_ASSERT(original == converted);
     }
 
+    // Text representations of numerics
+    {
+      using pgfe::Data;
+      DMITIGR_ASSERT(pgfe::to<int>(*Data::make_no_copy(" +42")) == 42);
+      DMITIGR_ASSERT(pgfe::to<int>(*Data::make_no_copy("-42")) == -42);
+      DMITIGR_ASSERT(pgfe::to<double>(*Data::make_no_copy("0.1")) == 0.1);
+      DMITIGR_ASSERT(pgfe::to<double>(*Data::make_no_copy("-Infinity")) ==
+        -numeric_limits<double>::infinity());
+      DMITIGR_ASSERT(std::isnan(pgfe::to<double>(*Data::make_no_copy("NaN"))));
+      DMITIGR_ASSERT(pgfe::to<std::string_view>(*pgfe::to_data(0.1)) == "0.1");
+      DMITIGR_ASSERT(pgfe::to<std::string_view>(*pgfe::to_data(-7)) == "-7");
+      DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([]
+      {
+        pgfe::to<short>(*Data::make_no_copy("32768"));
+      }));
+      DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([]
+      {
+        pgfe::to<int>(*Data::make_no_copy("1a"));
+      }));
+    }
+
+    // Binary representations of parameters
+    {
+      using pgfe::Data_format;
+      const auto i = pgfe::to_data(0x01020304, Data_format::binary);
+      DMITIGR_ASSERT(i->format() == Data_format::binary);
+      DMITIGR_ASSERT(pgfe::to<std::string_view>(*i) == "\x01\x02\x03\x04");
+      DMITIGR_ASSERT(pgfe::to<int>(*i) == 0x01020304);
+      const auto ll = pgfe::to_data(-2LL, Data_format::binary);
+      DMITIGR_ASSERT(ll->size() == 8 && pgfe::to<long long>(*ll) == -2);
+      const auto d = pgfe::to_data(0.1, Data_format::binary);
+      DMITIGR_ASSERT(d->size() == 8 && pgfe::to<double>(*d) == 0.1);
+      const auto b = pgfe::to_data(true, Data_format::binary);
+      DMITIGR_ASSERT(b->size() == 1 && pgfe::to<bool>(*b));
+      const auto t = pgfe::to_data(7, Data_format::text);
+      DMITIGR_ASSERT(t->format() == Data_format::text);
+      DMITIGR_ASSERT(pgfe::to<std::string_view>(*t) == "7");
+      DMITIGR_ASSERT(!pgfe::to_data(std::optional<int>{}, Data_format::binary));
+      DMITIGR_ASSERT(pgfe::to_data(std::optional<short>{1},
+          Data_format::binary)->size() == 2);
+      DMITIGR_ASSERT(pgfe::detail::Is_binary_data_convertible<int>::value);
+      DMITIGR_ASSERT(!pgfe::detail::Is_binary_data_convertible<long double>::value);
+      DMITIGR_ASSERT(!pgfe::detail::Is_binary_data_convertible<std::string>::value);
+    }
+
+    // Arrays in binary format
+    {
+      using pgfe::Data_format;
+      using Ints = std::vector<std::optional<int>>;
+      const Ints ints{1, std::nullopt, -3};
+      const auto data = pgfe::to_data(ints, Data_format::binary);
+      DMITIGR_ASSERT(data->format() == Data_format::binary);
+      // header (5*4), three elements (4+4, 4, 4+4)
+      DMITIGR_ASSERT(data->size() == 20 + 8 + 4 + 8);
+      const auto* const bytes = static_cast<const char*>(data->bytes());
+      DMITIGR_ASSERT(bytes[3] == 1 && bytes[7] == 1 && bytes[11] == 23);
+      DMITIGR_ASSERT(pgfe::to<Ints>(*data) == ints);
+      DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([&data]
+      {
+        pgfe::to<std::vector<std::optional<long long>>>(*data); // int4 != int8
+      }));
+
+      using Matrix = std::vector<std::vector<std::string>>;
+      Matrix matrix{{"a", "b c"}, {"", "\"d\""}};
+      const auto mdata = pgfe::to_data(Matrix{matrix}, Data_format::binary);
+      DMITIGR_ASSERT(pgfe::to<Matrix>(*mdata) == matrix);
+      DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([&mdata]
+      {
+        pgfe::to<std::vector<std::string>>(*mdata);
+      }));
+      DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([]
+      {
+        pgfe::to_data(Matrix{{"a"}, {"b", "c"}}, Data_format::binary);
+      }));
+
+      const auto empty = pgfe::to_data(Matrix{}, Data_format::binary);
+      DMITIGR_ASSERT(empty->size() == 12);
+      DMITIGR_ASSERT(pgfe::to<Matrix>(*empty).empty());
+      DMITIGR_ASSERT(pgfe::detail::Is_binary_data_convertible<Ints>::value);
+      DMITIGR_ASSERT(!pgfe::detail::Is_binary_data_convertible<
+          std::vector<long double>>::value);
+    }
+
+    // bytea
+    {
+      using Bytes = std::vector<std::byte>;
+      const Bytes original{std::byte{0}, std::byte{0xab}, std::byte{'\\'}};
+      const auto text = pgfe::to_data(original);
+      DMITIGR_ASSERT(pgfe::to<std::string_view>(*text) == "\\x00ab5c");
+      DMITIGR_ASSERT(pgfe::to<Bytes>(*text) == original);
+      const auto binary = pgfe::to_data(original, pgfe::Data_format::binary);
+      DMITIGR_ASSERT(binary->size() == 3);
+      DMITIGR_ASSERT(pgfe::to<Bytes>(*binary) == original);
+
+      // Long values are decoded by blocks.
+      Bytes long_original(1000);
+      for (std::size_t i{}; i < long_original.size(); ++i)
+        long_original[i] = static_cast<std::byte>(i * 31);
+      auto long_text = pgfe::to<std::string>(*pgfe::to_data(long_original));
+      DMITIGR_ASSERT(pgfe::to<Bytes>(*pgfe::Data::make_no_copy(long_text)) ==
+        long_original);
+      long_text.insert(2 + long_original.size(), " ");
+      long_text[40] = static_cast<char>(std::toupper(long_text[40]));
+      DMITIGR_ASSERT(pgfe::to<Bytes>(*pgfe::Data::make_no_copy(long_text)) ==
+        long_original);
+      DMITIGR_ASSERT(*pgfe::Data::to_bytea(long_text) ==
+        *pgfe::to_data(long_original, pgfe::Data_format::binary));
+
+      // Decoding into the caller-provided buffer.
+      DMITIGR_ASSERT(pgfe::Data::decoded_bytea_capacity("\\x0aff") == 2);
+      DMITIGR_ASSERT(pgfe::Data::decoded_bytea_capacity("\\x") == 0);
+      DMITIGR_ASSERT(pgfe::Data::decoded_bytea_capacity("a\\\\") == 3);
+      std::byte buffer[8];
+      DMITIGR_ASSERT(pgfe::Data::decode_bytea("\\x0aff", buffer,
+          sizeof(buffer)) == 2);
+      DMITIGR_ASSERT(buffer[0] == std::byte{10} && buffer[1] == std::byte{0xff});
+      DMITIGR_ASSERT(pgfe::Data::decode_bytea("a\\\\\\001\\377", buffer,
+          sizeof(buffer)) == 4);
+      DMITIGR_ASSERT(buffer[0] == std::byte{'a'} && buffer[1] == std::byte{'\\'});
+      DMITIGR_ASSERT(buffer[2] == std::byte{1} && buffer[3] == std::byte{0xff});
+      for (const auto* const invalid : {"\\x0", "\\x0g", "\\x0a0b0c0d0e0f0a0b0c",
+          "\\400", "\\1", "\\a"}) {
+        DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([&]
+        {
+          pgfe::Data::decode_bytea(invalid, buffer, sizeof(buffer));
+        }));
+      }
+
+      // Bytea_view refers to the bytes of the binary data.
+      const auto view = pgfe::to<pgfe::Bytea_view>(*binary);
+      DMITIGR_ASSERT(view.data() == binary->bytes() && view.size() == 3);
+      DMITIGR_ASSERT(Bytes(view.begin(), view.end()) == original);
+      DMITIGR_ASSERT(pgfe::to<std::string_view>(*pgfe::to_data(view)) ==
+        "\\x00ab5c");
+      DMITIGR_ASSERT(pgfe::to_data(view, pgfe::Data_format::binary)->bytes() ==
+        binary->bytes());
+      DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([&]
+      {
+        pgfe::to<pgfe::Bytea_view>(*text);
+      }));
+    }
+
     // char
     {
       char original = 'd';
@@ -351,6 +494,17 @@ int main()
         DMITIGR_ASSERT((native_vec2 == Vec2{Vec{1}}));
       }
 
+      {
+        using Strs = Vector_array<std::string>;
+        const std::string long_element(100, 'x');
+        const std::string valid_literal{R"({ a b , "c\"d" ,"\\", NuLl,"null",)"
+          R"("",)" + long_element + R"(,")" + long_element + R"(\\"})"};
+        const auto data = pgfe::Data::make(valid_literal);
+        const auto native = pgfe::to<Strs>(*data);
+        DMITIGR_ASSERT((native == Strs{"a b", "c\"d", "\\", {}, "null", "",
+          long_element, long_element + "\\"}));
+      }
+
       {
         auto malformed_literals  = {"{1", "{1,", "{1,}", "1}", ",1}", "{,1}"};
         for (const auto* malformed_literal : malformed_literals) {
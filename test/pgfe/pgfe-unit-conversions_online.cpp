@@ -15,10 +15,17 @@
 // limitations under the License.
 
 #include "../../src/pgfe/conversions.hpp"
+#include "../../src/pgfe/decimal.hpp"
+#include "../../src/pgfe/flat_array.hpp"
+#include "../../src/pgfe/network_address.hpp"
 #include "../../src/pgfe/row.hpp"
 #include "../../src/pgfe/statement.hpp"
+#include "../../src/pgfe/temporal.hpp"
+#include "../../src/pgfe/tuple.hpp"
+#include "../../src/pgfe/uuid.hpp"
 #include "pgfe-unit.hpp"
 
+#include <chrono>
 #include <optional>
 #include <limits>
 #include <string>
@@ -125,6 +132,217 @@ try {
       }, "SELECT true, $1::boolean", false);
     }
   }
+
+  // Parameters in binary format
+  {
+    conn->set_parameter_format(Data_format::binary);
+    auto ps = conn->prepare("SELECT $1::bigint, $2::integer, $3::smallint,"
+      " $4::double precision, $5::real, $6::boolean, $7::bytea, $8::text");
+    DMITIGR_ASSERT(ps.parameter_format() == Data_format::binary);
+    const std::vector<std::byte> bytes{std::byte{0}, std::byte{0xff}};
+    ps.bind_many(-1000000000000LL, 65536, short{-2}, 0.5, 1.5f, true, bytes,
+      "dima");
+    DMITIGR_ASSERT(ps.bound(0).format() == Data_format::binary);
+    DMITIGR_ASSERT(ps.bound(7).format() == Data_format::text);
+    ps.execute([&bytes](auto&& row)
+    {
+      DMITIGR_ASSERT(to<long long>(row[0]) == -1000000000000LL);
+      DMITIGR_ASSERT(to<int>(row[1]) == 65536);
+      DMITIGR_ASSERT(to<short>(row[2]) == -2);
+      DMITIGR_ASSERT(to<double>(row[3]) == 0.5);
+      DMITIGR_ASSERT(to<float>(row[4]) == 1.5f);
+      DMITIGR_ASSERT(to<bool>(row[5]));
+      DMITIGR_ASSERT(to<std::vector<std::byte>>(row[6]) == bytes);
+      DMITIGR_ASSERT(to<std::string_view>(row[7]) == "dima");
+    });
+    conn->set_parameter_format(Data_format::text);
+  }
+
+  // Arrays in binary format
+  {
+    using Ints = std::vector<std::optional<int>>;
+    using Matrix = std::vector<std::vector<std::string>>;
+    conn->set_result_format(Data_format::binary);
+    conn->set_parameter_format(Data_format::binary);
+    const Ints ints{1, std::nullopt, 3};
+    conn->execute([&ints](auto&& row)
+    {
+      DMITIGR_ASSERT(to<Ints>(row[0]) == ints);
+      DMITIGR_ASSERT(to<Ints>(row[1]) == ints);
+      DMITIGR_ASSERT((to<Matrix>(row[2]) == Matrix{{"a", "b"}, {"c", "d"}}));
+      DMITIGR_ASSERT(to<Ints>(row[3]).empty());
+      DMITIGR_ASSERT(to<int>(row[4]) == 4);
+    }, "SELECT $1::integer[], '{1,NULL,3}'::integer[],"
+      " '{{a,b},{c,d}}'::text[], '{}'::integer[], array_length($2::text[], 1)",
+      ints, std::vector<std::string>{"a", "b", "c", "d"});
+    conn->set_parameter_format(Data_format::text);
+    conn->set_result_format(Data_format::text);
+  }
+
+  // Flat arrays
+  for (const auto fmt : {Data_format::binary, Data_format::text}) {
+    using Ints = pgfe::Flat_array<int>;
+    conn->set_result_format(fmt);
+    conn->set_parameter_format(fmt);
+    const Ints keys{{2, 3, 5}};
+    int count{};
+    conn->execute([&count](auto&& row)
+    {
+      count += to<int>(row[0]);
+    }, "SELECT n FROM generate_series(1, 5) n WHERE n = ANY($1::integer[])",
+      keys);
+    DMITIGR_ASSERT(count == 10);
+
+    conn->execute([](auto&& row)
+    {
+      const auto matrix = to<Ints>(row[0]);
+      DMITIGR_ASSERT(matrix.dimension_count() == 2);
+      DMITIGR_ASSERT(matrix.extent(0) == 2 && matrix.extent(1) == 2);
+      DMITIGR_ASSERT(matrix.lower_bound(0) == 0);
+      DMITIGR_ASSERT(matrix(1, 0) == 3 && matrix.is_null(1));
+      DMITIGR_ASSERT(to<int>(row[1]) == 3);
+    }, "SELECT '[0:1][1:2]={{1,NULL},{3,4}}'::integer[],"
+      " (SELECT count(*)::integer FROM unnest($1::integer[]))", keys);
+  }
+
+#ifdef __SIZEOF_INT128__
+  // Decimal
+  for (const auto fmt : {Data_format::binary, Data_format::text}) {
+    using pgfe::Decimal;
+    conn->set_result_format(fmt);
+    conn->set_parameter_format(fmt);
+    const Decimal money{-123456789012345678, 4};
+    conn->execute([&money](auto&& row)
+    {
+      DMITIGR_ASSERT(to<Decimal>(row[0]) == money);
+      DMITIGR_ASSERT(to<Decimal>(row[0]).scale() == 4);
+      DMITIGR_ASSERT(to<Decimal>(row[1]) == Decimal(15, 1));
+      DMITIGR_ASSERT(to<Decimal>(row[2]) == Decimal(10000000000));
+      DMITIGR_ASSERT(to<bool>(row[3]));
+    }, "SELECT '-12345678901234.5678'::numeric(18,4), 1.50::numeric(3,1),"
+      " 1e10::numeric, $1::numeric(18,4) = '-12345678901234.5678'", money);
+  }
+#endif
+
+  // Large bytea
+  for (const auto fmt : {Data_format::binary, Data_format::text}) {
+    using Bytes = std::vector<std::byte>;
+    conn->set_result_format(fmt);
+    conn->set_parameter_format(fmt);
+    Bytes blob(100000);
+    for (std::size_t i{}; i < blob.size(); ++i)
+      blob[i] = static_cast<std::byte>(i * 7);
+    conn->execute([&blob, fmt](auto&& row)
+    {
+      DMITIGR_ASSERT(to<Bytes>(row[0]) == blob);
+      if (fmt == Data_format::binary) {
+        const auto view = to<pgfe::Bytea_view>(row[0]);
+        DMITIGR_ASSERT(view.data() == row[0].bytes());
+        DMITIGR_ASSERT(Bytes(view.begin(), view.end()) == blob);
+      }
+    }, "SELECT $1::bytea", blob);
+    conn->execute([&blob](auto&& row)
+    {
+      DMITIGR_ASSERT(to<bool>(row[0]));
+    }, "SELECT $1::bytea = $2::bytea", blob,
+      pgfe::Bytea_view{blob.data(), blob.size()});
+  }
+  conn->set_parameter_format(Data_format::text);
+  conn->set_result_format(Data_format::text);
+
+  // UUID and network address types
+  for (const auto fmt : {Data_format::binary, Data_format::text}) {
+    namespace net = dmitigr::net;
+    conn->set_result_format(fmt);
+    conn->set_parameter_format(fmt);
+    const pgfe::Uuid uuid{{0xa0, 0xee, 0xbc, 0x99, 0x9c, 0x0b, 0x4e, 0xf8,
+      0xbb, 0x6d, 0x6b, 0xb9, 0xbd, 0x38, 0x0a, 0x11}};
+    const pgfe::Inet network{net::Ip_address::from_text("2001:db8::"), 32};
+    const pgfe::Mac_address mac{{0x08, 0x00, 0x2b, 0x01, 0x02, 0x03}};
+    conn->execute([&](auto&& row)
+    {
+      DMITIGR_ASSERT(to<pgfe::Uuid>(row[0]) == uuid);
+      DMITIGR_ASSERT(to<pgfe::Inet>(row[1]) == network);
+      DMITIGR_ASSERT(to<pgfe::Inet>(row[2]) == network);
+      DMITIGR_ASSERT(to<net::Ip_address>(row[3]) ==
+        net::Ip_address::from_text("192.168.0.1"));
+      DMITIGR_ASSERT(to<pgfe::Mac_address>(row[4]) == mac);
+      DMITIGR_ASSERT(to<bool>(row[5]));
+    }, "SELECT $1::uuid, $2::inet, $2::cidr, '192.168.0.1'::inet,"
+      " '0800.2b01.0203'::macaddr,"
+      " ($1::uuid, $2::inet, $3::macaddr) ="
+      " ('a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11'::uuid, '2001:db8::/32'::inet,"
+      " '08:00:2b:01:02:03'::macaddr)", uuid, network, mac);
+  }
+  conn->set_parameter_format(Data_format::text);
+  conn->set_result_format(Data_format::text);
+
+  // Records
+  conn->execute("CREATE TEMP TABLE pgfe_point(x integer, y text)");
+  for (const auto fmt : {Data_format::binary, Data_format::text}) {
+    using pgfe::Tuple;
+    conn->set_result_format(fmt);
+    conn->execute([](auto&& row)
+    {
+      const auto records = to<std::vector<Tuple>>(row[0]);
+      DMITIGR_ASSERT(records.size() == 3);
+      for (std::size_t i{}; i < records.size(); ++i) {
+        DMITIGR_ASSERT(to<int>(records[i][0]) == static_cast<int>(i + 1));
+        DMITIGR_ASSERT(to<std::vector<int>>(records[i][2]) ==
+          std::vector<int>(i + 1, 7));
+      }
+      DMITIGR_ASSERT(to<std::string>(records[1][1]) == "a \"b\",\\");
+      DMITIGR_ASSERT(!records[2][1]);
+
+      const auto record = to<Tuple>(row[1]);
+      DMITIGR_ASSERT(record.field_count() == 2 && to<int>(record[0]) == 1);
+      DMITIGR_ASSERT(to<Tuple>(record[1]).field_count() == 1);
+    }, "SELECT array_agg(row(n, CASE n WHEN 1 THEN 'one'"
+      " WHEN 2 THEN 'a \"b\",\\' END, array_fill(7, array[n]))),"
+      " row(1, row(2))"
+      " FROM generate_series(1, 3) n");
+
+    Tuple point;
+    point.append("x", pgfe::to_data(3, fmt));
+    point.append("y", pgfe::Data::make(std::string_view{"three"}, fmt));
+    conn->execute([](auto&& row)
+    {
+      DMITIGR_ASSERT(to<int>(row[0]) == 3);
+      DMITIGR_ASSERT(to<std::string_view>(row[1]) == "three");
+    }, "SELECT ($1::pgfe_point).x, ($1::pgfe_point).y",
+      pgfe::to_data(point, fmt, std::vector<pgfe::Oid>{23, 25}));
+  }
+  conn->set_result_format(Data_format::text);
+
+  // Temporal types
+  conn->execute("SET TimeZone TO 'Europe/Moscow'");
+  for (const auto fmt : {Data_format::binary, Data_format::text}) {
+    namespace chrono = std::chrono;
+    using Sys_time = chrono::time_point<chrono::system_clock,
+      chrono::microseconds>;
+    using Local_time = pgfe::Local_time<chrono::microseconds>;
+    conn->set_result_format(fmt);
+    conn->set_parameter_format(fmt);
+    const Sys_time epoch{chrono::seconds{946684800}};
+    const pgfe::Interval interval{14, -3, chrono::milliseconds{-1500}};
+    conn->execute([&](auto&& row)
+    {
+      DMITIGR_ASSERT(to<Sys_time>(row[0]) == epoch + chrono::microseconds{5});
+      DMITIGR_ASSERT(to<Local_time>(row[1]).time_since_epoch() ==
+        chrono::hours{24*10957 + 3});
+      DMITIGR_ASSERT((to<pgfe::Date>(row[2]) == pgfe::Date{44, 3, 15}));
+      DMITIGR_ASSERT(to<pgfe::Time_of_day>(row[3]).to_duration() ==
+        chrono::hours{23} + chrono::minutes{59});
+      DMITIGR_ASSERT(to<pgfe::Interval>(row[4]) == interval);
+      DMITIGR_ASSERT(to<bool>(row[5]));
+    }, "SELECT $1::timestamptz + interval '5 microseconds',"
+      " $1::timestamptz::timestamp, '0044-03-15'::date, '23:59'::time,"
+      " '1 year 2 mons -3 days -1.5 seconds'::interval, $2::interval = $3",
+      epoch, interval, "1 year 2 mons -3 days -00:00:01.5");
+  }
+  conn->execute("RESET TimeZone");
+  conn->set_parameter_format(Data_format::text);
+  conn->set_result_format(Data_format::text);
 } catch (const std::exception& e) {
   std::cerr << e.what() << std::endl;
   return 1;
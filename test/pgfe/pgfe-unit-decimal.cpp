@@ -0,0 +1,153 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../../src/base/assert.hpp"
+#include "../../src/pgfe/array_aliases.hpp"
+#include "../../src/pgfe/conversions.hpp"
+#include "../../src/pgfe/decimal.hpp"
+#include "../../src/util/diagnostic.hpp"
+
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+int main()
+try {
+#ifdef __SIZEOF_INT128__
+  namespace pgfe = dmitigr::pgfe;
+  using pgfe::Data;
+  using pgfe::Data_format;
+  using pgfe::Decimal;
+  using pgfe::to;
+  using pgfe::to_data;
+  using dmitigr::util::with_catch;
+
+  const auto text = [](const std::string_view literal)
+  {
+    return Data::make(literal, Data_format::text);
+  };
+
+  // The PostgreSQL's numeric in binary format.
+  const auto numeric = [](const std::int16_t weight, const std::uint16_t sign,
+    const std::int16_t scale, const std::initializer_list<std::int16_t> digits)
+  {
+    std::string result;
+    const auto append = [&result](const auto value)
+    {
+      char buffer[sizeof(value)];
+      dmitigr::net::copy(buffer, sizeof(buffer), value);
+      result.append(buffer, sizeof(buffer));
+    };
+    append(static_cast<std::int16_t>(digits.size()));
+    append(weight);
+    append(sign);
+    append(scale);
+    for (const auto digit : digits)
+      append(digit);
+    return Data::make(std::move(result), Data_format::binary);
+  };
+
+  // Construction and comparison
+  {
+    const Decimal value{-123456, 4};
+    DMITIGR_ASSERT(value.unscaled_value() == -123456 && value.scale() == 4);
+    DMITIGR_ASSERT(value == Decimal(-1234560, 5));
+    DMITIGR_ASSERT(Decimal(-12346, 3) < value && value < Decimal(-12345, 3));
+    DMITIGR_ASSERT(value.rescaled(2) == Decimal(-1235, 2));
+    DMITIGR_ASSERT(value.rescaled(6).unscaled_value() == -12345600);
+    DMITIGR_ASSERT(value.to_long_double() == -12.3456L);
+    DMITIGR_ASSERT(Decimal(Decimal::limit() - 1) != Decimal(1, 38));
+    DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([]
+    {
+      Decimal{Decimal::limit()};
+    }));
+  }
+
+  // Text format
+  {
+    DMITIGR_ASSERT(to<Decimal>(text("12345678901234.5678")) ==
+      Decimal(123456789012345678, 4));
+    DMITIGR_ASSERT(to<Decimal>(text("-0.05")) == Decimal(-5, 2));
+    DMITIGR_ASSERT(to<Decimal>(text("+7")) == Decimal(7));
+    DMITIGR_ASSERT(to<Decimal>(text("-0.05")).scale() == 2);
+    for (const auto* const literal : {"-0.05", "0", "12345678901234.5678",
+        "99999999999999999999999999999999999999",
+        "0.00000000000000000000000000000000000001"})
+      DMITIGR_ASSERT(to<std::string_view>(*to_data(to<Decimal>(text(literal))))
+        == literal);
+    for (const auto* const literal : {"", "-", ".", "1.2.3", "NaN", "1e5",
+        "100000000000000000000000000000000000000"}) {
+      DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([&]
+      {
+        to<Decimal>(text(literal));
+      }));
+    }
+  }
+
+  // Binary format
+  {
+    // 12345678901234.5678 = 12|3456|7890|1234.5678
+    const auto value = to<Decimal>(numeric(3, 0, 4, {12, 3456, 7890, 1234, 5678}));
+    DMITIGR_ASSERT(value == Decimal(123456789012345678, 4) && value.scale() == 4);
+
+    // -1.50 with the trailing zero digit stripped by the server.
+    const auto one_and_half = to<Decimal>(numeric(0, 0x4000, 2, {1, 5000}));
+    DMITIGR_ASSERT(one_and_half.unscaled_value() == -150);
+    DMITIGR_ASSERT(one_and_half.scale() == 2);
+
+    // 20000 and 0.0001
+    DMITIGR_ASSERT(to<Decimal>(numeric(1, 0, 0, {2})) == Decimal(20000));
+    DMITIGR_ASSERT(to<Decimal>(numeric(-1, 0, 4, {1})) == Decimal(1, 4));
+    DMITIGR_ASSERT(to<Decimal>(numeric(0, 0, 3, {})) == Decimal{});
+    DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([&]
+    {
+      to<Decimal>(numeric(0, 0xC000, 0, {}));
+    }));
+
+    const auto data = to_data(value, Data_format::binary);
+    DMITIGR_ASSERT(to<std::string_view>(*data) ==
+      to<std::string_view>(*numeric(3, 0, 4, {12, 3456, 7890, 1234, 5678})));
+    DMITIGR_ASSERT(to<std::string_view>(*to_data(Decimal{-150, 2},
+          Data_format::binary)) ==
+      to<std::string_view>(*numeric(0, 0x4000, 2, {1, 5000})));
+    DMITIGR_ASSERT(to<std::string_view>(*to_data(Decimal{}, Data_format::binary))
+      == to<std::string_view>(*numeric(0, 0, 0, {})));
+    for (const auto& decimal : {Decimal{1, 4}, Decimal{20000},
+        Decimal{Decimal::limit() - 1}, Decimal{-(Decimal::limit() - 1), 38},
+        Decimal{123456789, 5}, Decimal{-7, 7}})
+      DMITIGR_ASSERT(to<Decimal>(*to_data(decimal, Data_format::binary)) ==
+        decimal);
+  }
+
+  // Arrays
+  {
+    using Decimals = pgfe::Array_optional1<Decimal>;
+    const Decimals decimals{Decimal{15, 1}, {}, Decimal{-3, 4}};
+    DMITIGR_ASSERT(to<Decimals>(*to_data(decimals)) == decimals);
+    DMITIGR_ASSERT(to<Decimals>(*to_data(decimals, Data_format::binary)) ==
+      decimals);
+  }
+#endif
+} catch (const std::exception& e) {
+  std::cerr << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "unknown error" << std::endl;
+  return 2;
+}
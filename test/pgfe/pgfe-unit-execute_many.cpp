@@ -0,0 +1,107 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pgfe-unit.hpp"
+
+#include <tuple>
+#include <vector>
+
+namespace {
+
+struct Person final {
+  int id{};
+  std::string name;
+};
+
+template<std::size_t I>
+decltype(auto) get(const Person& p) noexcept
+{
+  if constexpr (I == 0)
+    return (p.id);
+  else
+    return (p.name);
+}
+
+} // namespace
+
+namespace std {
+
+template<>
+struct tuple_size<Person> final : integral_constant<std::size_t, 2> {};
+
+} // namespace std
+
+int main()
+try {
+  namespace pgfe = dmitigr::pgfe;
+  using pgfe::to;
+
+  auto conn = pgfe::test::make_connection();
+  conn->connect();
+  conn->execute("create temp table person(id integer primary key, name text)");
+
+  // Tuples.
+  {
+    std::vector<std::tuple<int, std::string>> persons;
+    for (int i{}; i < 1000; ++i)
+      persons.emplace_back(i, "person " + std::to_string(i));
+    const auto comp = conn->execute_many("insert into person values($1, $2)",
+      persons, 64);
+    DMITIGR_ASSERT(comp.is_ok());
+    DMITIGR_ASSERT(comp.element_count() == 1000);
+    DMITIGR_ASSERT(comp.completion_count() == 1000);
+    DMITIGR_ASSERT(comp.row_count() == 1000);
+    DMITIGR_ASSERT(conn->is_ready_for_request());
+  }
+
+  // Single parameters.
+  {
+    const std::vector<int> ids{0, 1, 2, 3};
+    auto ps = conn->prepare("delete from person where id = $1");
+    const auto comp = ps.execute_many(ids);
+    DMITIGR_ASSERT(comp.is_ok());
+    DMITIGR_ASSERT(comp.row_count() == 4);
+  }
+
+  // Structs and errors.
+  {
+    const std::vector<Person> persons{{1000, "Alice"}, {1001, "Bob"},
+      {999, "Duplicate"}, {1002, "Aborted"}, {1003, "Carol"}};
+    auto ps = conn->prepare("insert into person values($1, $2)");
+    const auto comp = ps.execute_many(persons, 4);
+    DMITIGR_ASSERT(!comp.is_ok());
+    DMITIGR_ASSERT(comp.element_count() == 5);
+    DMITIGR_ASSERT(comp.completion_count() == 3);
+    DMITIGR_ASSERT(comp.errors().size() == 1);
+    DMITIGR_ASSERT(comp.errors()[0].first == 2);
+    DMITIGR_ASSERT(comp.errors()[0].second.condition() ==
+      pgfe::Server_errc::c23_unique_violation);
+    DMITIGR_ASSERT(comp.aborted().size() == 1);
+    DMITIGR_ASSERT(comp.aborted()[0] == 3);
+  }
+
+  DMITIGR_ASSERT(conn->is_ready_for_request());
+  conn->execute([](auto&& row)
+  {
+    DMITIGR_ASSERT(to<long>(row[0]) == 999);
+  }, "select count(*) from person");
+} catch (const std::exception& e) {
+  std::cerr << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "unknown error" << std::endl;
+  return 2;
+}
@@ -0,0 +1,145 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../../src/base/assert.hpp"
+#include "../../src/pgfe/array_aliases.hpp"
+#include "../../src/pgfe/conversions.hpp"
+#include "../../src/pgfe/flat_array.hpp"
+#include "../../src/util/diagnostic.hpp"
+
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+int main()
+try {
+  namespace pgfe = dmitigr::pgfe;
+  using pgfe::Data;
+  using pgfe::Data_format;
+  using pgfe::to;
+  using pgfe::to_data;
+  using dmitigr::util::with_catch;
+  using Ints = pgfe::Flat_array<int>;
+  using Strings = pgfe::Flat_array<std::string>;
+
+  // Construction and access
+  {
+    Ints empty;
+    DMITIGR_ASSERT(empty.is_empty());
+    DMITIGR_ASSERT(!empty.dimension_count());
+
+    Ints matrix{{2, 3}, {1, 2, 3, 4, 5, 6}};
+    DMITIGR_ASSERT(matrix.dimension_count() == 2);
+    DMITIGR_ASSERT(matrix.extent(0) == 2 && matrix.extent(1) == 3);
+    DMITIGR_ASSERT(matrix.lower_bound(0) == 1 && matrix.lower_bound(1) == 1);
+    DMITIGR_ASSERT(matrix.size() == 6);
+    DMITIGR_ASSERT(matrix.index(1, 0) == 3);
+    DMITIGR_ASSERT(matrix(0, 2) == 3);
+    DMITIGR_ASSERT(matrix(1, 2) == 6);
+    matrix(1, 1) = 50;
+    DMITIGR_ASSERT(matrix[4] == 50);
+    DMITIGR_ASSERT(!matrix.has_nulls());
+    matrix.set_null(matrix.index(0, 1));
+    DMITIGR_ASSERT(matrix.has_nulls() && matrix.is_null(1) && !matrix.is_null(0));
+
+    DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([]
+    {
+      Ints{{2, 2}, {1, 2, 3}};
+    }));
+  }
+
+  // Text format
+  {
+    const auto ints = to<Ints>(*Data::make_no_copy("{{1,NULL,3},{4,5,6}}"));
+    DMITIGR_ASSERT(ints.dimension_count() == 2);
+    DMITIGR_ASSERT(ints.extent(0) == 2 && ints.extent(1) == 3);
+    DMITIGR_ASSERT(ints(0, 0) == 1 && ints.is_null(1) && ints(1, 2) == 6);
+    DMITIGR_ASSERT(to<std::string_view>(*to_data(ints)) ==
+      R"({{"1",NULL,"3"},{"4","5","6"}})");
+
+    const auto cube = to<Ints>(*Data::make_no_copy("{{{1,2}},{{3,4}}}"));
+    DMITIGR_ASSERT(cube.dimension_count() == 3);
+    DMITIGR_ASSERT(cube.extent(0) == 2 && cube.extent(1) == 1 &&
+      cube.extent(2) == 2);
+    DMITIGR_ASSERT(cube(1, 0, 1) == 4);
+
+    const auto bounded = to<Ints>(*Data::make_no_copy("[0:1]={7,8}"));
+    DMITIGR_ASSERT(bounded.lower_bound(0) == 0 && bounded[1] == 8);
+    DMITIGR_ASSERT(to<std::string_view>(*to_data(bounded)) ==
+      R"([0:1]={"7","8"})");
+
+    const auto strings = to<Strings>(*Data::make_no_copy(
+        R"({"a b","c\"d",e,"\\",""})"));
+    DMITIGR_ASSERT(strings.size() == 5);
+    DMITIGR_ASSERT(strings[0] == "a b" && strings[1] == "c\"d");
+    DMITIGR_ASSERT(strings[2] == "e" && strings[3] == "\\" && strings[4].empty());
+    DMITIGR_ASSERT(to<Strings>(*to_data(strings)).values() == strings.values());
+
+    DMITIGR_ASSERT(to<Ints>(*Data::make_no_copy("{}")).is_empty());
+    DMITIGR_ASSERT(to<std::string_view>(*to_data(Ints{})) == "{}");
+    DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([]
+    {
+      to<Ints>(*Data::make_no_copy("{{1,2},{3}}"));
+    }));
+    DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([]
+    {
+      to<Ints>(*Data::make_no_copy("{{1,2},3}"));
+    }));
+  }
+
+  // Binary format
+  {
+    Ints matrix{{2, 2}, {1, 2, 3, 4}};
+    matrix.set_null(2);
+    matrix.set_lower_bound(0, 0);
+    const auto data = to_data(matrix, Data_format::binary);
+    DMITIGR_ASSERT(data->format() == Data_format::binary);
+    const auto decoded = to<Ints>(*data);
+    DMITIGR_ASSERT(decoded.dimension_count() == 2);
+    DMITIGR_ASSERT(decoded.extent(0) == 2 && decoded.extent(1) == 2);
+    DMITIGR_ASSERT(decoded.lower_bound(0) == 0 && decoded.lower_bound(1) == 1);
+    DMITIGR_ASSERT(decoded(0, 1) == 2 && decoded.is_null(2) && decoded(1, 1) == 4);
+
+    // Compatible with the nested containers.
+    using Nested = pgfe::Array_optional2<int>;
+    const auto nested = to<Nested>(*data);
+    DMITIGR_ASSERT(nested.size() == 2 && nested[1]->size() == 2);
+    DMITIGR_ASSERT(!(*nested[1])[0] && *(*nested[1])[1] == 4);
+    const auto flat = to<Ints>(*to_data(nested, Data_format::binary));
+    DMITIGR_ASSERT(flat.values() == decoded.values() && flat.is_null(2));
+
+    // Mismatched element type.
+    DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([&data]
+    {
+      to<pgfe::Flat_array<long long>>(*data);
+    }));
+
+    const Strings strings{{"a", "", "b c"}};
+    DMITIGR_ASSERT(to<Strings>(*to_data(strings, Data_format::binary)).values()
+      == strings.values());
+
+    const auto empty = to<Ints>(*to_data(Ints{}, Data_format::binary));
+    DMITIGR_ASSERT(empty.is_empty() && !empty.dimension_count());
+    DMITIGR_ASSERT(pgfe::detail::Is_binary_data_convertible<Ints>::value);
+  }
+} catch (const std::exception& e) {
+  std::cerr << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "unknown error" << std::endl;
+  return 2;
+}
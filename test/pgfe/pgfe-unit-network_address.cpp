@@ -0,0 +1,146 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../../src/base/assert.hpp"
+#include "../../src/pgfe/array_aliases.hpp"
+#include "../../src/pgfe/conversions.hpp"
+#include "../../src/pgfe/network_address.hpp"
+#include "../../src/util/diagnostic.hpp"
+
+#include <iostream>
+#include <string>
+#include <string_view>
+
+int main()
+try {
+  namespace net = dmitigr::net;
+  namespace pgfe = dmitigr::pgfe;
+  using pgfe::Data;
+  using pgfe::Data_format;
+  using pgfe::Inet;
+  using pgfe::Mac_address;
+  using pgfe::to;
+  using pgfe::to_data;
+  using dmitigr::util::with_catch;
+
+  const auto text = [](const std::string_view literal)
+  {
+    return Data::make(literal, Data_format::text);
+  };
+  const auto binary = [](const std::string& bytes)
+  {
+    return Data::make(bytes, Data_format::binary);
+  };
+  const auto ip = [](const std::string& address)
+  {
+    return net::Ip_address::from_text(address);
+  };
+
+  // Inet
+  {
+    const Inet network{ip("10.1.0.0"), 16};
+    DMITIGR_ASSERT(!Inet{}.is_valid() && !network.is_host());
+    DMITIGR_ASSERT(Inet{ip("::1")}.prefix_length() == 128);
+    DMITIGR_ASSERT(Inet{ip("::1")}.is_host());
+    DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([&]
+    {
+      Inet{ip("10.1.0.0"), 33};
+    }));
+
+    DMITIGR_ASSERT(to<Inet>(text("10.1.0.0/16")) == network);
+    DMITIGR_ASSERT(to<std::string_view>(*to_data(network)) == "10.1.0.0/16");
+    DMITIGR_ASSERT(to<Inet>(text("192.168.0.1")) == Inet{ip("192.168.0.1")});
+    DMITIGR_ASSERT(to<std::string_view>(*to_data(Inet{ip("192.168.0.1")})) ==
+      "192.168.0.1");
+    DMITIGR_ASSERT((to<Inet>(text("2001:db8::/32")) == Inet{ip("2001:db8::"), 32}));
+    for (const auto* const literal : {"", "10.1.0.0/", "10.1.0.0/33",
+        "10.1.0.0/1x", "10.1.0.256", "::1/129", "host"}) {
+      DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([&]
+      {
+        to<Inet>(text(literal));
+      }));
+    }
+
+    const auto data = to_data(network, Data_format::binary);
+    DMITIGR_ASSERT(to<std::string_view>(*data) ==
+      std::string_view("\x02\x10\x00\x04\x0a\x01\x00\x00", 8));
+    DMITIGR_ASSERT(to<Inet>(*data) == network);
+    const Inet network6{ip("2001:db8::1"), 64};
+    const auto data6 = to_data(network6, Data_format::binary);
+    DMITIGR_ASSERT(data6->size() == 20);
+    DMITIGR_ASSERT(to<Inet>(*data6) == network6);
+    // The flag of cidr is ignored.
+    DMITIGR_ASSERT(to<Inet>(binary({"\x02\x08\x01\x04\x0a\x00\x00\x00", 8})) ==
+      Inet(ip("10.0.0.0"), 8));
+    for (const auto& bytes : {std::string{"\x02\x08\x00\x04\x0a\x00\x00", 7},
+        std::string{"\x03\x08\x00\x04\x0a\x00\x00\x00", 8},
+        std::string{"\x02\x21\x00\x04\x0a\x00\x00\x00", 8}}) {
+      DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([&]
+      {
+        to<Inet>(binary(bytes));
+      }));
+    }
+  }
+
+  // net::Ip_address
+  {
+    DMITIGR_ASSERT(to<net::Ip_address>(text("127.0.0.1")) == ip("127.0.0.1"));
+    DMITIGR_ASSERT(to<net::Ip_address>(text("::1/128")) == ip("::1"));
+    DMITIGR_ASSERT(to<std::string_view>(*to_data(ip("::1"))) == "::1");
+    DMITIGR_ASSERT(to<net::Ip_address>(*to_data(ip("127.0.0.1"),
+          Data_format::binary)) == ip("127.0.0.1"));
+    DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([&]
+    {
+      to<net::Ip_address>(text("10.0.0.0/8"));
+    }));
+  }
+
+  // Mac_address
+  {
+    const Mac_address mac{{0x08, 0x00, 0x2b, 0x01, 0x02, 0x03}};
+    DMITIGR_ASSERT(to<std::string_view>(*to_data(mac)) == "08:00:2b:01:02:03");
+    for (const auto* const literal : {"08:00:2b:01:02:03", "08-00-2b-01-02-03",
+        "08002b:010203", "08002b-010203", "0800.2b01.0203", "0800-2b01-0203",
+        "08002B010203"})
+      DMITIGR_ASSERT(to<Mac_address>(text(literal)) == mac);
+    for (const auto* const literal : {"", "08:00:2b:01:02", "08:00:2b:01:02:03:",
+        "08::00:2b:01:02:03", "08:00:2b:01:02:0g"}) {
+      DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([&]
+      {
+        to<Mac_address>(text(literal));
+      }));
+    }
+
+    const auto data = to_data(mac, Data_format::binary);
+    DMITIGR_ASSERT(data->size() == 6);
+    DMITIGR_ASSERT(to<Mac_address>(*data) == mac);
+    DMITIGR_ASSERT(Mac_address{} < mac);
+  }
+
+  // Arrays
+  {
+    using Inets = pgfe::Array_optional1<Inet>;
+    const Inets inets{Inet{ip("10.0.0.1")}, {}, Inet{ip("::"), 0}};
+    DMITIGR_ASSERT(to<Inets>(*to_data(inets)) == inets);
+    DMITIGR_ASSERT(to<Inets>(*to_data(inets, Data_format::binary)) == inets);
+  }
+} catch (const std::exception& e) {
+  std::cerr << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "unknown error" << std::endl;
+  return 2;
+}
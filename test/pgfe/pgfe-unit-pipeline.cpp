@@ -184,6 +184,50 @@ try {
     ASSERT(completion.tag() == "SELECT");
   }
 
+  /*
+   * Test case 5. (Whole results back to back.)
+   */
+  {
+    conn->set_result_retrieval(pgfe::Result_retrieval::whole);
+    conn->execute_nio("select generate_series(1, 3) id");
+    conn->execute_nio("select generate_series(4, 5) id");
+    conn->send_sync();
+    ASSERT(conn->request_queue_size() == 3);
+    // Process responses by the row callback.
+    int i{};
+    const auto check_row = [&i](auto&& row)
+    {
+      ASSERT(to<int>(row["id"]) == ++i);
+    };
+    auto completion = conn->process_responses(check_row);
+    ASSERT(completion.tag() == "SELECT");
+    ASSERT(completion.row_count() == 3);
+    ASSERT(i == 3);
+    completion = conn->process_responses(check_row);
+    ASSERT(completion.row_count() == 2);
+    ASSERT(i == 5);
+    conn->wait_response();
+    ASSERT(conn->ready_for_query());
+
+    // Process responses by the result sets.
+    conn->execute_nio("select 1 id");
+    conn->execute_nio("select 2 id");
+    conn->send_sync();
+    for (int id{1}; id <= 2; ++id) {
+      conn->wait_response();
+      const auto rs = conn->result_set();
+      ASSERT(rs);
+      ASSERT(to<int>(rs[0]["id"]) == id);
+      conn->wait_response();
+      completion = conn->completion();
+      ASSERT(completion.row_count() == 1);
+    }
+    conn->wait_response();
+    ASSERT(conn->ready_for_query());
+    ASSERT(conn->request_queue_size() == 0);
+    conn->set_result_retrieval(pgfe::Result_retrieval::streaming);
+  }
+
   conn->set_pipeline_enabled(false);
   ASSERT(conn->is_ready_for_request());
   ASSERT(conn->is_ready_for_nio_request());
@@ -0,0 +1,217 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pgfe-unit.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic_bool is_counting{};
+std::atomic_long allocation_count{};
+
+void* allocate(const std::size_t size)
+{
+  if (is_counting)
+    ++allocation_count;
+  if (auto* const result = std::malloc(size ? size : 1))
+    return result;
+  throw std::bad_alloc{};
+}
+
+void* allocate(std::size_t size, const std::align_val_t alignment)
+{
+  if (is_counting)
+    ++allocation_count;
+  const auto align = static_cast<std::size_t>(alignment);
+  size = (size + align - 1) / align * align; // required by aligned_alloc()
+#ifdef _WIN32
+  if (auto* const result = _aligned_malloc(size ? size : align, align))
+#else
+  if (auto* const result = std::aligned_alloc(align, size ? size : align))
+#endif
+    return result;
+  throw std::bad_alloc{};
+}
+
+void deallocate(void* const ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void deallocate(void* const ptr, std::align_val_t) noexcept
+{
+#ifdef _WIN32
+  _aligned_free(ptr);
+#else
+  std::free(ptr);
+#endif
+}
+
+} // namespace
+
+// Replace all the forms of the allocation functions to count every allocation.
+
+void* operator new(const std::size_t size)
+{
+  return allocate(size);
+}
+
+void* operator new[](const std::size_t size)
+{
+  return allocate(size);
+}
+
+void* operator new(const std::size_t size, const std::nothrow_t&) noexcept
+{
+  try {
+    return allocate(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void* operator new[](const std::size_t size, const std::nothrow_t&) noexcept
+{
+  try {
+    return allocate(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment)
+{
+  return allocate(size, alignment);
+}
+
+void* operator new[](const std::size_t size, const std::align_val_t alignment)
+{
+  return allocate(size, alignment);
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment,
+  const std::nothrow_t&) noexcept
+{
+  try {
+    return allocate(size, alignment);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void* operator new[](const std::size_t size, const std::align_val_t alignment,
+  const std::nothrow_t&) noexcept
+{
+  try {
+    return allocate(size, alignment);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void operator delete(void* const ptr) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete[](void* const ptr) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete(void* const ptr, std::size_t) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete[](void* const ptr, std::size_t) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete(void* const ptr, const std::nothrow_t&) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete[](void* const ptr, const std::nothrow_t&) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete(void* const ptr, const std::align_val_t alignment) noexcept
+{
+  deallocate(ptr, alignment);
+}
+
+void operator delete[](void* const ptr, const std::align_val_t alignment) noexcept
+{
+  deallocate(ptr, alignment);
+}
+
+void operator delete(void* const ptr, std::size_t,
+  const std::align_val_t alignment) noexcept
+{
+  deallocate(ptr, alignment);
+}
+
+void operator delete[](void* const ptr, std::size_t,
+  const std::align_val_t alignment) noexcept
+{
+  deallocate(ptr, alignment);
+}
+
+void operator delete(void* const ptr, const std::align_val_t alignment,
+  const std::nothrow_t&) noexcept
+{
+  deallocate(ptr, alignment);
+}
+
+void operator delete[](void* const ptr, const std::align_val_t alignment,
+  const std::nothrow_t&) noexcept
+{
+  deallocate(ptr, alignment);
+}
+
+int main()
+try {
+  namespace pgfe = dmitigr::pgfe;
+
+  const auto conn = pgfe::test::make_connection();
+  conn->connect();
+  DMITIGR_ASSERT(conn->is_connected());
+
+  auto ps = conn->prepare("select $1::integer", "ps_allocations");
+  ps.bind(0, 1983);
+  ps.execute(); // warm up the buffers
+
+  constexpr int iteration_count{1000};
+  is_counting = true;
+  for (int i{}; i < iteration_count; ++i)
+    ps.execute();
+  is_counting = false;
+  DMITIGR_ASSERT(!allocation_count);
+} catch (const std::exception& e) {
+  std::cerr << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "unknown error" << std::endl;
+  return 2;
+}
@@ -0,0 +1,131 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pgfe-unit.hpp"
+
+#define ASSERT DMITIGR_ASSERT
+
+int main()
+try {
+  namespace pgfe = dmitigr::pgfe;
+  using pgfe::to;
+
+  auto conn = pgfe::test::make_connection();
+  conn->connect();
+  try {
+    conn->last_request_handle();
+    ASSERT(false);
+  } catch (const pgfe::Client_exception&) {}
+
+  conn->set_pipeline_enabled(true);
+
+  // Rows, completions, errors.
+  {
+    conn->execute_nio("select 1");
+    auto h1 = conn->last_request_handle();
+    conn->execute_nio("select generate_series(1, 3)");
+    auto h2 = conn->last_request_handle();
+    conn->execute_nio("select 1/0");
+    auto h3 = conn->last_request_handle();
+    conn->execute_nio("select 2");
+    auto h4 = conn->last_request_handle();
+    conn->send_sync();
+    auto hs = conn->last_request_handle();
+    ASSERT(h1 && h2 && h3 && h4 && hs);
+    ASSERT(!h1.is_ready());
+
+    h2.wait();
+    ASSERT(h1.is_ready());
+    ASSERT(to<int>(h1.row()[0]) == 1);
+    ASSERT(!h1.row());
+    ASSERT(h1.completion().tag() == "SELECT");
+    ASSERT(h2.is_ready());
+    for (int i{1}; i <= 3; ++i)
+      ASSERT(to<int>(h2.row()[0]) == i);
+    ASSERT(!h2.row());
+    ASSERT(h2.completion().row_count() == 3);
+
+    h3.wait();
+    ASSERT(!h3.completion());
+    ASSERT(h3.error().condition() == pgfe::Server_errc::c22_division_by_zero);
+    h4.wait();
+    ASSERT(h4.is_aborted());
+    ASSERT(!h4.row());
+    hs.wait();
+    ASSERT(hs.is_ready() && !hs.is_aborted());
+    ASSERT(!conn->has_uncompleted_request());
+  }
+
+  // Prepared statements.
+  {
+    conn->prepare_nio("select $1::integer", "ps");
+    auto h = conn->last_request_handle();
+    conn->send_sync();
+    h.wait();
+    conn->wait_response();
+    ASSERT(conn->ready_for_query());
+    auto ps = h.prepared_statement();
+    ASSERT(ps && ps.name() == "ps");
+    ps.bind(0, 3).execute_nio();
+    auto he = conn->last_request_handle();
+    conn->send_sync();
+    while (!he.poll())
+      conn->wait_socket_readiness(pgfe::Socket_readiness::read_ready);
+    ASSERT(to<int>(he.row()[0]) == 3);
+    conn->wait_response();
+    ASSERT(conn->ready_for_query());
+  }
+
+  // Keeping of responses to requests without handles.
+  {
+    conn->execute_nio("select 5");
+    conn->execute_nio("select 6");
+    auto h = conn->last_request_handle();
+    conn->send_sync();
+    try {
+      h.wait();
+      ASSERT(false);
+    } catch (const pgfe::Client_exception&) {}
+    int value{};
+    conn->process_responses([&value](auto&& row)
+    {
+      value = to<int>(row[0]);
+    });
+    ASSERT(value == 5);
+    h.wait();
+    ASSERT(to<int>(h.row()[0]) == 6);
+    conn->wait_response();
+    ASSERT(conn->ready_for_query());
+  }
+
+  // Invalidation.
+  {
+    conn->execute_nio("select 7");
+    auto h = conn->last_request_handle();
+    conn->disconnect();
+    ASSERT(!h);
+    try {
+      h.wait();
+      ASSERT(false);
+    } catch (const pgfe::Client_exception&) {}
+  }
+} catch (const std::exception& e) {
+  std::cerr << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "unknown error" << std::endl;
+  return 2;
+}
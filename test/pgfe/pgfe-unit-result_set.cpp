@@ -0,0 +1,124 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pgfe-unit.hpp"
+
+int main()
+try {
+  namespace pgfe = dmitigr::pgfe;
+  using pgfe::Result_retrieval;
+
+  const auto conn = pgfe::test::make_connection();
+  conn->connect();
+  DMITIGR_ASSERT(conn->result_retrieval() == Result_retrieval::streaming);
+
+  // Whole result.
+  {
+    const auto rs = conn->execute_result_set(
+      "select generate_series(1, $1::integer) num, 'x' str", 10);
+    DMITIGR_ASSERT(conn->is_ready_for_request());
+    DMITIGR_ASSERT(rs);
+    DMITIGR_ASSERT(!rs.is_empty());
+    DMITIGR_ASSERT(rs.row_count() == 10);
+    DMITIGR_ASSERT(rs.info().field_count() == 2);
+    DMITIGR_ASSERT(pgfe::to<int>(rs[0]["num"]) == 1);
+    DMITIGR_ASSERT(pgfe::to<int>(rs.data(9, "num")) == 10);
+    DMITIGR_ASSERT(pgfe::to<std::string>(rs.row(3)[1]) == "x");
+
+    int i{};
+    for (const auto& row : rs) {
+      DMITIGR_ASSERT(row.row_number() == static_cast<std::size_t>(i));
+      DMITIGR_ASSERT(pgfe::to<int>(row[0]) == ++i);
+    }
+    DMITIGR_ASSERT(i == 10);
+
+    const auto col = rs.column("num");
+    DMITIGR_ASSERT(col.name() == "num");
+    DMITIGR_ASSERT(col.size() == 10);
+    int sum{};
+    for (const auto& data : col)
+      sum += pgfe::to<int>(data);
+    DMITIGR_ASSERT(sum == 55);
+
+    // The column remains valid after the result set is moved.
+    auto rs2 = conn->execute_result_set("select 'a' str union all select 'b'");
+    const auto str = rs2.column(0);
+    const auto rs3 = std::move(rs2);
+    DMITIGR_ASSERT(str.name() == "str");
+    DMITIGR_ASSERT(str.size() == 2);
+    DMITIGR_ASSERT(pgfe::to<std::string_view>(str[1]) == "b");
+  }
+
+  // Empty whole result.
+  {
+    const auto rs = conn->execute_result_set("select 1 where false");
+    DMITIGR_ASSERT(rs);
+    DMITIGR_ASSERT(rs.is_empty());
+    DMITIGR_ASSERT(conn->is_ready_for_request());
+  }
+
+  // No result.
+  {
+    const auto rs = conn->execute_result_set("create temp table tmp(id integer)");
+    DMITIGR_ASSERT(!rs);
+    DMITIGR_ASSERT(conn->is_ready_for_request());
+  }
+
+  // Row callback with whole result retrieval.
+  {
+    conn->set_result_retrieval(Result_retrieval::whole);
+    DMITIGR_ASSERT(conn->result_retrieval() == Result_retrieval::whole);
+    int i{};
+    const auto comp = conn->execute([&i](auto&& row)
+    {
+      DMITIGR_ASSERT(pgfe::to<int>(row[0]) == ++i);
+    }, "select generate_series(1, 5)");
+    DMITIGR_ASSERT(comp);
+    DMITIGR_ASSERT(comp.row_count() == 5);
+    DMITIGR_ASSERT(i == 5);
+    conn->set_result_retrieval(Result_retrieval::streaming);
+  }
+
+  // Adaptive result retrieval.
+  {
+    conn->set_adaptive_result_threshold(10);
+    DMITIGR_ASSERT(conn->adaptive_result_threshold() == 10);
+    auto ps = conn->prepare("select generate_series(1, $1::integer)", "ps");
+    ps.set_result_retrieval(Result_retrieval::adaptive);
+    DMITIGR_ASSERT(ps.result_retrieval() == Result_retrieval::adaptive);
+
+    const auto is_whole_result = [&conn, &ps](const int row_count)
+    {
+      ps.bind(0, row_count).execute_nio();
+      conn->wait_response_throw();
+      const bool result = static_cast<bool>(conn->result_set());
+      const auto comp = conn->process_responses([](pgfe::Row_batch&&){});
+      DMITIGR_ASSERT(comp.row_count() == row_count);
+      return result;
+    };
+
+    DMITIGR_ASSERT(!is_whole_result(5)); // no statistics yet
+    DMITIGR_ASSERT(is_whole_result(100));
+    DMITIGR_ASSERT(!is_whole_result(5));
+    DMITIGR_ASSERT(is_whole_result(5));
+  }
+} catch (const std::exception& e) {
+  std::cerr << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "unknown error" << std::endl;
+  return 2;
+}
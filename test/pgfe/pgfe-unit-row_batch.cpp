@@ -0,0 +1,141 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pgfe-unit.hpp"
+
+#include <algorithm>
+
+int main()
+try {
+  namespace pgfe = dmitigr::pgfe;
+
+  const auto conn = pgfe::test::make_connection();
+  conn->connect();
+  DMITIGR_ASSERT(conn->row_batch_size() == 1);
+
+  // Invalid batch size.
+  {
+    bool is_thrown{};
+    try {
+      conn->set_row_batch_size(0);
+    } catch (const pgfe::Client_exception&) {
+      is_thrown = true;
+    }
+    DMITIGR_ASSERT(is_thrown);
+    DMITIGR_ASSERT(conn->row_batch_size() == 1);
+  }
+
+  conn->set_row_batch_size(100);
+  DMITIGR_ASSERT(conn->row_batch_size() == 100);
+
+  // Row_batch callback.
+  {
+    long sum{};
+    std::size_t row_count{};
+    std::size_t max_batch_size{};
+    const auto comp = conn->execute([&sum, &row_count, &max_batch_size]
+      (pgfe::Row_batch&& batch)
+    {
+      max_batch_size = std::max(max_batch_size, batch.row_count());
+      DMITIGR_ASSERT(batch);
+      DMITIGR_ASSERT(batch.info().field_count() == 1);
+      DMITIGR_ASSERT(batch.row_count() > 0 && batch.row_count() <= 100);
+      for (std::size_t i{}; i < batch.row_count(); ++i) {
+        DMITIGR_ASSERT(batch.data(i) == batch.data(i, "num"));
+        sum += pgfe::to<int>(batch.data(i));
+      }
+      DMITIGR_ASSERT(pgfe::to<int>(batch.row(0)[0]) == pgfe::to<int>(batch.data(0)));
+      row_count += batch.row_count();
+    }, "select generate_series(1, 1000) num");
+    DMITIGR_ASSERT(comp);
+    DMITIGR_ASSERT(comp.row_count() == 1000);
+    DMITIGR_ASSERT(row_count == 1000);
+    DMITIGR_ASSERT(sum == 500500);
+#ifdef LIBPQ_HAS_CHUNK_MODE
+    DMITIGR_ASSERT(max_batch_size > 1); // the chunk mode is in use
+#else
+    DMITIGR_ASSERT(max_batch_size == 1); // the single-row mode fallback
+#endif
+  }
+
+  // Row callback with batches retrieval.
+  {
+    long sum{};
+    int i{};
+    const auto comp = conn->execute([&sum, &i](auto&& row)
+    {
+      DMITIGR_ASSERT(pgfe::to<int>(row[0]) == ++i); // no row of chunk is lost
+      sum += pgfe::to<int>(row[0]);
+    }, "select generate_series(1, 1000)");
+    DMITIGR_ASSERT(comp.row_count() == 1000);
+    DMITIGR_ASSERT(i == 1000);
+    DMITIGR_ASSERT(sum == 500500);
+  }
+
+  // Suspend in the middle of batch and process the rest rows by batches.
+  {
+    int i{};
+    auto comp = conn->execute([&i](auto&& row)
+    {
+      DMITIGR_ASSERT(pgfe::to<int>(row[0]) == ++i);
+      return i < 150 ? pgfe::Row_processing::continu :
+        pgfe::Row_processing::suspend;
+    }, "select generate_series(1, 1000)");
+    DMITIGR_ASSERT(!comp);
+    DMITIGR_ASSERT(i == 150);
+    comp = conn->process_responses([&i](pgfe::Row_batch&& batch, pgfe::Error&& error)
+    {
+      DMITIGR_ASSERT(!error);
+      for (std::size_t j{}; j < batch.row_count(); ++j)
+        DMITIGR_ASSERT(pgfe::to<int>(batch.data(j)) == ++i);
+    });
+    DMITIGR_ASSERT(comp.row_count() == 1000);
+    DMITIGR_ASSERT(i == 1000);
+  }
+
+  // Rows refer to the data of their batches.
+  {
+    pgfe::Row first;
+    const auto comp = conn->execute([&first](pgfe::Row_batch&& batch)
+    {
+      if (!first)
+        first = batch.row(0);
+    }, "select generate_series(1, 1000)");
+    DMITIGR_ASSERT(comp.row_count() == 1000);
+    DMITIGR_ASSERT(first && pgfe::to<int>(first[0]) == 1);
+  }
+
+  // Prepared statement specific batch size.
+  {
+    auto ps = conn->prepare("select generate_series(1, $1::integer)");
+    DMITIGR_ASSERT(ps.row_batch_size() == 100);
+    ps.set_row_batch_size(7);
+    DMITIGR_ASSERT(ps.row_batch_size() == 7);
+    std::size_t row_count{};
+    ps.execute([&row_count](pgfe::Row_batch&& batch)
+    {
+      DMITIGR_ASSERT(batch.row_count() <= 7);
+      row_count += batch.row_count();
+    }, 50);
+    DMITIGR_ASSERT(row_count == 50);
+  }
+} catch (const std::exception& e) {
+  std::cerr << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "unknown error" << std::endl;
+  return 2;
+}
@@ -0,0 +1,116 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pgfe-unit.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace pgfe = dmitigr::pgfe;
+
+int main()
+try {
+  using std::chrono::milliseconds;
+
+  constexpr std::size_t shard_count = 2;
+  constexpr std::size_t shard_size = 2;
+  pgfe::Sharded_connection_pool pool{shard_count, shard_size,
+    pgfe::test::connection_options()};
+  DMITIGR_ASSERT(pool.is_valid());
+  DMITIGR_ASSERT(pool.shard_count() == shard_count);
+  DMITIGR_ASSERT(pool.size() == shard_count * shard_size);
+  DMITIGR_ASSERT(!pool.is_connected());
+  DMITIGR_ASSERT(pool.local_shard_index() < shard_count);
+  pool.connect();
+  DMITIGR_ASSERT(pool.is_connected());
+  DMITIGR_ASSERT(pool.free_count() == pool.size());
+
+  // The local shard is used first, then the others.
+  {
+    const auto local = pool.local_shard_index();
+    std::vector<pgfe::Sharded_connection_pool::Handle> handles;
+    for (std::size_t i{}; i < shard_size; ++i) {
+      handles.push_back(pool.connection());
+      DMITIGR_ASSERT(handles.back());
+      DMITIGR_ASSERT(handles.back().pool() == &pool.shard(local));
+    }
+    DMITIGR_ASSERT(!pool.steal_count());
+    for (std::size_t i{}; i < shard_size; ++i) {
+      handles.push_back(pool.connection());
+      DMITIGR_ASSERT(handles.back());
+      DMITIGR_ASSERT(handles.back().pool() != &pool.shard(local));
+      handles.back()->execute("select 1");
+    }
+    DMITIGR_ASSERT(pool.steal_count() == shard_size);
+    DMITIGR_ASSERT(!pool.free_count());
+    DMITIGR_ASSERT(!pool.connection());
+
+    try {
+      pool.connection(milliseconds{10});
+      DMITIGR_ASSERT(false);
+    } catch (const pgfe::Client_exception& e) {
+      DMITIGR_ASSERT(e.condition() == pgfe::Client_errc::timed_out);
+    }
+
+    // Waiting for the connection released to the non-local shard.
+    std::atomic<std::size_t> waiter_local{shard_count};
+    std::thread waiter{[&pool, &waiter_local]
+    {
+      waiter_local = pool.local_shard_index();
+      auto conn = pool.connection(milliseconds{5000});
+      DMITIGR_ASSERT(conn && conn.pool() != &pool.shard(waiter_local));
+    }};
+    while (waiter_local == shard_count)
+      std::this_thread::yield();
+    std::this_thread::sleep_for(milliseconds{10});
+    const auto i = std::find_if(handles.begin(), handles.end(),
+      [&pool, &waiter_local](const auto& handle)
+      {
+        return handle.pool() != &pool.shard(waiter_local);
+      });
+    DMITIGR_ASSERT(i != handles.end());
+    handles.erase(i);
+    waiter.join();
+  }
+  DMITIGR_ASSERT(pool.free_count() == pool.size());
+
+  // The threads are distributed among the shards.
+  {
+    std::vector<std::size_t> indexes(shard_count);
+    std::vector<std::thread> threads;
+    for (std::size_t i{}; i < shard_count; ++i)
+      threads.emplace_back([&pool, &index = indexes[i]]
+      {
+        index = pool.local_shard_index();
+        auto conn = pool.connection(std::nullopt);
+        DMITIGR_ASSERT(conn);
+      });
+    for (auto& thread : threads)
+      thread.join();
+    DMITIGR_ASSERT(indexes[0] != indexes[1]);
+  }
+
+  pool.disconnect();
+  DMITIGR_ASSERT(!pool.is_connected());
+} catch (const std::exception& e) {
+  std::cerr << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "unknown error" << std::endl;
+  return 2;
+}
@@ -0,0 +1,177 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../../src/base/assert.hpp"
+#include "../../src/pgfe/array_aliases.hpp"
+#include "../../src/pgfe/conversions.hpp"
+#include "../../src/pgfe/temporal.hpp"
+#include "../../src/util/diagnostic.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+int main()
+try {
+  namespace chrono = std::chrono;
+  namespace pgfe = dmitigr::pgfe;
+  using pgfe::Data;
+  using pgfe::Data_format;
+  using pgfe::Date;
+  using pgfe::Interval;
+  using pgfe::Time_of_day;
+  using pgfe::to;
+  using pgfe::to_data;
+  using dmitigr::util::with_catch;
+  using Sys_time = chrono::time_point<chrono::system_clock, chrono::microseconds>;
+  using Local_time = pgfe::Local_time<chrono::microseconds>;
+
+  const auto text = [](const std::string_view literal)
+  {
+    return Data::make(literal, Data_format::text);
+  };
+  const auto binary_int64 = [](const std::unique_ptr<Data>& data)
+  {
+    DMITIGR_ASSERT(data->format() == Data_format::binary);
+    DMITIGR_ASSERT(data->size() == 8);
+    return dmitigr::net::conv<std::int64_t>(data->bytes(), data->size());
+  };
+
+  // Date
+  {
+    DMITIGR_ASSERT((Date::from_days(0) == Date{1970, 1, 1}));
+    DMITIGR_ASSERT((Date{2000, 1, 1}.to_days() == 10957));
+    DMITIGR_ASSERT((Date::from_days(Date{-4712, 2, 29}.to_days()) ==
+        Date{-4712, 2, 29}));
+    DMITIGR_ASSERT(!(Date{2023, 2, 29}.is_valid()));
+
+    DMITIGR_ASSERT((to<Date>(text("2024-02-29")) == Date{2024, 2, 29}));
+    DMITIGR_ASSERT((to<Date>(text("0044-03-15 BC")) == Date{-43, 3, 15}));
+    DMITIGR_ASSERT(to<std::string_view>(*to_data(Date{-43, 3, 15})) ==
+      "0044-03-15 BC");
+    // The leap years BC are the astronomical years divisible by 4.
+    DMITIGR_ASSERT((to<Date>(text("0001-02-29 BC")) == Date{0, 2, 29}));
+    DMITIGR_ASSERT((to<Date>(text("0005-02-29 BC")) == Date{-4, 2, 29}));
+    for (const auto* const literal : {"2023-02-29", "2024-1-1x", "infinity",
+        "0004-02-29 BC", "0000-01-01"}) {
+      DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([&]
+      {
+        to<Date>(text(literal));
+      }));
+    }
+
+    const auto data = to_data(Date{2000, 1, 2}, Data_format::binary);
+    DMITIGR_ASSERT(data->size() == 4);
+    DMITIGR_ASSERT(dmitigr::net::conv<std::int32_t>(data->bytes(), 4) == 1);
+    DMITIGR_ASSERT((to<Date>(*data) == Date{2000, 1, 2}));
+  }
+
+  // Time_of_day
+  {
+    const Time_of_day time{chrono::hours{13} + chrono::minutes{5} +
+      chrono::seconds{7} + chrono::microseconds{25}};
+    DMITIGR_ASSERT(time.hours().count() == 13 && time.minutes().count() == 5);
+    DMITIGR_ASSERT(time.seconds().count() == 7 && time.subseconds().count() == 25);
+    DMITIGR_ASSERT(to<Time_of_day>(text("13:05:07.000025")) == time);
+    DMITIGR_ASSERT(to<std::string_view>(*to_data(time)) == "13:05:07.000025");
+    DMITIGR_ASSERT(to<Time_of_day>(text("24:00:00")).hours().count() == 24);
+    DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([&]
+    {
+      to<Time_of_day>(text("24:00:01"));
+    }));
+    DMITIGR_ASSERT(to<Time_of_day>(*to_data(time, Data_format::binary)) == time);
+  }
+
+  // Timestamps
+  {
+    const Sys_time epoch{chrono::seconds{946684800}};
+    DMITIGR_ASSERT(binary_int64(to_data(epoch, Data_format::binary)) == 0);
+    DMITIGR_ASSERT(to<Sys_time>(text("2000-01-01 03:00:00.5+03")) ==
+      epoch + chrono::milliseconds{500});
+    DMITIGR_ASSERT(to<Sys_time>(text("2000-01-01 00:00:00-05:30")) ==
+      epoch + chrono::minutes{330});
+    DMITIGR_ASSERT(to<Sys_time>(text("1999-12-31T23:59:59.999999")) ==
+      epoch - chrono::microseconds{1});
+    DMITIGR_ASSERT(to<std::string_view>(*to_data(epoch - chrono::microseconds{1}))
+      == "1999-12-31 23:59:59.999999+00");
+    DMITIGR_ASSERT(to<Sys_time>(text("infinity")) == Sys_time::max());
+    DMITIGR_ASSERT(binary_int64(to_data(Sys_time::min(), Data_format::binary)) ==
+      std::numeric_limits<std::int64_t>::min());
+
+    // The system clock's time point of the default precision.
+    const auto now = chrono::system_clock::now();
+    const auto restored = to<chrono::system_clock::time_point>(
+      *to_data(now, Data_format::binary));
+    DMITIGR_ASSERT(restored == chrono::floor<chrono::microseconds>(now));
+
+    const Local_time local{chrono::hours{24*10957 + 12}};
+    DMITIGR_ASSERT(binary_int64(to_data(local, Data_format::binary)) ==
+      std::int64_t{12}*3600*1000000);
+    DMITIGR_ASSERT(to<Local_time>(text("2000-01-01 12:00:00")) == local);
+    DMITIGR_ASSERT(to<std::string_view>(*to_data(local)) ==
+      "2000-01-01 12:00:00");
+    DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([&]
+    {
+      to<Local_time>(text("2000-01-01 12:00:00+03"));
+    }));
+    const auto bc = to<Local_time>(text("0001-12-31 23:00:00 BC"));
+    DMITIGR_ASSERT(to<std::string_view>(*to_data(bc)) == "0001-12-31 23:00:00 BC");
+    DMITIGR_ASSERT(to<Local_time>(*to_data(bc, Data_format::binary)) == bc);
+    DMITIGR_ASSERT(to<std::string_view>(*to_data(to<Local_time>(
+      text("0005-02-29 00:00:00 BC")))) == "0005-02-29 00:00:00 BC");
+    DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([&]
+    {
+      to<Local_time>(text("0004-02-29 00:00:00 BC"));
+    }));
+  }
+
+  // Interval
+  {
+    const Interval interval{14, -3, -(chrono::hours{4} + chrono::seconds{6} +
+      chrono::milliseconds{789})};
+    DMITIGR_ASSERT(to<Interval>(text("1 year 2 mons -3 days -04:00:06.789")) ==
+      interval);
+    DMITIGR_ASSERT(to<std::string_view>(*to_data(interval)) ==
+      "14 mons -3 days -04:00:06.789000");
+    DMITIGR_ASSERT(to<Interval>(*to_data(interval)) == interval);
+    DMITIGR_ASSERT((to<Interval>(text("1 day")) == Interval{0, 1, {}}));
+    DMITIGR_ASSERT((to<Interval>(text("00:00:00")) == Interval{}));
+    DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([&]
+    {
+      to<Interval>(text("1 fortnight"));
+    }));
+
+    const auto data = to_data(interval, Data_format::binary);
+    DMITIGR_ASSERT(data->size() == 16);
+    DMITIGR_ASSERT(to<Interval>(*data) == interval);
+  }
+
+  // Arrays
+  {
+    using Dates = pgfe::Array_optional1<Date>;
+    const Dates dates{Date{2000, 1, 1}, {}, Date{2024, 12, 31}};
+    DMITIGR_ASSERT(to<Dates>(*to_data(dates)) == dates);
+    DMITIGR_ASSERT(to<Dates>(*to_data(dates, Data_format::binary)) == dates);
+  }
+} catch (const std::exception& e) {
+  std::cerr << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "unknown error" << std::endl;
+  return 2;
+}
@@ -0,0 +1,100 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../../src/base/assert.hpp"
+#include "../../src/pgfe/array_aliases.hpp"
+#include "../../src/pgfe/conversions.hpp"
+#include "../../src/pgfe/uuid.hpp"
+#include "../../src/util/diagnostic.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <string_view>
+#include <unordered_set>
+
+int main()
+try {
+  namespace pgfe = dmitigr::pgfe;
+  using pgfe::Data;
+  using pgfe::Data_format;
+  using pgfe::Uuid;
+  using pgfe::to;
+  using pgfe::to_data;
+  using dmitigr::util::with_catch;
+
+  const auto text = [](const std::string_view literal)
+  {
+    return Data::make(literal, Data_format::text);
+  };
+
+  const Uuid uuid{{0xa0, 0xee, 0xbc, 0x99, 0x9c, 0x0b, 0x4e, 0xf8,
+    0xbb, 0x6d, 0x6b, 0xb9, 0xbd, 0x38, 0x0a, 0x11}};
+
+  // Construction and comparison
+  {
+    DMITIGR_ASSERT(Uuid{}.is_nil() && !uuid.is_nil());
+    DMITIGR_ASSERT(Uuid{} < uuid && Uuid{} != uuid);
+    const std::unordered_set<Uuid> uuids{Uuid{}, uuid, uuid};
+    DMITIGR_ASSERT(uuids.size() == 2);
+  }
+
+  // Text format
+  {
+    DMITIGR_ASSERT(to<std::string_view>(*to_data(uuid)) ==
+      "a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11");
+    for (const auto* const literal : {"a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11",
+        "A0EEBC99-9C0B-4EF8-BB6D-6BB9BD380A11",
+        "{a0eebc99-9c0b4ef8-bb6d6bb9-bd380a11}",
+        "a0eebc999c0b4ef8bb6d6bb9bd380a11",
+        "a0ee-bc99-9c0b-4ef8-bb6d-6bb9-bd38-0a11"})
+      DMITIGR_ASSERT(to<Uuid>(text(literal)) == uuid);
+    for (const auto* const literal : {"", "a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a1",
+        "a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a111", "a0eebc99--9c0b4ef8bb6d6bb9bd380a11",
+        "a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11-", "g0eebc999c0b4ef8bb6d6bb9bd380a11",
+        "{a0eebc999c0b4ef8bb6d6bb9bd380a11"}) {
+      DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([&]
+      {
+        to<Uuid>(text(literal));
+      }));
+    }
+  }
+
+  // Binary format
+  {
+    const auto data = to_data(uuid, Data_format::binary);
+    DMITIGR_ASSERT(data->format() == Data_format::binary && data->size() == 16);
+    DMITIGR_ASSERT(!std::memcmp(data->bytes(), uuid.bytes().data(), 16));
+    DMITIGR_ASSERT(to<Uuid>(*data) == uuid);
+    DMITIGR_ASSERT(with_catch<pgfe::Client_exception>([]
+    {
+      to<Uuid>(Data::make(std::string_view{"0123456789"}, Data_format::binary));
+    }));
+  }
+
+  // Arrays
+  {
+    using Uuids = pgfe::Array_optional1<Uuid>;
+    const Uuids uuids{uuid, {}, Uuid{}};
+    DMITIGR_ASSERT(to<Uuids>(*to_data(uuids)) == uuids);
+    DMITIGR_ASSERT(to<Uuids>(*to_data(uuids, Data_format::binary)) == uuids);
+  }
+} catch (const std::exception& e) {
+  std::cerr << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "unknown error" << std::endl;
+  return 2;
+}
@@ -0,0 +1,83 @@
+// -*- C++ -*-
+//
+// Copyright 2022 Dmitry Igrishin
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../../src/base/assert.hpp"
+#include "../../src/util/ring_queue.hpp"
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+int main()
+try {
+  using dmitigr::util::Ring_queue;
+
+  // Push and pop without growth.
+  {
+    Ring_queue<int> q{4};
+    DMITIGR_ASSERT(q.empty());
+    DMITIGR_ASSERT(q.capacity() == 4);
+    for (int i{}; i < 100; ++i) {
+      DMITIGR_ASSERT(q.emplace(i) == i);
+      DMITIGR_ASSERT(q.emplace(i + 1) == i + 1);
+      DMITIGR_ASSERT(q.size() == 2);
+      DMITIGR_ASSERT(q.front() == i);
+      DMITIGR_ASSERT(q.back() == i + 1);
+      q.pop();
+      q.pop();
+      DMITIGR_ASSERT(q.empty());
+    }
+    DMITIGR_ASSERT(q.capacity() == 4);
+  }
+
+  // Growth with wrapped elements.
+  {
+    Ring_queue<std::string> q{3};
+    q.emplace("0");
+    q.emplace("1");
+    q.pop();
+    for (int i{2}; i < 10; ++i)
+      q.emplace(std::to_string(i));
+    DMITIGR_ASSERT(q.size() == 9);
+    DMITIGR_ASSERT(q.capacity() == 12);
+    for (int i{1}; i < 10; ++i) {
+      DMITIGR_ASSERT(q.front() == std::to_string(i));
+      q.pop();
+    }
+    DMITIGR_ASSERT(q.empty());
+  }
+
+  // Pop back and release of resources.
+  {
+    auto resource = std::make_shared<int>(1);
+    Ring_queue<std::shared_ptr<int>> q{2};
+    q.emplace(resource);
+    q.emplace(resource);
+    DMITIGR_ASSERT(resource.use_count() == 3);
+    q.pop_back();
+    DMITIGR_ASSERT(q.size() == 1);
+    DMITIGR_ASSERT(resource.use_count() == 2);
+    q.clear();
+    DMITIGR_ASSERT(q.empty());
+    DMITIGR_ASSERT(resource.use_count() == 1);
+  }
+} catch (const std::exception& e) {
+  std::cerr << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "unknown error" << std::endl;
+  return 2;
+}